@@ -18,6 +18,7 @@ option(BUILD_SHARED_LIBS                "Build shared or static libraries." ON)
 option(BOOMERANG_BUILD_GUI              "Build the GUI. Requires Qt5Widgets." ON)
 option(BOOMERANG_BUILD_CLI              "Build the command line interface." ON)
 option(BOOMERANG_BUILD_UNIT_TESTS       "Build the unit tests. Requires Qt5Test." OFF)
+option(BOOMERANG_BUILD_BENCHMARKS       "Build the benchmarks. Requires Google Benchmark." OFF)
 
 if (BOOMERANG_BUILD_CLI)
     option(BOOMERANG_BUILD_REGRESSION_TESTS "Build the regression tests. Requires Python 3." OFF)
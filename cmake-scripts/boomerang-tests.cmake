@@ -19,6 +19,16 @@ if (BOOMERANG_BUILD_UNIT_TESTS)
 endif (BOOMERANG_BUILD_UNIT_TESTS)
 
 
+if (BOOMERANG_BUILD_BENCHMARKS)
+    find_package(benchmark REQUIRED)
+    if (benchmark_FOUND)
+        mark_as_advanced(benchmark_DIR)
+    endif (benchmark_FOUND)
+
+    add_subdirectory(${CMAKE_SOURCE_DIR}/tests/benchmarks)
+endif (BOOMERANG_BUILD_BENCHMARKS)
+
+
 if (BOOMERANG_BUILD_REGRESSION_TESTS)
     find_package(PythonInterp 3 REQUIRED)
 
@@ -9,16 +9,37 @@
 #pragma endregion License
 #include "CommandlineDriver.h"
 
+#include "boomerang/c/SignatureDB.h"
 #include "boomerang/core/Settings.h"
 #include "boomerang/db/Prog.h"
+#include "boomerang/db/binary/BinaryFile.h"
+#include "boomerang/db/binary/FunctionPatternDB.h"
+#include "boomerang/db/module/Module.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/ssl/type/Type.h"
 #include "boomerang/util/CFGDotWriter.h"
+#include "boomerang/util/log/FileLogSink.h"
 #include "boomerang/util/log/Log.h"
+#include "boomerang/util/log/Trace.h"
 
 #include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonDocument>
 #include <QTextStream>
 
 #include <iostream>
 
+#ifndef _WIN32
+#    include <cerrno>
+#    include <csignal>
+#    include <poll.h>
+#    include <sys/resource.h>
+#    include <sys/wait.h>
+#    include <unistd.h>
+#endif
+
 
 Q_DECLARE_METATYPE(Address)
 
@@ -46,16 +67,34 @@ static void help()
                  "Symbols\n"
                  "  -s <addr> <name> : Define a symbol\n"
                  "  -sf <filename>   : Read a symbol/signature file\n"
+                 "  --lib-patterns <file>   : Identify statically linked library functions\n"
+                 "                     by the function patterns in <file>\n"
+                 "  --create-patterns <file> : Write the patterns of all functions with symbols\n"
+                 "                     and known sizes in the program to <file> and exit\n"
                  "Decoding/decompilation options\n"
                  "  -e <addr>        : Decode the procedure beginning at addr, and callees\n"
                  "  -E <addr>        : Decode the procedure at addr, no callees\n"
                  "                     Use -e and -E repeatedly for multiple entry points\n"
                  "  -ic              : Decode through type 0 Indirect Calls\n"
+                 "  --decode-address-order : Decode the basic blocks of each procedure\n"
+                 "                     in address order\n"
+                 "  --sweep          : Find functions not reachable from the entry points\n"
+                 "                     by a linear sweep over the code sections,\n"
+                 "                     using the number of threads given by -j\n"
+                 "  --sweep-confidence <num> : Minimum confidence score of functions\n"
+                 "                     found by --sweep (default 60)\n"
                  "  -S <min>         : Stop decompilation after specified number of minutes\n"
                  "  -t               : Trace (print address of) every instruction decoded\n"
                  "  -Tc              : Use old constraint-based type analysis\n"
                  "  -Td              : Use data-flow-based type analysis\n"
                  "  -a               : Assume ABI compliance\n"
+                 "  -j <num>         : Use <num> threads for code generation and --sweep\n"
+                 "                     (0 = one per CPU core, default 1)\n"
+                 "  --proc-time <sec>    : Per-procedure time budget, excluding callees\n"
+                 "  --proc-stmts <num>   : Per-procedure statement budget\n"
+                 "  --proc-passes <num>  : Per-procedure propagation pass budget\n"
+                 "                     Procedures exceeding a budget are decompiled with\n"
+                 "                     reduced precision (default: unlimited)\n"
                  "Output\n"
                  "  --version        : Print version information and exit\n"
                  "  -h, --help       : Show this help\n"
@@ -65,6 +104,7 @@ static void help()
                  "  -gd <dot file>   : Generate a dotty graph of the program's CFG\n"
                  "  -gc              : Generate a call graph to callgraph.dot\n"
                  "  -gs              : Generate a symbol file (symbols.h)\n"
+                 "  --data-sections  : Write the contents of all data sections as byte arrays\n"
                  "  -iw              : Write indirect call report to output/indirect.txt\n"
                  "Misc.\n"
                  "  -i [<file>]      : Interactive mode; execute commands from <file>, if present\n"
@@ -72,6 +112,20 @@ static void help()
                  "  -P <path>        : Path to Boomerang files, defaults to where you run\n"
                  "                     Boomerang from\n"
                  "  -X               : activate eXperimental code; errors likely\n"
+                 "  --compile-signatures : Precompile the library signature catalogs\n"
+                 "                     in the data directory and exit\n"
+                 "Batch mode\n"
+                 "  --batch <file>   : Decompile all binaries listed in <file> (one per line,\n"
+                 "                     '-' for stdin) into subdirectories <n>-<name> of the\n"
+                 "                     output path, where <n> is the index of the job.\n"
+                 "                     Results are written to stdout as JSON lines\n"
+                 "  --job-timeout <sec> : Kill batch jobs that run longer than <sec> seconds\n"
+                 "  --job-memory <MiB>  : Limit the address space (virtual memory, not the\n"
+                 "                     resident size) of batch jobs to <MiB>. Jobs that\n"
+                 "                     exceed it fail to allocate memory\n"
+                 "  --stats <file>   : Write timing and memory statistics as JSON to <file>\n"
+                 "  --trace <file>   : Write a trace of the decompilation to <file>\n"
+                 "                     (Chrome trace event format, e.g. for Perfetto)\n"
                  "  --               : No effect (used for testing)\n"
                  "Debug\n"
                  "  -dc              : Debug switch (Case) analysis\n"
@@ -221,6 +275,92 @@ int CommandlineDriver::applyCommandline(const QStringList &args)
                 help();
                 return 1;
             }
+            else if (arg == "--compile-signatures") {
+                return compileSignatures() ? 1 : -1;
+            }
+            else if (arg == "--batch" || arg == "--job-timeout" || arg == "--job-memory") {
+                if (++i == args.size()) {
+                    usage();
+                    return 1;
+                }
+
+                if (arg == "--batch") {
+                    m_batchMode     = true;
+                    m_batchManifest = args[i];
+                }
+                else if (arg == "--job-timeout") {
+                    m_jobTimeout = args[i].toInt();
+                }
+                else {
+                    m_jobMemoryLimit = args[i].toInt();
+                }
+            }
+            else if (arg == "--lib-patterns" || arg == "--create-patterns") {
+                if (++i == args.size()) {
+                    usage();
+                    return 1;
+                }
+
+                if (arg == "--lib-patterns") {
+                    m_project->getSettings()->m_patternFiles.push_back(args[i]);
+                }
+                else {
+                    m_patternFile = args[i];
+                }
+            }
+            else if (arg == "--decode-address-order") {
+                m_project->getSettings()->decodeAddrOrder = true;
+            }
+            else if (arg == "--data-sections") {
+                m_project->getSettings()->generateDataSections = true;
+            }
+            else if (arg == "--sweep") {
+                m_project->getSettings()->linearSweep = true;
+            }
+            else if (arg == "--sweep-confidence") {
+                if (++i == args.size()) {
+                    usage();
+                    return 1;
+                }
+
+                m_project->getSettings()->linearSweep        = true;
+                m_project->getSettings()->sweepMinConfidence = args[i].toInt();
+            }
+            else if (arg == "--stats") {
+                if (++i == args.size()) {
+                    usage();
+                    return 1;
+                }
+
+                m_statsFile = args[i];
+            }
+            else if (arg == "--trace") {
+                if (++i == args.size()) {
+                    usage();
+                    return 1;
+                }
+
+                m_traceFile = args[i];
+                Trace::enable();
+            }
+            else if (arg == "--proc-time" || arg == "--proc-stmts" || arg == "--proc-passes") {
+                if (++i == args.size()) {
+                    usage();
+                    return 1;
+                }
+
+                Settings *settings = m_project->getSettings();
+
+                if (arg == "--proc-time") {
+                    settings->procTimeBudget = args[i].toDouble();
+                }
+                else if (arg == "--proc-stmts") {
+                    settings->procStmtBudget = args[i].toInt();
+                }
+                else {
+                    settings->procPassBudget = args[i].toInt();
+                }
+            }
             break;
 
         case 'i':
@@ -343,6 +483,15 @@ int CommandlineDriver::applyCommandline(const QStringList &args)
 
         case 'S': minsToStopAfter = args[++i].toInt(); break;
 
+        case 'j':
+            if (++i == args.size()) {
+                usage();
+                return 1;
+            }
+
+            m_project->getSettings()->numThreads = args[i].toInt();
+            break;
+
         default: help();
         }
     }
@@ -357,7 +506,10 @@ int CommandlineDriver::applyCommandline(const QStringList &args)
         m_kill_timer.start(1000 * 60 * minsToStopAfter);
     }
 
-    m_pathToBinary = args.last();
+    if (!m_batchMode) {
+        m_pathToBinary = args.last();
+    }
+
     return 0;
 }
 
@@ -397,6 +549,10 @@ int CommandlineDriver::interactiveMain()
 
 int CommandlineDriver::decompile()
 {
+    if (m_batchMode) {
+        return runBatch();
+    }
+
     Log::getOrCreateLog().addDefaultLogSinks(
         m_project->getSettings()->getOutputDirectory().absolutePath());
     m_project->loadPlugins();
@@ -404,7 +560,29 @@ int CommandlineDriver::decompile()
     QDir wd       = m_project->getSettings()->getWorkingDirectory();
     QFileInfo inf = QFileInfo(wd.absoluteFilePath(m_pathToBinary));
 
-    return decompile(inf.absoluteFilePath(), inf.baseName());
+    const int result = decompile(inf.absoluteFilePath(), inf.baseName());
+
+    if (!m_statsFile.isEmpty()) {
+        QJsonObject stats = getStatistics();
+        stats["file"]     = inf.absoluteFilePath();
+        stats["exitCode"] = result;
+
+        QFile statsFile(m_statsFile);
+        if (!statsFile.open(QFile::WriteOnly) ||
+            statsFile.write(QJsonDocument(stats).toJson()) < 0) {
+            LOG_ERROR("Cannot write statistics to '%1'", m_statsFile);
+        }
+    }
+
+    if (!m_traceFile.isEmpty()) {
+        Trace::disable();
+
+        if (!Trace::writeChromeTrace(m_traceFile)) {
+            LOG_ERROR("Cannot write trace to '%1'", m_traceFile);
+        }
+    }
+
+    return result;
 }
 
 
@@ -419,7 +597,12 @@ bool CommandlineDriver::loadAndDecode(const QString &fname, const QString &pname
 {
     assert(m_project);
 
+    QElapsedTimer timer;
+    timer.start();
+
     const bool ok = m_project->loadBinaryFile(fname);
+    m_stageTimes["load"] = timer.restart() / 1000.0;
+
     if (!ok) {
         LOG_ERROR("Loading '%1' failed.", fname);
         return false;
@@ -429,7 +612,10 @@ bool CommandlineDriver::loadAndDecode(const QString &fname, const QString &pname
     assert(prog);
 
     prog->setName(pname);
-    return m_project->decodeBinaryFile();
+
+    const bool decoded     = m_project->decodeBinaryFile();
+    m_stageTimes["decode"] = timer.elapsed() / 1000.0;
+    return decoded;
 }
 
 
@@ -438,6 +624,12 @@ int CommandlineDriver::decompile(const QString &fname, const QString &pname)
     time_t start;
     time(&start);
 
+    m_stageTimes = QJsonObject();
+
+    if (!m_patternFile.isEmpty()) {
+        return createPatterns(fname);
+    }
+
     if (!loadAndDecode(fname, pname)) {
         return 1;
     }
@@ -447,14 +639,19 @@ int CommandlineDriver::decompile(const QString &fname, const QString &pname)
         return 0;
     }
 
+    QElapsedTimer timer;
+    timer.start();
+
     LOG_MSG("Decompiling...");
     m_project->decompileBinaryFile();
+    m_stageTimes["decompile"] = timer.restart() / 1000.0;
 
     if (!m_project->getSettings()->dotFile.isEmpty()) {
         CFGDotWriter().writeCFG(m_project->getProg(), m_project->getSettings()->dotFile);
     }
 
     m_project->generateCode();
+    m_stageTimes["codegen"] = timer.elapsed() / 1000.0;
 
     QDir outDir = m_project->getSettings()->getOutputDirectory();
     LOG_MSG("Output written to '%1'", outDir.absolutePath());
@@ -468,3 +665,290 @@ int CommandlineDriver::decompile(const QString &fname, const QString &pname)
     LOG_MSG("Completed in %1 hours %2 minutes %3 seconds.", hours, mins, secs);
     return 0;
 }
+
+
+QJsonObject CommandlineDriver::getStatistics() const
+{
+    QJsonObject stats;
+    stats["stages"] = m_stageTimes;
+
+    if (m_project->getProg()) {
+        const Prog *prog = m_project->getProg();
+
+        int numDegraded = 0;
+        for (const auto &module : prog->getModuleList()) {
+            for (const Function *func : *module) {
+                if (!func->isLib() && static_cast<const UserProc *>(func)->isDegraded()) {
+                    numDegraded++;
+                }
+            }
+        }
+
+        stats["numProcs"]         = prog->getNumFunctions(true);
+        stats["numLibProcs"]      = prog->getNumFunctions(false) - prog->getNumFunctions(true);
+        stats["numDegradedProcs"] = numDegraded;
+    }
+
+#ifndef _WIN32
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        stats["peakMemory"] = static_cast<qint64>(usage.ru_maxrss);
+        stats["cpuTime"]    = (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+                              (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+    }
+#endif
+
+    return stats;
+}
+
+
+bool CommandlineDriver::compileSignatures()
+{
+    const QDir dataDir = m_project->getSettings()->getDataDirectory();
+    bool ok            = true;
+
+    for (Machine machine : { Machine::PENTIUM, Machine::SPARC, Machine::HPRISC, Machine::PPC,
+                             Machine::ST20, Machine::MIPS }) {
+        for (const QString &catalogName :
+             { QString("signatures/common.hs"), QString("signatures/win32.hs"),
+               QString("signatures/objc.hs"), Prog::getLibraryCatalogName(machine) }) {
+            const QString catalogFile = dataDir.absoluteFilePath(catalogName);
+            if (!QFile::exists(catalogFile)) {
+                continue;
+            }
+
+            const QString dbFile = SignatureDB::getDBFileName(catalogFile, machine);
+            LOG_MSG("Compiling signature database '%1'", dbFile);
+
+            if (!SignatureDB::compile(catalogFile, machine, dbFile)) {
+                ok = false;
+            }
+        }
+    }
+
+    Type::clearNamedTypes();
+    return ok;
+}
+
+
+int CommandlineDriver::createPatterns(const QString &fname)
+{
+    if (!m_project->loadBinaryFile(fname)) {
+        LOG_ERROR("Loading '%1' failed.", fname);
+        return 1;
+    }
+
+    const BinaryFile *binaryFile = m_project->getLoadedBinaryFile();
+    const int numPatterns        = FunctionPatternDB::writePatternFile(
+        binaryFile->getImage(), binaryFile->getSymbols(), m_patternFile);
+
+    if (numPatterns < 0) {
+        return 1;
+    }
+
+    LOG_MSG("Wrote %1 function patterns to '%2'", numPatterns, m_patternFile);
+    return 0;
+}
+
+
+int CommandlineDriver::runBatch()
+{
+    m_project->loadPlugins();
+
+    QFile manifest;
+    bool opened = false;
+
+    if (m_batchManifest == "-") {
+        opened = manifest.open(stdin, QFile::ReadOnly | QFile::Text);
+    }
+    else {
+        manifest.setFileName(m_batchManifest);
+        opened = manifest.open(QFile::ReadOnly | QFile::Text);
+    }
+
+    if (!opened) {
+        std::cerr << "Cannot open batch manifest '" << m_batchManifest.toStdString() << "'"
+                  << std::endl;
+        return 1;
+    }
+
+    const QDir outputDir = m_project->getSettings()->getOutputDirectory();
+    const QDir wd        = m_project->getSettings()->getWorkingDirectory();
+
+    QTextStream in(&manifest);
+    bool allSucceeded = true;
+    int jobIndex      = 0;
+
+    // read jobs one by one, so jobs can be fed to stdin while the batch is running
+    while (!in.atEnd()) {
+        const QString line = in.readLine().trimmed();
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+
+        // Prefix the output directory with the job index so binaries with the same
+        // base name (e.g. the same program compiled for different targets) do not collide
+        const QFileInfo inf(wd.absoluteFilePath(line));
+        const QString jobDir     = QString("%1-%2").arg(jobIndex++).arg(inf.baseName());
+        const QJsonObject result = runBatchJob(inf.absoluteFilePath(),
+                                               outputDir.absoluteFilePath(jobDir));
+
+        allSucceeded &= (result["status"].toString() == "ok");
+        std::cout << QJsonDocument(result).toJson(QJsonDocument::Compact).toStdString()
+                  << std::endl;
+    }
+
+    return allSucceeded ? 0 : 1;
+}
+
+
+QJsonObject CommandlineDriver::runBatchJob(const QString &fileName, const QString &outputDir)
+{
+    QJsonObject result;
+    result["file"]   = fileName;
+    result["output"] = outputDir;
+
+    m_project->getSettings()->setOutputDirectory(outputDir + "/");
+    QDir().mkpath(outputDir);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Runs the job in the current process. Returns the statistics of the job.
+    auto runJob = [this, &fileName]() {
+        Log::getOrCreateLog().addLogSink(std::make_unique<FileLogSink>(
+            m_project->getSettings()->getOutputDirectory().absoluteFilePath("boomerang.log")));
+
+        const int exitCode = decompile(fileName, QFileInfo(fileName).baseName());
+
+        QJsonObject stats = getStatistics();
+        stats["exitCode"] = exitCode;
+
+        Log::getOrCreateLog().removeAllSinks();
+        return stats;
+    };
+
+#ifdef _WIN32
+    // No process isolation; run the job in-process without limits.
+    QJsonObject stats = runJob();
+    m_project->unloadBinaryFile();
+
+    for (auto it = stats.begin(); it != stats.end(); ++it) {
+        result[it.key()] = it.value();
+    }
+
+    result["status"] = stats["exitCode"].toInt() == 0 ? "ok" : "failed";
+#else
+    int fds[2];
+    if (pipe(fds) != 0) {
+        result["status"] = "failed";
+        return result;
+    }
+
+    const pid_t pid = fork();
+
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        result["status"] = "failed";
+        return result;
+    }
+    else if (pid == 0) {
+        // child process: run the job, report the statistics to the parent and exit
+        close(fds[0]);
+
+        // This limits the address space, which also counts mapped but unused memory
+        if (m_jobMemoryLimit > 0) {
+            const rlim_t limit = static_cast<rlim_t>(m_jobMemoryLimit) * 1024 * 1024;
+            const rlimit rl    = { limit, limit };
+            setrlimit(RLIMIT_AS, &rl);
+        }
+
+        QJsonObject stats;
+        try {
+            stats = runJob();
+
+            // make sure all output is written before exiting
+            m_project.reset();
+        }
+        catch (const std::bad_alloc &) {
+            stats["status"] = "outOfMemory";
+        }
+
+        const QByteArray data = QJsonDocument(stats).toJson(QJsonDocument::Compact);
+        const bool written = write(fds[1], data.constData(), data.size()) == data.size();
+        close(fds[1]);
+
+        _exit(written && !stats.contains("status") ? 0 : 1);
+    }
+
+    // parent process: collect the statistics and wait for the child to finish
+    close(fds[1]);
+
+    QByteArray data;
+    bool timedOut = false;
+
+    while (true) {
+        int timeout = -1;
+        if (m_jobTimeout > 0) {
+            const qint64 remaining = m_jobTimeout * 1000LL - timer.elapsed();
+            if (remaining <= 0) {
+                timedOut = true;
+                break;
+            }
+
+            timeout = static_cast<int>(remaining);
+        }
+
+        pollfd pfd = { fds[0], POLLIN, 0 };
+        const int ready = poll(&pfd, 1, timeout);
+
+        if (ready < 0 && errno == EINTR) {
+            continue;
+        }
+        else if (ready == 0) {
+            timedOut = true;
+            break;
+        }
+
+        char buf[4096];
+        const ssize_t numRead = ready > 0 ? read(fds[0], buf, sizeof(buf)) : -1;
+        if (numRead <= 0) {
+            break; // EOF or error
+        }
+
+        data.append(buf, static_cast<int>(numRead));
+    }
+
+    close(fds[0]);
+
+    if (timedOut) {
+        kill(pid, SIGKILL);
+    }
+
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+    }
+
+    const QJsonObject stats = QJsonDocument::fromJson(data).object();
+    for (auto it = stats.begin(); it != stats.end(); ++it) {
+        result[it.key()] = it.value();
+    }
+
+    if (timedOut) {
+        result["status"] = "timeout";
+    }
+    else if (WIFSIGNALED(status)) {
+        result["status"] = "crashed";
+        result["signal"] = WTERMSIG(status);
+    }
+    else if (!result.contains("status")) {
+        result["status"] = (WEXITSTATUS(status) == 0 && stats["exitCode"].toInt() == 0)
+                               ? "ok"
+                               : "failed";
+    }
+#endif
+
+    result["seconds"] = timer.elapsed() / 1000.0;
+    return result;
+}
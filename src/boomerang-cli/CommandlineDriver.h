@@ -15,6 +15,7 @@
 
 #include "boomerang/core/Project.h"
 
+#include <QJsonObject>
 #include <QObject>
 #include <QTimer>
 
@@ -27,6 +28,13 @@ public:
     explicit CommandlineDriver(QObject *parent = nullptr);
 
 public:
+    /**
+     * Apply the command line arguments \p args to the settings of the project.
+     * \retval 0  The arguments were applied and the binary file can be decompiled.
+     * \retval -1 An error occurred that must be reported by a non-zero exit code.
+     * \returns a positive value if there is nothing (more) to do,
+     * e.g. after showing the help text.
+     */
     int applyCommandline(const QStringList &args);
     int decompile();
 
@@ -57,6 +65,46 @@ private:
      */
     int decompile(const QString &fname, const QString &pname);
 
+    /**
+     * Compiles the library signature catalogs in the data directory
+     * to signature databases for all supported machines.
+     * \returns true if all databases were written successfully.
+     */
+    bool compileSignatures();
+
+    /**
+     * Loads the binary \p fname and writes the function patterns
+     * of all functions with symbols to the pattern file given by "--create-patterns".
+     * \returns 0 on success, nonzero on failure.
+     */
+    int createPatterns(const QString &fname);
+
+    /**
+     * Decompiles all binaries listed in the batch manifest (one path per line),
+     * or read from stdin if the manifest is "-".
+     * Plugins are only loaded once. Each binary is decompiled by a separate job
+     * into its own output directory (named after the index of the job and the base name
+     * of the binary), and the result of each job is written to stdout as a line of JSON.
+     *
+     * \returns 0 if all jobs succeeded, 1 otherwise.
+     */
+    int runBatch();
+
+    /**
+     * Decompiles the binary \p fileName as a single batch job.
+     * On POSIX systems, the job runs in a child process that is killed when it exceeds
+     * the per-job time or memory limit.
+     * \returns the result of the job.
+     */
+    QJsonObject runBatchJob(const QString &fileName, const QString &outputDir);
+
+    /**
+     * \returns the statistics of the last decompilation: Wall time of each stage in seconds,
+     * number of procedures, and CPU time in seconds and peak memory usage in KiB
+     * of the process (POSIX only).
+     */
+    QJsonObject getStatistics() const;
+
 public slots:
     void onCompilationTimeout();
 
@@ -68,4 +116,14 @@ private:
     QTimer m_kill_timer;
     int minsToStopAfter = 0;
     QString m_pathToBinary;
+
+    bool m_batchMode = false;
+    QString m_batchManifest;
+    int m_jobTimeout     = 0; ///< time limit of batch jobs in seconds (0 = unlimited)
+    int m_jobMemoryLimit = 0; ///< address space limit of batch jobs in MiB (0 = unlimited)
+
+    QString m_statsFile;       ///< file to write the decompilation statistics to
+    QString m_traceFile;       ///< file to write the trace of the decompilation to
+    QString m_patternFile;     ///< file to write the function patterns of the program to
+    QJsonObject m_stageTimes; ///< wall time of each decompilation stage in seconds
 };
@@ -20,8 +20,11 @@ int main(int argc, char *argv[])
     QCoreApplication app(argc, argv);
     CommandlineDriver driver;
 
-    const bool decompile = driver.applyCommandline(app.arguments()) == 0;
-    if (!decompile) {
+    const int result = driver.applyCommandline(app.arguments());
+    if (result < 0) {
+        return 1;
+    }
+    else if (result > 0) {
         return 0;
     }
 
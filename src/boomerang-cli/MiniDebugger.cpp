@@ -18,9 +18,15 @@
 #include <QTextStream>
 
 
+bool MiniDebugger::stopsAtDebugPoint(UserProc *proc) const
+{
+    return proc->getProg()->getProject()->getSettings()->stopAtDebugPoints;
+}
+
+
 void MiniDebugger::onDecompileDebugPoint(UserProc *proc, const char *description)
 {
-    if (proc->getProg()->getProject()->getSettings()->stopAtDebugPoints) {
+    if (stopsAtDebugPoint(proc)) {
         miniDebugger(proc, description);
     }
 }
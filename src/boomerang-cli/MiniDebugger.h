@@ -21,6 +21,9 @@ class Statement;
 class MiniDebugger : public IWatcher
 {
 private:
+    /// \copydoc IWatcher::stopsAtDebugPoint
+    bool stopsAtDebugPoint(UserProc *proc) const override;
+
     /// \copydoc IWatcher::onDecompileDebugPoint
     void onDecompileDebugPoint(UserProc *proc, const char *description) override;
 
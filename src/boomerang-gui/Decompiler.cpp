@@ -172,6 +172,23 @@ void Decompiler::generateCode()
 }
 
 
+void Decompiler::onProgress(const DecompileProgress &progress)
+{
+    int numProcsDone  = 0;
+    int numProcsTotal = 0;
+
+    for (const auto &[status, numProcs] : progress.numProcsByStatus) {
+        numProcsTotal += numProcs;
+
+        if (status >= PROC_FINAL) {
+            numProcsDone += numProcs;
+        }
+    }
+
+    emit decompileProgress(numProcsDone, numProcsTotal);
+}
+
+
 void Decompiler::onFunctionDiscovered(Function *proc)
 {
     emit procDiscovered("", proc->getName());
@@ -39,6 +39,8 @@ public:
 
     /// IWatcher interface
 public:
+    virtual bool stopsAtDebugPoint(UserProc *) const override { return m_debugging; }
+    virtual void onProgress(const DecompileProgress &progress) override;
     virtual void onDecompileDebugPoint(UserProc *proc, const char *description) override;
     virtual void onFunctionDiscovered(Function *function) override;
     virtual void onDecompileInProgress(UserProc *function) override;
@@ -59,6 +61,7 @@ signals: // Decompiler -> ui
 
     void procDiscovered(const QString &callerName, const QString &procName);
     void procDecompileStarted(const QString &procName);
+    void decompileProgress(int numProcsDone, int numProcsTotal);
 
     void userProcCreated(const QString &name, Address entryAddr);
     void libProcCreated(const QString &name, const QString &params);
@@ -57,6 +57,8 @@ MainWindow::MainWindow(QWidget *_parent)
     connect(m_decompiler, &Decompiler::procDiscovered, this, &MainWindow::showConsideringProc);
     connect(m_decompiler, &Decompiler::procDecompileStarted, this,
             &MainWindow::showDecompilingProc);
+    connect(m_decompiler, &Decompiler::decompileProgress, this,
+            &MainWindow::showDecompileProgress);
     connect(m_decompiler, &Decompiler::userProcCreated, this, &MainWindow::showNewUserProc);
     connect(m_decompiler, &Decompiler::libProcCreated, this, &MainWindow::showNewLibProc);
     connect(m_decompiler, &Decompiler::userProcRemoved, this, &MainWindow::showRemoveUserProc);
@@ -319,8 +321,7 @@ void MainWindow::showInitPage()
     ui->twProcTree->clear();
     ui->twModuleTree->clear();
 
-    m_numDecompiledProcs = 0;
-    m_numCodeGenProcs    = 0;
+    m_numCodeGenProcs = 0;
 
     ui->actLoad->setEnabled(false);
     ui->actDecode->setEnabled(false);
@@ -514,12 +515,14 @@ void MainWindow::showDecompilingProc(const QString &name)
     if (!foundit.isEmpty()) {
         ui->twProcTree->setCurrentItem(foundit.first(), 0);
         foundit.first()->setTextColor(0, QColor("blue"));
-        m_numDecompiledProcs++;
     }
+}
+
 
-    const int max = ui->tblUserProcs->rowCount();
-    ui->prgDecompile->setRange(0, max);
-    ui->prgDecompile->setValue(m_numDecompiledProcs);
+void MainWindow::showDecompileProgress(int numProcsDone, int numProcsTotal)
+{
+    ui->prgDecompile->setRange(0, numProcsTotal);
+    ui->prgDecompile->setValue(numProcsDone);
 }
 
 
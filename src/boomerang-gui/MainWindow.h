@@ -61,6 +61,7 @@ public slots:
     void on_cbOutputPath_currentIndexChanged(const QString &text);
     void showConsideringProc(const QString &parent, const QString &name);
     void showDecompilingProc(const QString &name);
+    void showDecompileProgress(int numProcsDone, int numProcsTotal);
     void showNewUserProc(const QString &name, Address addr);
     void showNewLibProc(const QString &name, const QString &params);
     void showRemoveUserProc(const QString &name, Address addr);
@@ -127,9 +128,8 @@ private:
     QThread m_decompilerThread;
     Decompiler *m_decompiler = nullptr;
 
-    bool m_loadingSettings   = false;
-    int m_numDecompiledProcs = 0;
-    int m_numCodeGenProcs    = 0;
+    bool m_loadingSettings = false;
+    int m_numCodeGenProcs  = 0;
 
     std::map<QWidget *, QString> m_openFiles;
     std::set<QWidget *> m_signatureFiles;
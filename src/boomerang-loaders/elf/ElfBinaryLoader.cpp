@@ -21,6 +21,9 @@
 #include <QBuffer>
 #include <QFile>
 
+#include <algorithm>
+#include <thread>
+
 
 struct SectionParam
 {
@@ -52,6 +55,49 @@ struct Translated_ElfSym
 typedef std::map<QString, int, std::less<QString>> StrIntMap;
 
 
+/**
+ * \returns the number of chunks to split \p numEntries symbol or relocation entries into,
+ * so that each of at most \p numThreads threads (0 = one per CPU core) gets at least
+ * \p minEntriesPerThread entries.
+ */
+static int getNumChunks(DWord numEntries, int numThreads, int minEntriesPerThread)
+{
+    const DWord maxChunks = numThreads > 0 ? static_cast<DWord>(numThreads)
+                                           : std::max(1U, std::thread::hardware_concurrency());
+    const DWord minEntries = static_cast<DWord>(std::max(1, minEntriesPerThread));
+
+    return static_cast<int>(std::max<DWord>(1, std::min(maxChunks, numEntries / minEntries)));
+}
+
+
+/**
+ * Split the entries [begin, end) into \p numChunks consecutive chunks and call
+ * \p func(chunk, chunkBegin, chunkEnd) for each chunk, in parallel if there is more than one.
+ * \p func must only modify data owned by its chunk.
+ */
+template<typename Func>
+static void forEachChunk(DWord begin, DWord end, int numChunks, Func func)
+{
+    if (numChunks <= 1) {
+        func(0, begin, end);
+        return;
+    }
+
+    const DWord chunkSize = (end - begin + numChunks - 1) / numChunks;
+    std::vector<std::thread> workers;
+
+    for (int chunk = 0; chunk < numChunks; chunk++) {
+        const DWord chunkBegin = std::min(end, begin + chunk * chunkSize);
+        const DWord chunkEnd   = std::min(end, chunkBegin + chunkSize);
+        workers.emplace_back(func, chunk, chunkBegin, chunkEnd);
+    }
+
+    for (std::thread &t : workers) {
+        t.join();
+    }
+}
+
+
 ElfBinaryLoader::ElfBinaryLoader()
     : m_nextExtern(Address::ZERO)
 {
@@ -79,6 +125,13 @@ void ElfBinaryLoader::initialize(BinaryImage *image, BinarySymbolTable *symbols)
 }
 
 
+void ElfBinaryLoader::setThreading(int numThreads, int minEntriesPerThread)
+{
+    m_numThreads          = numThreads;
+    m_minEntriesPerThread = minEntriesPerThread;
+}
+
+
 void ElfBinaryLoader::init()
 {
     m_loadedImage   = nullptr;
@@ -481,11 +534,10 @@ Address ElfBinaryLoader::findRelPltOffset(int i)
 
 
 void ElfBinaryLoader::processSymbol(Translated_ElfSym &sym, int e_type, int i,
-                                    const QString &currentFile)
+                                    const BinarySection *siPlt, const QString &currentFile)
 {
-    bool imported              = sym.SectionIdx == SHT_NULL;
-    bool local                 = sym.Binding == STB_LOCAL || sym.Binding == STB_WEAK;
-    const BinarySection *siPlt = m_binaryImage->getSectionByName(".plt");
+    bool imported = sym.SectionIdx == SHT_NULL;
+    bool local    = sym.Binding == STB_LOCAL || sym.Binding == STB_WEAK;
 
     if (sym.Value.isZero() && siPlt) { // && i < max_i_for_hack) {
         // Special hack for gcc circa 3.3.3: (e.g. test/pentium/settest).  The value in the dynamic
@@ -526,7 +578,7 @@ void ElfBinaryLoader::processSymbol(Translated_ElfSym &sym, int e_type, int i,
 
     // TODO: add more symbol information here (function/export etc. ) ?
     BinarySymbol *new_symbol(m_symbols->createSymbol(sym.Value, sym.Name, local));
-    new_symbol->setSize(elfRead4(&m_symbolSection[i].st_size));
+    new_symbol->setSize(sym.SymbolSize);
 
     if (imported) {
         new_symbol->setAttribute("Imported", true);
@@ -575,39 +627,58 @@ void ElfBinaryLoader::addSymbolsForSection(int secIndex)
         return; // cannot read symbol name from invalid string section
     }
 
-    const int numSymbols = section.Size / section.entry_size;
-    QString fileName;
+    const DWord numSymbols = section.Size / section.entry_size;
+    const int numChunks    = getNumChunks(numSymbols, m_numThreads, m_minEntriesPerThread);
 
-    // Index 0 is a dummy entry
-    for (int i = 1; i < numSymbols; i++) {
-        Translated_ElfSym translatedSym;
-        Address val = Address(elfRead4(&m_symbolSection[i].st_value));
-        int nameIdx = elfRead4(&m_symbolSection[i].st_name);
+    // Decode the symbol entries in parallel. Only named symbols are kept;
+    // index 0 is a dummy entry.
+    std::vector<std::vector<std::pair<int, Translated_ElfSym>>> decoded(numChunks);
 
-        if (nameIdx == 0) { /* Silly symbols with no names */
-            continue;
-        }
+    forEachChunk(1, numSymbols, numChunks, [&](int chunk, DWord begin, DWord end) {
+        std::vector<std::pair<int, Translated_ElfSym>> &chunkSymbols = decoded[chunk];
+        chunkSymbols.reserve(end - begin);
 
-        const QString symbolName = getStrPtr(strSectionIdx, nameIdx);
-        // Hack off the "@@GLIBC_2.0" of Linux, if present
-        translatedSym.Name       = symbolName.left(symbolName.indexOf("@@"));
-        translatedSym.Type       = ELF32_ST_TYPE(m_symbolSection[i].st_info);
-        translatedSym.Binding    = ELF32_ST_BIND(m_symbolSection[i].st_info);
-        translatedSym.Visibility = ELF32_ST_VISIBILITY(m_symbolSection[i].st_other);
-        translatedSym.SymbolSize = ELF32_ST_VISIBILITY(m_symbolSection[i].st_size);
-        translatedSym.SectionIdx = elfRead2(&m_symbolSection[i].st_shndx);
-        translatedSym.Value      = val;
-
-        if (translatedSym.Type == STT_FILE) {
-            fileName = translatedSym.Name;
-        }
+        for (DWord i = begin; i < end; i++) {
+            const Elf32_Sym &elfSym = m_symbolSection[i];
+            const int nameIdx       = elfRead4(&elfSym.st_name);
 
-        if (translatedSym.Binding != STB_LOCAL && !fileName.isEmpty()) {
-            // first non-local symbol, clear the current_file
-            fileName.clear();
+            if (nameIdx == 0) { /* Silly symbols with no names */
+                continue;
+            }
+
+            Translated_ElfSym translatedSym;
+            const QString symbolName = getStrPtr(strSectionIdx, nameIdx);
+            // Hack off the "@@GLIBC_2.0" of Linux, if present
+            translatedSym.Name       = symbolName.left(symbolName.indexOf("@@"));
+            translatedSym.Type       = ELF32_ST_TYPE(elfSym.st_info);
+            translatedSym.Binding    = ELF32_ST_BIND(elfSym.st_info);
+            translatedSym.Visibility = ELF32_ST_VISIBILITY(elfSym.st_other);
+            translatedSym.SymbolSize = elfRead4(&elfSym.st_size);
+            translatedSym.SectionIdx = elfRead2(&elfSym.st_shndx);
+            translatedSym.Value      = Address(elfRead4(&elfSym.st_value));
+
+            chunkSymbols.emplace_back(static_cast<int>(i), std::move(translatedSym));
         }
+    });
+
+    // Add the symbols in the order of the symbol table, since earlier symbols take precedence
+    // and the source file of a local symbol is given by the preceding STT_FILE symbol.
+    const BinarySection *siPlt = m_binaryImage->getSectionByName(".plt");
+    QString fileName;
+
+    for (std::vector<std::pair<int, Translated_ElfSym>> &chunkSymbols : decoded) {
+        for (auto &[i, translatedSym] : chunkSymbols) {
+            if (translatedSym.Type == STT_FILE) {
+                fileName = translatedSym.Name;
+            }
+
+            if (translatedSym.Binding != STB_LOCAL && !fileName.isEmpty()) {
+                // first non-local symbol, clear the current_file
+                fileName.clear();
+            }
 
-        processSymbol(translatedSym, symbolType, i, fileName);
+            processSymbol(translatedSym, symbolType, i, siPlt, fileName);
+        }
     }
 
     const Address addressOfMain = getMainEntryPoint();
@@ -858,6 +929,16 @@ void ElfBinaryLoader::applyRelocations()
     const Elf32_Half machine = elfRead2(&m_elfHeader->e_machine);
     const Elf32_Half e_type  = elfRead2(&m_elfHeader->e_type);
 
+    std::vector<Address> relocations; // destinations of all relocations
+
+    /// A relocation entry without addend, decoded to host byte order
+    struct DecodedRel
+    {
+        Elf32_Addr r_offset     = 0;
+        Elf32_Word r_info       = 0;
+        DWord *relocDestination = nullptr; ///< nullptr if r_offset is invalid
+    };
+
     for (size_t i = 1; i < m_elfSections.size(); ++i) {
         const SectionParam &ps(m_elfSections[i]);
         if (ps.sectionType == SHT_RELA) {
@@ -876,6 +957,28 @@ void ElfBinaryLoader::applyRelocations()
                 continue;
             }
 
+            // Even if the relocations cannot be applied below,
+            // the words at their destinations are not plain data.
+            Address destNatOrigin = Address::ZERO;
+            if (e_type == ET_REL) {
+                const Elf32_Word destSection = m_shInfo[i];
+                destNatOrigin = Util::inRange(destSection, 0UL, m_elfSections.size())
+                                    ? m_elfSections[destSection].SourceAddr
+                                    : Address::INVALID;
+            }
+
+            if (destNatOrigin != Address::INVALID) {
+                relocations.reserve(relocations.size() + numEntries);
+
+                for (DWord u = 0; u < numEntries; u++) {
+                    const Address P = destNatOrigin + elfRead4(&relaEntries[u].r_offset);
+
+                    if (m_binaryImage->getSectionByAddr(P)) {
+                        relocations.push_back(P);
+                    }
+                }
+            }
+
             switch (machine) {
             case EM_SPARC:
                 // NOTE: the r_offset is different for .o files (E_REL in the e_type header field)
@@ -949,39 +1052,65 @@ void ElfBinaryLoader::applyRelocations()
                 continue;
             }
 
-            for (unsigned u = 0; u < numEntries; u++) {
-                const Elf32_Addr r_offset  = elfRead4(&relEntries[u].r_offset);
-                const Elf32_Byte relType   = ELF32_R_TYPE(elfRead4(&relEntries[u].r_info));
-                const Elf32_Word symbolIdx = ELF32_R_SYM(elfRead4(&relEntries[u].r_info));
+            // Decode the entries and find the words to relocate in parallel.
+            // The relocations themselves are applied in order below, since they may create
+            // symbols and modify the image.
+            static_assert(sizeof(Elf32_Rel) == 2 * sizeof(DWord),
+                          "Relocation entries must be read as pairs of 32 bit words");
 
-                DWord *relocDestination; // Pointer to the word to be relocated
+            const int numChunks = getNumChunks(numEntries, m_numThreads,
+                                               m_minEntriesPerThread);
+            std::vector<DecodedRel> decoded(numEntries);
 
-                if (e_type == ET_REL) {
-                    if (!Util::inRange(r_offset, 0UL, m_loadedImageSize)) {
-                        LOG_WARN("Not loading symbol number %1 due to invalid offset %2", u,
-                                 r_offset);
-                        continue;
+            forEachChunk(0, numEntries, numChunks, [&](int, DWord begin, DWord end) {
+                // r_offset and r_info of all entries of the chunk, in host byte order
+                std::vector<DWord> fields(2 * (end - begin));
+                Util::readDWords(relEntries + begin, fields.data(), fields.size(), m_endian);
+
+                for (DWord u = begin; u < end; u++) {
+                    DecodedRel &rel = decoded[u];
+                    rel.r_offset    = fields[2 * (u - begin)];
+                    rel.r_info      = fields[2 * (u - begin) + 1];
+
+                    if (e_type == ET_REL) {
+                        if (Util::inRange(rel.r_offset, 0UL, m_loadedImageSize)) {
+                            rel.relocDestination = reinterpret_cast<DWord *>(
+                                (destHostOrigin + rel.r_offset).value());
+                        }
                     }
-                    relocDestination = reinterpret_cast<DWord *>(
-                        (destHostOrigin + r_offset).value());
-                }
-                else {
-                    const BinarySection *destSec = m_binaryImage->getSectionByAddr(
-                        Address(r_offset));
-                    if (!destSec) {
-                        LOG_WARN("Not loading symbol number %1 due to invalid offset %2", u,
-                                 r_offset);
-                        continue;
+                    else {
+                        const BinarySection *destSec = m_binaryImage->getSectionByAddr(
+                            Address(rel.r_offset));
+                        if (destSec) {
+                            rel.relocDestination = reinterpret_cast<DWord *>(
+                                (destSec->getHostAddr() - destSec->getSourceAddr() + rel.r_offset)
+                                    .value());
+                        }
                     }
-                    relocDestination = reinterpret_cast<DWord *>(
-                        (destSec->getHostAddr() - destSec->getSourceAddr() + r_offset).value());
-                    destNatOrigin = Address::ZERO;
+                }
+            });
+
+            relocations.reserve(relocations.size() + numEntries);
+
+            for (DWord u = 0; u < numEntries; u++) {
+                const Elf32_Addr r_offset  = decoded[u].r_offset;
+                const Elf32_Byte relType   = ELF32_R_TYPE(decoded[u].r_info);
+                const Elf32_Word symbolIdx = ELF32_R_SYM(decoded[u].r_info);
+
+                // Pointer to the word to be relocated
+                DWord *relocDestination = decoded[u].relocDestination;
+
+                if (!relocDestination) {
+                    LOG_WARN("Not loading symbol number %1 due to invalid offset %2", u, r_offset);
+                    continue;
                 }
 
                 Address A = Address(elfRead4(relocDestination));
                 Address P = destNatOrigin + r_offset;
                 Address S = Address(elfRead4(&assocSymbols[symbolIdx].st_value));
 
+                relocations.push_back(P);
+
                 if (e_type == ET_REL) {
                     const Elf32_Half sectionIdx = elfRead2(&assocSymbols[symbolIdx].st_shndx);
 
@@ -1052,78 +1181,15 @@ void ElfBinaryLoader::applyRelocations()
                     default:
                         LOG_WARN("Unhandled x86 relocation type %1", static_cast<int>(relType));
                     }
-                default: LOG_WARN("Unhandled relocation!"); break;
-                }
-            }
-        }
-    }
-}
-
+                    break;
 
-bool ElfBinaryLoader::isRelocationAt(Address addr)
-{
-    if (m_loadedImage == nullptr) {
-        return false; // No file loaded
-    }
-
-    const Elf32_Half machine = elfRead2(&m_elfHeader->e_machine);
-    const Elf32_Half e_type  = elfRead2(&m_elfHeader->e_type); ///< relocation type
-
-    switch (machine) {
-    case EM_386:
-
-        for (size_t i = 1; i < m_elfSections.size(); ++i) {
-            const SectionParam &ps(m_elfSections[i]);
-
-            if (ps.sectionType == SHT_REL) {
-                // A section such as .rel.dyn or .rel.plt (without an addend field).
-                // Each entry has 2 words: r_offet and r_info. The r_offset is just the offset from
-                // the beginning of the section (section given by the section header's sh_info) to
-                // the word to be modified. r_info has the type in the bottom byte, and a symbol
-                // table index in the top 3 bytes. A symbol table offset of 0 (STN_UNDEF) means use
-                // value 0. The symbol table involved comes from the section header's sh_link field.
-                const Elf32_Rel *relocEntry = reinterpret_cast<Elf32_Rel *>(ps.imagePtr.value());
-                const DWord size            = ps.Size / sizeof(Elf32_Rel);
-
-                // NOTE: the r_offset is different for .o files (E_REL in the e_type header field)
-                // than for exe's and shared objects!
-                Address destNatOrigin = Address::ZERO;
-
-                if (e_type == ET_REL) {
-                    int destSection = m_shInfo[i];
-                    destNatOrigin   = m_elfSections[destSection].SourceAddr;
-                }
-
-                for (DWord u = 0; u < size; u++) {
-                    Elf32_Addr r_offset = elfRead4(&relocEntry[u].r_offset);
-
-                    Address relocDestination; // Pointer to the word to be relocated
-
-                    if (e_type == ET_REL) {
-                        relocDestination = destNatOrigin + r_offset;
-                    }
-                    else {
-                        const BinarySection *destSec = m_binaryImage->getSectionByAddr(
-                            Address(r_offset));
-                        if (destSec) {
-                            relocDestination = destSec->getSourceAddr() + r_offset;
-                            destNatOrigin    = Address::ZERO;
-                        }
-                    }
-
-                    if (addr == relocDestination) {
-                        return true;
-                    }
+                default: LOG_WARN("Unhandled relocation!"); break;
                 }
             }
         }
-
-        break;
-
-    default: LOG_WARN("Unhandled relocation!"); break; // Not implemented yet
     }
 
-    return false;
+    m_binaryImage->addRelocations(std::move(relocations));
 }
 
 
@@ -39,6 +39,9 @@ public:
     /// \copydoc IFileLoader::initialize
     void initialize(BinaryImage *image, BinarySymbolTable *symbols) override;
 
+    /// \copydoc IFileLoader::setThreading
+    void setThreading(int numThreads, int minEntriesPerThread) override;
+
     /// \copydoc IFileLoader::canLoad
     int canLoad(QIODevice &fl) const override;
 
@@ -65,9 +68,6 @@ public:
     /// \copydoc IFileLoader::getEntryPoint
     virtual Address getEntryPoint() override;
 
-    /// \copydoc IFileLoader::isRelocationAt
-    bool isRelocationAt(Address addr) override;
-
 private:
     /// Reset internal state, except for those that keep track of which member
     /// we're up to
@@ -124,7 +124,10 @@ private:
      */
     void markImports();
 
-    void processSymbol(Translated_ElfSym &sym, int e_type, int i, const QString &currentFile = "");
+    /// Add the symbol \p sym with index \p i in the symbol table to the symbol table
+    /// of the binary. \p siPlt is the .plt section, if any.
+    void processSymbol(Translated_ElfSym &sym, int e_type, int i, const BinarySection *siPlt,
+                       const QString &currentFile = "");
 
 private:
     size_t m_loadedImageSize = 0;       ///< Size of image in bytes
@@ -155,4 +158,7 @@ private:
     std::vector<struct SectionParam> m_elfSections;
     BinaryImage *m_binaryImage   = nullptr;
     BinarySymbolTable *m_symbols = nullptr;
+
+    int m_numThreads          = 1;      ///< Maximum number of threads for decoding tables
+    int m_minEntriesPerThread = 0x4000; ///< Minimum number of table entries per thread
 };
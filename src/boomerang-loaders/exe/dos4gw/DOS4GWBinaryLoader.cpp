@@ -308,6 +308,7 @@ bool DOS4GWBinaryLoader::loadFromMemory(QByteArray &data)
     buf.seek(READ4_LE(m_LXHeader.fixuprecordtbloffset) + lxoff);
     LXFixup fixup;
     unsigned srcpage = 0;
+    std::vector<Address> relocations;
 
     do {
         buf.read(reinterpret_cast<char *>(&fixup), sizeof(fixup));
@@ -343,6 +344,7 @@ bool DOS4GWBinaryLoader::loadFromMemory(QByteArray &data)
         unsigned long target = READ4_LE(m_LXObjects[object - 1].RelocBaseAddr) + READ2_LE(trgoff);
         //        printf("relocate dword at %x to point to %x\n", src, target);
         Util::writeDWord(&m_imageBase[src], target, Endian::Little);
+        relocations.push_back(Address(READ4_LE(m_LXObjects[0].RelocBaseAddr) + src));
 
         while (buf.pos() - (READ4_LE(m_LXHeader.fixuprecordtbloffset) + lxoff) >=
                READ4_LE(fixuppagetbl[srcpage + 1])) {
@@ -350,6 +352,7 @@ bool DOS4GWBinaryLoader::loadFromMemory(QByteArray &data)
         }
     } while (srcpage < npages);
 
+    m_image->addRelocations(std::move(relocations));
     return true;
 }
 
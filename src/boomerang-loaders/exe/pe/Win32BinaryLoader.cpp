@@ -37,6 +37,7 @@ namespace dbghelp
 #include "boomerang/db/binary/BinarySection.h"
 #include "boomerang/db/binary/BinarySymbol.h"
 #include "boomerang/db/binary/BinarySymbolTable.h"
+#include "boomerang/db/binary/BytePatternScanner.h"
 #include "boomerang/util/log/Log.h"
 
 #include <QFile>
@@ -69,6 +70,10 @@ struct SectionParam
 #define IMAGE_SCN_MEM_READ                  0x40000000
 #define IMAGE_SCN_MEM_WRITE                 0x80000000
 #endif
+
+#ifndef IMAGE_REL_BASED_HIGHLOW
+#define IMAGE_REL_BASED_HIGHLOW             3
+#endif
 // clang-format on
 
 
@@ -495,6 +500,7 @@ void Win32BinaryLoader::processIAT()
             unsigned *iat     = reinterpret_cast<unsigned *>(m_image + READ4_LE(thunk));
             unsigned iatEntry = READ4_LE_P(iat);
             Address paddr = Address(READ4_LE(id->firstThunk) + READ4_LE(m_peHeader->Imagebase)); //
+            const Address iatStart = paddr;
 
             while (iatEntry) {
                 if (iatEntry >> 31) {
@@ -530,6 +536,7 @@ void Win32BinaryLoader::processIAT()
                 paddr += 4;
             }
 
+            m_iatRanges.insert(iatStart, paddr);
             id++;
         }
     }
@@ -575,6 +582,55 @@ void Win32BinaryLoader::readDebugData(QString exename)
 }
 
 
+void Win32BinaryLoader::processBaseRelocations()
+{
+    // The base relocation table is the 6th data directory
+    if (READ4_LE(m_peHeader->nInterestingRVASizes) < 6) {
+        return;
+    }
+
+    const DWord tableRVA  = READ4_LE(m_peHeader->FixupTableRVA);
+    const DWord tableSize = READ4_LE(m_peHeader->TotalFixupDataSize);
+    const DWord imageSize = READ4_LE(m_peHeader->ImageSize);
+
+    if (tableRVA == 0 || tableSize == 0 || tableRVA >= imageSize ||
+        tableSize > imageSize - tableRVA) {
+        return;
+    }
+
+    const Address imageBase = Address(READ4_LE(m_peHeader->Imagebase));
+    std::vector<Address> relocations;
+
+    // The table consists of blocks, each starting with the RVA of a 4k page and the size
+    // of the block, followed by 16 bit entries: 4 bits type, 12 bits offset into the page.
+    DWord blockOffset = 0;
+    while (blockOffset + 8 <= tableSize) {
+        const char *block     = m_image + tableRVA + blockOffset;
+        const DWord pageRVA   = Util::readDWord(block, Endian::Little);
+        const DWord blockSize = Util::readDWord(block + 4, Endian::Little);
+
+        if (blockSize < 8 || blockSize > tableSize - blockOffset) {
+            LOG_WARN("Invalid base relocation block at offset %1", blockOffset);
+            break;
+        }
+
+        for (DWord entryOffset = 8; entryOffset + 2 <= blockSize; entryOffset += 2) {
+            const SWord entry = Util::readWord(block + entryOffset, Endian::Little);
+            const int type    = (entry >> 12) & 0xF;
+
+            if (type == IMAGE_REL_BASED_HIGHLOW) {
+                relocations.push_back(imageBase + Address(pageRVA + (entry & 0xFFF)));
+            }
+        }
+
+        blockOffset += blockSize;
+    }
+
+    m_numRelocs = static_cast<int>(relocations.size());
+    m_binaryImage->addRelocations(std::move(relocations));
+}
+
+
 bool Win32BinaryLoader::loadFromMemory(QByteArray &arr)
 {
     const char *data     = arr.constData();
@@ -672,6 +728,7 @@ bool Win32BinaryLoader::loadFromMemory(QByteArray &arr)
 
     // Add the Import Address Table entries to the symbol table
     processIAT();
+    processBaseRelocations();
 
     // Was hoping that _main or main would turn up here for Borland console mode programs. No such
     // luck. I think IDA Pro must find it by a combination of FLIRT and some pattern matching
@@ -687,10 +744,8 @@ bool Win32BinaryLoader::loadFromMemory(QByteArray &arr)
         }
     }
 
-    // Give a name to any jumps you find to these import entries
-    // NOTE: VERY early MSVC specific!! Temporary till we can think of a better way.
-    Address start = getEntryPoint();
-    findJumps(start);
+    // Give a name to any jumps to import entries, and find statically linked library functions
+    scanCodePatterns();
 
     // TODO: loading debuging data should be an optional step, decision should be made 'upstream'
     // readDebugData();
@@ -721,62 +776,85 @@ int Win32BinaryLoader::canLoad(QIODevice &fl) const
 }
 
 
-/**
- * \internal Used above for a hack to find jump instructions pointing to IATs.
- * Heuristic: start just before the "start" entry point looking for FF 25 opcodes followed by a
- * pointer to an import entry.  E.g. FF 25 58 44 40 00  where 00404458 is the IAT for _ftol. Note:
- * some are on 0x10 byte boundaries, some on 2 byte boundaries (6 byte jumps packed), and there are
- * often up to 0x30 bytes of statically linked library code (e.g. _atexit, __onexit) with sometimes
- * two static libs in a row. So keep going until there is about 0x60 bytes with no match. Note:
- * slight chance of coming across a misaligned match; probability is about 1/65536 times dozens in
- * 2^32 ~= 10^-13
- */
-void Win32BinaryLoader::findJumps(Address curr)
+/// Functions of the statically linked MinGW runtime, recognized by their code.
+/// The names are the names expected by PentiumFrontEnd::isHelperFunc.
+static const struct
 {
-    BinarySection *section = m_binaryImage->getSectionByName(".text");
-    if (section == nullptr) {
-        section = m_binaryImage->getSectionByName("CODE");
-        if (section == nullptr) {
-            return;
-        }
-    }
+    const char *name;
+    const char *pattern;
+} MINGW_FUNCTIONS[] = {
+    { "__mingw_allocstack",
+      "51 89 E1 83 C1 08 3D 00 10 00 00 72 10 81 E9 00 10 00 00 83 09 00 2D 00 10 00 00 EB E9 "
+      "29 C1 83 09 00 89 E0 89 CC 8B 08 8B 40 04 FF E0" },
+    { "__mingw_frame_init",
+      "55 89 E5 83 EC 18 89 7D FC 8B 7D 08 89 5D F4 89 75 F8 ?? ?? ?? ?? ?? ?? "
+      "85 D2 74 24 8B 42 2C 85 C0 78 3D 8B 42 2C 85 C0 75 56 8B 42 28 89 07 89 7A 28 8B 5D F4 "
+      "8B 75 F8 8B 7D FC 89 EC 5D C3" },
+    { "__mingw_frame_end",
+      "55 89 E5 53 83 EC 14 8B 45 08 8B 18 ?? ?? ?? ?? ?? "
+      "85 C0 74 1B 8B 48 2C 85 C9 78 34 8B 50 2C 85 D2 75 4D 89 58 28 8B 5D FC C9 C3" },
+    { "__mingw_cleanup_setup",
+      "55 89 E5 53 83 EC 04 ?? ?? ?? ?? ?? ?? 85 DB 75 35 "
+      "?? ?? ?? ?? ?? ?? ?? ?? ?? ?? ?? ?? ?? ?? ?? ?? "
+      "83 F8 FF 74 24 85 C0 89 C3 74 0E 8D 74 26 00" },
+    { "malloc",
+      "55 89 E5 8D 45 F4 83 EC 58 89 45 E0 8D 45 C0 89 04 24 89 5D F4 89 75 F8 89 7D FC "
+      "?? ?? ?? ?? ?? ?? ?? ?? ?? ?? ?? ?? ?? ?? ?? ?? ?? ?? ?? ?? ?? 89 65 E8" },
+};
 
-    // Add to native addr to get host:
-    ptrdiff_t delta = (section->getHostAddr() - section->getSourceAddr()).value();
 
-    int cnt = 0;         // Count of bytes with no match
-    while (cnt < 0x60) { // Max of 0x60 bytes without a match
-        curr -= 2;       // Has to be on 2-byte boundary
-        cnt += 2;
+void Win32BinaryLoader::scanCodePatterns()
+{
+    BytePatternScanner scanner;
 
-        if (curr < section->getSourceAddr()) {
-            break; // stepped out of section
-        }
+    // Jumps to IAT entries, e.g. FF 25 58 44 40 00 where 00404458 is the IAT entry for _ftol.
+    const int jumpPattern = scanner.addPattern("FF 25 ?? ?? ?? ??");
 
-        const HostAddress instrPtr(curr, delta);
-        const Byte *opcode = reinterpret_cast<const Byte *>(instrPtr.value());
-        if (opcode[0] != 0xFF || opcode[1] != 0x25) { // only check FF 25 jumps
-            continue;
-        }
+    std::map<int, MinGWFunction> mingwPatterns;
+    for (int i = 0; i < static_cast<int>(MinGWFunction::NumFunctions); i++) {
+        mingwPatterns[scanner.addPattern(MINGW_FUNCTIONS[i].pattern)] = static_cast<MinGWFunction>(
+            i);
+    }
 
-        Address operand            = Address(READ4_LE_P(HostAddress(curr, delta + 2)));
-        const BinarySymbol *symbol = m_symbols->findSymbolByAddress(operand);
+    for (const BytePatternScanner::Match &match : scanner.scanCode(m_binaryImage)) {
+        if (match.patternID == jumpPattern) {
+            const Address operand      = Address(m_binaryImage->readNative4(match.addr + 2));
+            const BinarySymbol *symbol = m_symbols->findSymbolByAddress(operand);
 
-        if (symbol == nullptr) {
-            continue;
-        }
+            // Only jumps through IAT entries are thunks of imported functions;
+            // other indirect jumps (e.g. through a function pointer) must keep their names.
+            if (!symbol || !symbol->isImported() || !m_iatRanges.isContained(operand) ||
+                symbol->getName().startsWith("__imp_") ||
+                m_symbols->findSymbolByAddress(match.addr)) {
+                continue;
+            }
 
-        // try to rename symbol
-        const QString oldName = symbol->getName();
-        if (m_symbols->renameSymbol(oldName, "__imp_" + oldName) == false) {
-            continue;
+            // Give the jump the name of the imported function
+            const QString oldName = symbol->getName();
+            if (!m_symbols->renameSymbol(oldName, "__imp_" + oldName)) {
+                continue;
+            }
+
+            BinarySymbol *sym = m_symbols->createSymbol(match.addr, oldName);
+            sym->setAttribute("Function", true);
+            sym->setAttribute("Imported", true);
         }
+        else {
+            m_mingwFunctions[match.addr] = mingwPatterns[match.patternID];
+        }
+    }
 
-        BinarySymbol *sym = m_symbols->createSymbol(curr, oldName);
-        sym->setAttribute("Function", true);
-        sym->setAttribute("Imported", true);
-        curr -= 4; // Next match is at least 4+2 bytes away
-        cnt = 0;
+    if (!m_mingwMain) {
+        return;
+    }
+
+    for (const auto &[addr, func] : m_mingwFunctions) {
+        if (!m_symbols->findSymbolByAddress(addr)) {
+            BinarySymbol *sym = m_symbols->createSymbol(
+                addr, MINGW_FUNCTIONS[static_cast<int>(func)].name);
+            sym->setAttribute("Function", true);
+            sym->setAttribute("StaticFunction", true);
+        }
     }
 }
 
@@ -785,6 +863,8 @@ void Win32BinaryLoader::unload()
 {
     m_imageSize = 0;
     m_numRelocs = 0;
+    m_mingwFunctions.clear();
+    m_iatRanges.clear();
 
     if (m_image) {
         free(m_image);
@@ -1006,137 +1086,42 @@ bool Win32BinaryLoader::isStaticLinkedLibProc(Address addr) const
 
 bool Win32BinaryLoader::isMinGWsAllocStack(Address addr) const
 {
-    if (m_mingwMain) {
-        const BinarySection *section = m_binaryImage->getSectionByAddr(addr);
-
-        if (section) {
-            HostAddress hostAddr    = section->getHostAddr() - section->getSourceAddr() + addr;
-            unsigned char pattern[] = { 0x51, 0x89, 0xE1, 0x83, 0xC1, 0x08, 0x3D, 0x00, 0x10,
-                                        0x00, 0x00, 0x72, 0x10, 0x81, 0xE9, 0x00, 0x10, 0x00,
-                                        0x00, 0x83, 0x09, 0x00, 0x2D, 0x00, 0x10, 0x00, 0x00,
-                                        0xEB, 0xE9, 0x29, 0xC1, 0x83, 0x09, 0x00, 0x89, 0xE0,
-                                        0x89, 0xCC, 0x8B, 0x08, 0x8B, 0x40, 0x04, 0xFF, 0xE0 };
-
-            if (memcmp(hostAddr, pattern, sizeof(pattern)) == 0) {
-                return true;
-            }
-        }
-    }
-
-    return false;
+    return isMinGWFunction(addr, MinGWFunction::AllocStack);
 }
 
 
 bool Win32BinaryLoader::isMinGWsFrameInit(Address addr) const
 {
-    if (!m_mingwMain) {
-        return false;
-    }
-
-    const BinarySection *section = m_binaryImage->getSectionByAddr(addr);
-
-    if (!section) {
-        return false;
-    }
-
-    HostAddress hostAddr = section->getHostAddr() - section->getSourceAddr() + addr;
-    unsigned char pat1[] = { 0x55, 0x89, 0xE5, 0x83, 0xEC, 0x18, 0x89, 0x7D, 0xFC,
-                             0x8B, 0x7D, 0x08, 0x89, 0x5D, 0xF4, 0x89, 0x75, 0xF8 };
-
-    if (memcmp(hostAddr, pat1, sizeof(pat1)) != 0) {
-        return false;
-    }
-
-    unsigned char pat2[] = { 0x85, 0xD2, 0x74, 0x24, 0x8B, 0x42, 0x2C, 0x85, 0xC0, 0x78,
-                             0x3D, 0x8B, 0x42, 0x2C, 0x85, 0xC0, 0x75, 0x56, 0x8B, 0x42,
-                             0x28, 0x89, 0x07, 0x89, 0x7A, 0x28, 0x8B, 0x5D, 0xF4, 0x8B,
-                             0x75, 0xF8, 0x8B, 0x7D, 0xFC, 0x89, 0xEC, 0x5D, 0xC3 };
-    return memcmp(hostAddr + sizeof(pat1) + 6, pat2, sizeof(pat2)) == 0;
+    return isMinGWFunction(addr, MinGWFunction::FrameInit);
 }
 
 
 bool Win32BinaryLoader::isMinGWsFrameEnd(Address addr) const
 {
-    if (!m_mingwMain) {
-        return false;
-    }
-
-    const BinarySection *section = m_binaryImage->getSectionByAddr(addr);
-
-    if (!section) {
-        return false;
-    }
-
-    HostAddress host     = section->getHostAddr() - section->getSourceAddr() + addr;
-    unsigned char pat1[] = {
-        0x55, 0x89, 0xE5, 0x53, 0x83, 0xEC, 0x14, 0x8B, 0x45, 0x08, 0x8B, 0x18
-    };
-
-    if (memcmp(host, pat1, sizeof(pat1)) != 0) {
-        return false;
-    }
-
-    unsigned char pat2[] = { 0x85, 0xC0, 0x74, 0x1B, 0x8B, 0x48, 0x2C, 0x85, 0xC9,
-                             0x78, 0x34, 0x8B, 0x50, 0x2C, 0x85, 0xD2, 0x75, 0x4D,
-                             0x89, 0x58, 0x28, 0x8B, 0x5D, 0xFC, 0xC9, 0xC3 };
-    return memcmp(host + sizeof(pat1) + 5, pat2, sizeof(pat2)) == 0;
+    return isMinGWFunction(addr, MinGWFunction::FrameEnd);
 }
 
 
 bool Win32BinaryLoader::isMinGWsCleanupSetup(Address addr) const
 {
-    if (!m_mingwMain) {
-        return false;
-    }
-
-    const BinarySection *section = m_binaryImage->getSectionByAddr(addr);
-
-    if (!section) {
-        return false;
-    }
-
-    HostAddress host     = section->getHostAddr() - section->getSourceAddr() + addr;
-    unsigned char pat1[] = { 0x55, 0x89, 0xE5, 0x53, 0x83, 0xEC, 0x04 };
-
-    if (memcmp(host, pat1, sizeof(pat1)) != 0) {
-        return false;
-    }
-
-    unsigned char pat2[] = { 0x85, 0xDB, 0x75, 0x35 };
-
-    if (memcmp(host + sizeof(pat1) + 6, pat2, sizeof(pat2)) != 0) {
-        return false;
-    }
-
-    unsigned char pat3[] = { 0x83, 0xF8, 0xFF, 0x74, 0x24, 0x85, 0xC0, 0x89,
-                             0xC3, 0x74, 0x0E, 0x8D, 0x74, 0x26, 0x00 };
-    return memcmp(host + sizeof(pat1) + 6 + sizeof(pat2) + 16, pat3, sizeof(pat3)) == 0;
+    return isMinGWFunction(addr, MinGWFunction::CleanupSetup);
 }
 
 
 bool Win32BinaryLoader::isMinGWsMalloc(Address addr) const
 {
-    if (!m_mingwMain) {
-        return false;
-    }
-
-    const BinarySection *section = m_binaryImage->getSectionByAddr(addr);
-
-    if (!section) {
-        return false;
-    }
+    return isMinGWFunction(addr, MinGWFunction::Malloc);
+}
 
-    HostAddress host     = section->getHostAddr() - section->getSourceAddr() + addr;
-    unsigned char pat1[] = { 0x55, 0x89, 0xE5, 0x8D, 0x45, 0xF4, 0x83, 0xEC, 0x58,
-                             0x89, 0x45, 0xE0, 0x8D, 0x45, 0xC0, 0x89, 0x04, 0x24,
-                             0x89, 0x5D, 0xF4, 0x89, 0x75, 0xF8, 0x89, 0x7D, 0xFC };
 
-    if (memcmp(host, pat1, sizeof(pat1)) != 0) {
+bool Win32BinaryLoader::isMinGWFunction(Address addr, MinGWFunction func) const
+{
+    if (!m_mingwMain) {
         return false;
     }
 
-    unsigned char pat2[] = { 0x89, 0x65, 0xE8 };
-    return memcmp((host + sizeof(pat1) + 0x15), pat2, sizeof(pat2)) == 0;
+    auto it = m_mingwFunctions.find(addr);
+    return it != m_mingwFunctions.end() && it->second == func;
 }
 
 
@@ -11,7 +11,9 @@
 
 
 #include "boomerang/ifc/IFileLoader.h"
+#include "boomerang/util/IntervalSet.h"
 
+#include <map>
 #include <string>
 
 /**
@@ -207,11 +209,32 @@ public:
 
 protected:
     void processIAT();
+
+    /// Add the destinations of all base relocations to the relocation index of the image.
+    void processBaseRelocations();
     void readDebugData(QString exename);
 
 private:
-    /// Find names for jumps to IATs
-    void findJumps(Address curr);
+    /// Functions of the statically linked MinGW runtime
+    enum class MinGWFunction : uint8_t
+    {
+        AllocStack,
+        FrameInit,
+        FrameEnd,
+        CleanupSetup,
+        Malloc,
+        NumFunctions
+    };
+
+    /**
+     * Scan the code sections once for jumps to IAT entries and for statically linked
+     * library functions. Jumps to IAT entries are given the name of the imported function;
+     * the library functions are stored in m_mingwFunctions and are given a symbol
+     * if this is a MinGW binary.
+     */
+    void scanCodePatterns();
+
+    bool isMinGWFunction(Address addr, MinGWFunction func) const;
 
 private:
     char *m_image;   ///< Beginning of the loaded image
@@ -225,4 +248,10 @@ private:
 
     BinaryImage *m_binaryImage;
     BinarySymbolTable *m_symbols;
+
+    /// Statically linked MinGW runtime functions, by entry address
+    std::map<Address, MinGWFunction> m_mingwFunctions;
+
+    /// Address ranges of the Import Address Tables of all imported DLLs
+    IntervalSet<Address> m_iatRanges;
 };
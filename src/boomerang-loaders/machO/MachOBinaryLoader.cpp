@@ -355,6 +355,9 @@ bool MachOBinaryLoader::loadFromMemory(QByteArray &img)
     }
 
     // process the remaining symbols
+    std::vector<std::pair<Address, QString>> remainingSymbols;
+    remainingSymbols.reserve(symbols.size());
+
     for (unsigned i = 0; i < symbols.size(); i++) {
         char *name = strtbl + BMMH(symbols[i].n_un.n_strx);
 
@@ -374,10 +377,12 @@ bool MachOBinaryLoader::loadFromMemory(QByteArray &img)
                 name++;
             }
 
-            Symbols->createSymbol(Address(BMMH(symbols[i].n_value)), name);
+            remainingSymbols.emplace_back(Address(BMMH(symbols[i].n_value)), name);
         }
     }
 
+    Symbols->createSymbols(remainingSymbols);
+
     // process objective-c section
     if (objc_modules != Address::INVALID) {
         DEBUG_PRINT("Processing objective-c section");
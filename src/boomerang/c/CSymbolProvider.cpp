@@ -29,12 +29,52 @@ CSymbolProvider::CSymbolProvider(Prog *prog)
 
 
 bool CSymbolProvider::readLibraryCatalog(const QString &filePath)
+{
+    std::vector<SignatureDB::CatalogEntry> entries;
+    if (!readCatalogEntries(filePath, entries)) {
+        return false;
+    }
+
+    // Prefer the precompiled signature database, if it is up to date
+    const Machine machine = m_prog->getMachine();
+    std::unique_ptr<SignatureDB> db(new SignatureDB);
+
+    if (db->open(SignatureDB::getDBFileName(filePath, machine), machine,
+                 SignatureDB::hashCatalog(filePath, entries))) {
+        db->registerNamedTypes();
+
+        // Signatures of this catalog override signatures of previously read catalogs
+        for (auto it = m_librarySignatures.begin(); it != m_librarySignatures.end();) {
+            if (db->contains(it.key())) {
+                it = m_librarySignatures.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+
+        m_signatureDBs.push_back(std::move(db));
+        return true;
+    }
+
+    for (const SignatureDB::CatalogEntry &entry : entries) {
+        if (!parseSignatureFile(entry.first, machine, entry.second, m_librarySignatures)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+bool CSymbolProvider::readCatalogEntries(const QString &catalogFile,
+                                         std::vector<SignatureDB::CatalogEntry> &entries)
 {
     // TODO: this is a work for generic semantics provider plugin : HeaderReader
-    QFile file(filePath);
+    QFile file(catalogFile);
 
     if (!file.open(QFile::ReadOnly | QFile::Text)) {
-        LOG_ERROR("Cannot open library signature catalog `%1'", filePath);
+        LOG_ERROR("Cannot open library signature catalog `%1'", catalogFile);
         return false;
     }
 
@@ -63,17 +103,17 @@ bool CSymbolProvider::readLibraryCatalog(const QString &filePath)
             cc = CallConv::ThisCall; // Another exception
         }
 
-        const QString sig_path = QFileInfo(filePath).absoluteDir().absoluteFilePath(sigFilePath);
-        if (!readLibrarySignatures(qPrintable(sig_path), cc)) {
-            return false;
-        }
+        const QString sig_path = QFileInfo(catalogFile).absoluteDir().absoluteFilePath(sigFilePath);
+        entries.push_back({ sig_path, cc });
     }
 
     return true;
 }
 
 
-bool CSymbolProvider::readLibrarySignatures(const QString &signatureFile, CallConv cc)
+bool CSymbolProvider::parseSignatureFile(const QString &signatureFile, Machine machine,
+                                         CallConv cc,
+                                         QMap<QString, std::shared_ptr<Signature>> &signatures)
 {
     std::unique_ptr<AnsiCParser> p;
 
@@ -85,10 +125,10 @@ bool CSymbolProvider::readLibrarySignatures(const QString &signatureFile, CallCo
         return false;
     }
 
-    p->yyparse(m_prog->getMachine(), cc);
+    p->yyparse(machine, cc);
 
     for (auto &signature : p->signatures) {
-        m_librarySignatures[signature->getName()] = signature;
+        signatures[signature->getName()] = signature;
         signature->setSigFilePath(signatureFile);
     }
 
@@ -148,6 +188,23 @@ bool CSymbolProvider::addSymbolsFromSymbolFile(const QString &fname)
 
 std::shared_ptr<Signature> CSymbolProvider::getSignatureByName(const QString &functionName) const
 {
+    std::lock_guard<std::mutex> lock(m_librarySignaturesMutex);
+
     auto it = m_librarySignatures.find(functionName);
-    return it != m_librarySignatures.end() ? it.value() : nullptr;
+    if (it != m_librarySignatures.end()) {
+        return it.value();
+    }
+
+    // Search the most recently read catalogs first.
+    // Remember the signature so that subsequent lookups return the same object.
+    for (auto db = m_signatureDBs.rbegin(); db != m_signatureDBs.rend(); ++db) {
+        std::shared_ptr<Signature> sig = (*db)->getSignature(functionName);
+
+        if (sig) {
+            m_librarySignatures[functionName] = sig;
+            return sig;
+        }
+    }
+
+    return nullptr;
 }
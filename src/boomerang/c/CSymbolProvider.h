@@ -10,11 +10,15 @@
 #pragma once
 
 
+#include "boomerang/c/SignatureDB.h"
 #include "boomerang/frontend/SigEnum.h"
 #include "boomerang/ifc/ISymbolProvider.h"
 
 #include <QMap>
 
+#include <mutex>
+#include <vector>
+
 
 class Prog;
 
@@ -35,10 +39,35 @@ public:
     /// \copydoc ISymbolProvider::getSignatureByName
     std::shared_ptr<Signature> getSignatureByName(const QString &functionName) const override;
 
-private:
-    bool readLibrarySignatures(const QString &signatureFile, CallConv cc);
+public:
+    /**
+     * Read the list of header files from the library signature catalog \p catalogFile.
+     * \param entries receives the absolute paths of the header files
+     * and the calling conventions of the functions declared therein.
+     * \returns true on success.
+     */
+    static bool readCatalogEntries(const QString &catalogFile,
+                                   std::vector<SignatureDB::CatalogEntry> &entries);
+
+    /**
+     * Parse all signatures declared in the header file \p signatureFile
+     * and add them to \p signatures, replacing existing signatures with the same name.
+     * \returns true on success.
+     */
+    static bool parseSignatureFile(const QString &signatureFile, Machine machine, CallConv cc,
+                                   QMap<QString, std::shared_ptr<Signature>> &signatures);
 
 private:
     Prog *m_prog;
-    QMap<QString, std::shared_ptr<Signature>> m_librarySignatures;
+
+    /// Signatures read from header files, and signatures already materialized
+    /// from signature databases
+    mutable QMap<QString, std::shared_ptr<Signature>> m_librarySignatures;
+
+    /// Guards the lookup and materialization of signatures in getSignatureByName,
+    /// which may be called by multiple threads
+    mutable std::mutex m_librarySignaturesMutex;
+
+    /// Precompiled signature databases, in the order their catalogs were read
+    std::vector<std::unique_ptr<SignatureDB>> m_signatureDBs;
 };
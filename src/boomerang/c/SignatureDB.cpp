@@ -0,0 +1,377 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "SignatureDB.h"
+
+#include "boomerang/c/CSymbolProvider.h"
+#include "boomerang/db/signature/Signature.h"
+#include "boomerang/ssl/Serializer.h"
+#include "boomerang/ssl/exp/Operator.h"
+#include "boomerang/ssl/type/Type.h"
+#include "boomerang/util/ByteUtil.h"
+#include "boomerang/util/log/Log.h"
+
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QFileInfo>
+#include <QMap>
+#include <QSaveFile>
+
+
+/// Identifies boomerang signature database files ("BSDB")
+static const quint32 SIGDB_MAGIC = 0x42534442;
+
+/// Increment this whenever the database file format changes.
+static const quint32 SIGDB_VERSION = 2;
+
+/// Databases are only valid for the build of Boomerang that wrote them,
+/// since the serialized layout of types and expressions may have changed in between.
+static const QString SIGDB_BUILD = QString(BOOMERANG_VERSION);
+
+/// Size of a slot of the hash index in bytes (hash + record offset)
+static const quint32 SLOT_SIZE = 8;
+
+
+/// Stable hash of a function name (FNV-1a).
+/// qHash cannot be used since it is not guaranteed to be stable across Qt versions.
+static quint32 hashName(const QString &name)
+{
+    quint32 hash = 2166136261u;
+
+    for (char c : name.toUtf8()) {
+        hash = (hash ^ static_cast<quint8>(c)) * 16777619u;
+    }
+
+    return hash;
+}
+
+
+static QString getMachineName(Machine machine)
+{
+    switch (machine) {
+    case Machine::PENTIUM: return "pentium";
+    case Machine::SPARC: return "sparc";
+    case Machine::HPRISC: return "hppa";
+    case Machine::PALM: return "palm";
+    case Machine::PPC: return "ppc";
+    case Machine::ST20: return "st20";
+    case Machine::MIPS: return "mips";
+    case Machine::M68K: return "m68k";
+    default: return "unknown";
+    }
+}
+
+
+SignatureDB::SignatureDB()
+{
+}
+
+
+SignatureDB::~SignatureDB()
+{
+    if (m_data) {
+        m_file.unmap(const_cast<uchar *>(m_data));
+    }
+}
+
+
+QString SignatureDB::getDBFileName(const QString &catalogFile, Machine machine)
+{
+    return QString("%1.%2.sigdb").arg(catalogFile).arg(getMachineName(machine));
+}
+
+
+QByteArray SignatureDB::hashCatalog(const QString &catalogFile,
+                                    const std::vector<CatalogEntry> &entries)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+
+    QFile catalog(catalogFile);
+    if (!catalog.open(QFile::ReadOnly)) {
+        return QByteArray();
+    }
+
+    hash.addData(catalog.readAll());
+
+    for (const CatalogEntry &entry : entries) {
+        QFile header(entry.first);
+        if (!header.open(QFile::ReadOnly)) {
+            return QByteArray();
+        }
+
+        hash.addData(header.readAll());
+    }
+
+    return hash.result();
+}
+
+
+bool SignatureDB::compile(const QString &catalogFile, Machine machine, const QString &dbFile)
+{
+    std::vector<CatalogEntry> entries;
+    if (!CSymbolProvider::readCatalogEntries(catalogFile, entries)) {
+        return false;
+    }
+
+    const QByteArray catalogHash = hashCatalog(catalogFile, entries);
+    if (catalogHash.isEmpty()) {
+        return false;
+    }
+
+    // Only store the named types declared in this catalog
+    Type::clearNamedTypes();
+
+    QMap<QString, std::shared_ptr<Signature>> signatures;
+    for (const CatalogEntry &entry : entries) {
+        if (!CSymbolProvider::parseSignatureFile(entry.first, machine, entry.second,
+                                                 signatures)) {
+            return false;
+        }
+    }
+
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+
+    QDataStream os(&buffer);
+    os.setVersion(QDataStream::Qt_5_0);
+
+    os << SIGDB_MAGIC << SIGDB_VERSION << SIGDB_BUILD << static_cast<qint32>(opNumOf)
+       << static_cast<quint8>(machine) << catalogHash;
+
+    // index location; filled in later
+    const qint64 indexInfoPos = buffer.pos();
+    os << static_cast<quint64>(0) << static_cast<quint32>(0);
+
+    SerialWriter writer(os);
+    const QMap<QString, SharedType> &namedTypes = Type::getNamedTypes();
+
+    os << static_cast<quint32>(namedTypes.size());
+    for (auto it = namedTypes.begin(); it != namedTypes.end(); ++it) {
+        os << it.key();
+
+        if (!writer.writeType(it.value())) {
+            LOG_ERROR("Cannot compile signature database '%1': Type '%2' cannot be serialized",
+                      dbFile, it.key());
+            return false;
+        }
+    }
+
+    // Signature records. Signature file paths are stored relative to the catalog
+    // so the database can be moved together with the catalog.
+    const QDir catalogDir = QFileInfo(catalogFile).absoluteDir();
+    std::vector<std::pair<quint32, quint32>> records; // hash -> offset
+
+    for (auto it = signatures.begin(); it != signatures.end(); ++it) {
+        records.push_back({ hashName(it.key()), static_cast<quint32>(buffer.pos()) });
+
+        std::shared_ptr<Signature> sig = it.value();
+        sig->setSigFilePath(catalogDir.relativeFilePath(sig->getSigFilePath()));
+
+        os << it.key();
+        if (!writer.writeSignature(sig.get())) {
+            LOG_ERROR("Cannot compile signature database '%1': "
+                      "Signature of '%2' cannot be serialized",
+                      dbFile, it.key());
+            return false;
+        }
+    }
+
+    // Hash index with linear probing; keep the load factor <= 0.5
+    quint32 numSlots = 16;
+    while (numSlots < 2 * records.size()) {
+        numSlots *= 2;
+    }
+
+    std::vector<std::pair<quint32, quint32>> index(numSlots, { 0, 0 });
+    for (const std::pair<quint32, quint32> &record : records) {
+        quint32 pos = record.first & (numSlots - 1);
+        while (index[pos].second != 0) {
+            pos = (pos + 1) & (numSlots - 1);
+        }
+
+        index[pos] = record;
+    }
+
+    const quint64 indexOffset = buffer.pos();
+    for (const std::pair<quint32, quint32> &slot : index) {
+        os << slot.first << slot.second;
+    }
+
+    buffer.seek(indexInfoPos);
+    os << indexOffset << numSlots;
+    buffer.close();
+
+    QSaveFile file(dbFile);
+    if (!file.open(QFile::WriteOnly) || file.write(buffer.data()) != buffer.data().size() ||
+        !file.commit()) {
+        LOG_ERROR("Cannot write signature database '%1'", dbFile);
+        return false;
+    }
+
+    return true;
+}
+
+
+bool SignatureDB::open(const QString &dbFile, Machine machine, const QByteArray &catalogHash)
+{
+    if (m_data || catalogHash.isEmpty()) {
+        return false;
+    }
+
+    m_file.setFileName(dbFile);
+    if (!m_file.open(QFile::ReadOnly)) {
+        return false;
+    }
+
+    m_size = m_file.size();
+    m_data = m_file.map(0, m_size);
+    if (!m_data) {
+        return false;
+    }
+
+    const QByteArray data = QByteArray::fromRawData(reinterpret_cast<const char *>(m_data),
+                                                    static_cast<int>(m_size));
+    QDataStream is(data);
+    is.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic, version;
+    QString build;
+    qint32 numOpers;
+    quint8 dbMachine;
+    QByteArray dbHash;
+
+    is >> magic >> version >> build >> numOpers >> dbMachine >> dbHash >> m_indexOffset >>
+        m_numSlots;
+    m_typesOffset = is.device() ? is.device()->pos() : 0;
+
+    const bool valid = is.status() == QDataStream::Ok && magic == SIGDB_MAGIC &&
+                       version == SIGDB_VERSION && build == SIGDB_BUILD &&
+                       numOpers == static_cast<qint32>(opNumOf) &&
+                       dbMachine == static_cast<quint8>(machine) && dbHash == catalogHash &&
+                       m_numSlots > 0 && (m_numSlots & (m_numSlots - 1)) == 0 &&
+                       m_indexOffset + static_cast<quint64>(m_numSlots) * SLOT_SIZE <=
+                           static_cast<quint64>(m_size);
+
+    if (!valid) {
+        LOG_VERBOSE("Signature database '%1' is outdated, ignoring", dbFile);
+        m_file.unmap(const_cast<uchar *>(m_data));
+        m_file.close();
+        m_data = nullptr;
+        return false;
+    }
+
+    m_machine    = machine;
+    m_catalogDir = QFileInfo(dbFile).absoluteDir();
+    return true;
+}
+
+
+void SignatureDB::registerNamedTypes() const
+{
+    if (!m_data) {
+        return;
+    }
+
+    const QByteArray data = QByteArray::fromRawData(
+        reinterpret_cast<const char *>(m_data + m_typesOffset),
+        static_cast<int>(m_indexOffset - m_typesOffset));
+
+    QDataStream is(data);
+    is.setVersion(QDataStream::Qt_5_0);
+    SerialReader reader(is, m_machine);
+
+    quint32 numTypes;
+    is >> numTypes;
+
+    for (quint32 i = 0; i < numTypes && reader.ok(); i++) {
+        QString name;
+        is >> name;
+
+        SharedType ty = reader.readType();
+        if (ty && reader.ok()) {
+            Type::addNamedType(name, ty);
+        }
+    }
+}
+
+
+bool SignatureDB::contains(const QString &name) const
+{
+    return findRecord(name) != 0;
+}
+
+
+std::shared_ptr<Signature> SignatureDB::getSignature(const QString &name) const
+{
+    const quint32 offset = findRecord(name);
+    if (offset == 0) {
+        return nullptr;
+    }
+
+    const QByteArray data = QByteArray::fromRawData(
+        reinterpret_cast<const char *>(m_data + offset), static_cast<int>(m_size - offset));
+
+    QDataStream is(data);
+    is.setVersion(QDataStream::Qt_5_0);
+    SerialReader reader(is, m_machine);
+
+    QString recordName;
+    is >> recordName;
+
+    std::shared_ptr<Signature> sig = reader.readSignature();
+    if (!sig || !reader.ok()) {
+        LOG_WARN("Cannot read signature of '%1' from signature database '%2'", name,
+                 m_file.fileName());
+        return nullptr;
+    }
+
+    sig->setSigFilePath(m_catalogDir.absoluteFilePath(sig->getSigFilePath()));
+    return sig;
+}
+
+
+quint32 SignatureDB::findRecord(const QString &name) const
+{
+    if (!m_data) {
+        return 0;
+    }
+
+    const quint32 hash = hashName(name);
+    const quint32 mask = m_numSlots - 1;
+
+    quint32 pos = hash & mask;
+
+    for (quint32 i = 0; i < m_numSlots; i++, pos = (pos + 1) & mask) {
+        const uchar *slot    = m_data + m_indexOffset + pos * SLOT_SIZE;
+        const quint32 offset = Util::readDWord(slot + 4, Endian::Big);
+
+        if (offset == 0 || offset >= m_size) {
+            return 0;
+        }
+        else if (Util::readDWord(slot, Endian::Big) != hash) {
+            continue;
+        }
+
+        const QByteArray data = QByteArray::fromRawData(
+            reinterpret_cast<const char *>(m_data + offset), static_cast<int>(m_size - offset));
+
+        QDataStream is(data);
+        is.setVersion(QDataStream::Qt_5_0);
+
+        QString recordName;
+        is >> recordName;
+
+        if (recordName == name) {
+            return offset;
+        }
+    }
+
+    return 0;
+}
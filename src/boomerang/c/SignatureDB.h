@@ -0,0 +1,105 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/db/binary/BinaryFile.h"
+#include "boomerang/frontend/SigEnum.h"
+
+#include <QByteArray>
+#include <QDir>
+#include <QFile>
+#include <QString>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+
+class Signature;
+
+
+/**
+ * A precompiled database of the library function signatures declared
+ * in the headers of a signature catalog (e.g. common.hs), for a single machine.
+ *
+ * The database file is memory mapped, and signatures are located via a hash index
+ * stored in the file itself. A Signature object is only created when
+ * the signature is actually requested, so opening a database is much cheaper
+ * than parsing all headers of the catalog.
+ *
+ * Database files are created offline (see boomerang-cli --compile-signatures)
+ * and are stored next to the catalog. A database is only used if it was created
+ * from a catalog and headers with exactly the same contents.
+ */
+class BOOMERANG_API SignatureDB
+{
+public:
+    /// A header file listed in a catalog, and the calling convention of its functions.
+    typedef std::pair<QString, CallConv> CatalogEntry;
+
+public:
+    SignatureDB();
+    SignatureDB(const SignatureDB &other) = delete;
+    SignatureDB(SignatureDB &&other)      = delete;
+
+    ~SignatureDB();
+
+    SignatureDB &operator=(const SignatureDB &other) = delete;
+    SignatureDB &operator=(SignatureDB &&other) = delete;
+
+public:
+    /// \returns the name of the database file for \p catalogFile and \p machine.
+    static QString getDBFileName(const QString &catalogFile, Machine machine);
+
+    /// \returns the content hash of the catalog and all headers listed in \p entries.
+    static QByteArray hashCatalog(const QString &catalogFile,
+                                  const std::vector<CatalogEntry> &entries);
+
+    /**
+     * Parse all headers of the catalog \p catalogFile and write the resulting signatures
+     * and named types to the database file \p dbFile.
+     * \note This clears all named types.
+     * \returns true on success.
+     */
+    static bool compile(const QString &catalogFile, Machine machine, const QString &dbFile);
+
+    /**
+     * Open the database file \p dbFile.
+     * \param catalogHash the current content hash of the catalog (see hashCatalog)
+     * \returns false if the database does not exist, is corrupt or outdated.
+     */
+    bool open(const QString &dbFile, Machine machine, const QByteArray &catalogHash);
+
+    /// Add all named types declared in the headers of the catalog to the global type list.
+    void registerNamedTypes() const;
+
+    /// \returns true if the database contains the signature of function \p name
+    bool contains(const QString &name) const;
+
+    /// \returns a new Signature object for function \p name,
+    /// or nullptr if no such signature exists.
+    std::shared_ptr<Signature> getSignature(const QString &name) const;
+
+private:
+    /// \returns the offset of the signature record of \p name in the file, or 0 if not found.
+    quint32 findRecord(const QString &name) const;
+
+private:
+    QFile m_file;
+    QDir m_catalogDir; ///< relative paths of signature files are relative to this directory
+    const uchar *m_data = nullptr;
+    qint64 m_size       = 0;
+    Machine m_machine   = Machine::INVALID;
+
+    quint64 m_typesOffset = 0; ///< offset of the named types
+    quint64 m_indexOffset = 0; ///< offset of the hash index
+    quint32 m_numSlots    = 0; ///< number of slots in the hash index (power of 2)
+};
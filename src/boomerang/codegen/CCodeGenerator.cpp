@@ -13,6 +13,9 @@
 #include "boomerang/core/Settings.h"
 #include "boomerang/db/BasicBlock.h"
 #include "boomerang/db/Prog.h"
+#include "boomerang/db/binary/BinaryFile.h"
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySection.h"
 #include "boomerang/db/module/Module.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/db/signature/Signature.h"
@@ -32,6 +35,14 @@
 #include "boomerang/ssl/type/IntegerType.h"
 #include "boomerang/ssl/type/PointerType.h"
 #include "boomerang/util/log/Log.h"
+#include "boomerang/util/log/Trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 
 bool isBareMemof(const Exp &exp, UserProc *)
@@ -75,6 +86,11 @@ void CCodeGenerator::generateCode(const Prog *prog, Module *cluster, UserProc *p
             if (global) {
                 print(prog->getRootModule());
             }
+
+            if (prog->getProject()->getSettings()->generateDataSections &&
+                prog->getBinaryFile()) {
+                generateDataSections(prog);
+            }
         }
     }
 
@@ -95,6 +111,8 @@ void CCodeGenerator::generateCode(const Prog *prog, Module *cluster, UserProc *p
         print(prog->getRootModule());
     }
 
+    std::vector<std::pair<Module *, UserProc *>> procs;
+
     for (const auto &module : prog->getModuleList()) {
         if (!generate_all && (module.get() != cluster)) {
             continue;
@@ -115,12 +133,28 @@ void CCodeGenerator::generateCode(const Prog *prog, Module *cluster, UserProc *p
                 continue;
             }
 
-            //            CFGCompressor().compressCFG(_proc->getCFG());
-
-            generateCode(_proc);
-            print(module.get());
+            procs.push_back({ module.get(), _proc });
         }
     }
+
+    int numThreads = prog->getProject()->getSettings()->numThreads;
+    if (numThreads <= 0) {
+        numThreads = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    numThreads = static_cast<int>(std::min<size_t>(numThreads, procs.size()));
+
+    if (numThreads > 1) {
+        generateCodeParallel(procs, numThreads);
+        return;
+    }
+
+    for (auto &[module, _proc] : procs) {
+        //            CFGCompressor().compressCFG(_proc->getCFG());
+
+        generateCode(_proc);
+        print(module);
+    }
 }
 
 
@@ -433,6 +467,96 @@ void CCodeGenerator::generateCode(UserProc *proc)
         LOG_VERBOSE("%1", proc->toString());
     }
 
+    emitProc(proc);
+    proc->setStatus(PROC_CODE_GENERATED);
+}
+
+
+void CCodeGenerator::generateCodeParallel(
+    const std::vector<std::pair<Module *, UserProc *>> &procs, int numThreads)
+{
+    const Settings *settings = procs.front().second->getProg()->getProject()->getSettings();
+
+    // Passes may stop at debug points and notify watchers, so run them on this thread.
+    // Structuring the CFG does not depend on the locals, so this order gives the same output.
+    std::vector<bool> hasCode(procs.size(), false);
+
+    for (size_t i = 0; i < procs.size(); i++) {
+        UserProc *proc = procs[i].second;
+        hasCode[i]     = proc->getCFG() && proc->getEntryBB();
+
+        if (hasCode[i]) {
+            PassManager::get()->executePass(PassID::UnusedLocalRemoval, proc);
+
+            if (settings->printRTLs) {
+                LOG_VERBOSE("%1", proc->toString());
+            }
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable procDone;
+    std::vector<QStringList> lines(procs.size());
+    std::vector<bool> isDone(procs.size(), false);
+    std::atomic<size_t> nextProc(numThreads);
+
+    // Each worker has its own generator since the generator keeps per-procedure state.
+    // Worker k starts with procedure k, so every worker gets at least one procedure.
+    auto worker = [&](size_t firstProc) {
+        TRACE_SPAN("Code generation worker");
+        CCodeGenerator gen;
+
+        for (size_t i = firstProc; i < procs.size(); i = nextProc++) {
+            if (hasCode[i]) {
+                gen.m_analyzer.structureCFG(procs[i].second->getCFG());
+                gen.emitProc(procs[i].second);
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            lines[i] = std::move(gen.m_lines);
+            gen.m_lines.clear();
+            isDone[i] = true;
+            procDone.notify_all();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < numThreads; i++) {
+        workers.emplace_back(worker, static_cast<size_t>(i));
+    }
+
+    // Write the code of each procedure as soon as it and all its predecessors are done
+    for (size_t i = 0; i < procs.size(); i++) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            procDone.wait(lock, [&isDone, i]() { return isDone[i]; });
+            m_lines = std::move(lines[i]);
+        }
+
+        print(procs[i].first);
+
+        if (hasCode[i]) {
+            procs[i].second->setStatus(PROC_CODE_GENERATED);
+        }
+    }
+
+    for (std::thread &t : workers) {
+        t.join();
+    }
+}
+
+
+void CCodeGenerator::emitProc(UserProc *proc)
+{
+    TRACE_SPAN("Generate code for proc", proc);
+
+    m_lines.clear();
+    m_proc   = proc;
+    m_indent = 0;
+    m_locals.clear();
+    m_usedLabels.clear();
+    m_generatedBBs.clear();
+
     // Start generating code for this procedure.
     this->addProcStart(proc);
 
@@ -462,27 +586,158 @@ void CCodeGenerator::generateCode(UserProc *proc)
     if (m_proc->getProg()->getProject()->getSettings()->removeLabels) {
         removeUnusedLabels();
     }
+}
 
-    proc->setStatus(PROC_CODE_GENERATED);
+
+void CCodeGenerator::generateDataSections(const Prog *prog)
+{
+    const BinaryImage *image = prog->getBinaryFile()->getImage();
+
+    for (const BinarySection *section : *image) {
+        if (!section->isData() || section->getHostAddr() == HostAddress::INVALID) {
+            continue;
+        }
+
+        // Section names like ".data" are not valid C identifiers
+        QString name = section->getName();
+        for (QChar &c : name) {
+            if (!c.isLetterOrNumber() && c != '_') {
+                c = '_';
+            }
+        }
+
+        generateDataSectionCode(prog->getRootModule(), image, name, section->getSourceAddr(),
+                                section->getSize());
+    }
 }
 
 
-void CCodeGenerator::generateDataSectionCode(const BinaryImage *image, QString section_name,
-                                             Address section_start, uint32_t size)
+/// \returns true if \p c is printed as-is in a text run of a data section.
+static bool isTextChar(Byte c)
 {
+    return (c >= 0x20 && c < 0x7F) || c == '\n' || c == '\t';
+}
+
+
+void CCodeGenerator::generateDataSectionCode(const Module *module, const BinaryImage *image,
+                                             QString section_name, Address section_start,
+                                             uint32_t size)
+{
+    // Minimum number of consecutive text characters that are printed as text
+    constexpr std::size_t MIN_TEXT_RUN = 4;
+    // Maximum number of bytes per line for binary and text data
+    constexpr int MAX_BINARY_ROW = 16;
+    constexpr int MAX_TEXT_ROW   = 64;
+    // Write the generated lines to the output every so often to keep memory usage constant
+    constexpr int MAX_BUFFERED_LINES = 1024;
+    constexpr std::size_t BLOCK_SIZE = 4096;
+
     addGlobal("start_" + section_name, IntegerType::get(32, Sign::Unsigned),
               Const::get(section_start));
     addGlobal(section_name + "_size", IntegerType::get(32, Sign::Unsigned),
               Const::get(size ? size : static_cast<uint32_t>(-1)));
-    auto l = Terminal::get(opNil);
 
-    for (unsigned int i = 0; i < size; i++) {
-        int n = image->readNative1(section_start + size - 1 - i);
+    SharedType arrayType = ArrayType::get(IntegerType::get(8, Sign::Unsigned), size);
 
-        l = Binary::get(opList, Const::get(n & 0xFF), l);
+    if (size == 0) {
+        addGlobal(section_name, arrayType);
+        print(module);
+        return;
     }
 
-    addGlobal(section_name, ArrayType::get(IntegerType::get(8, Sign::Unsigned), size), l);
+    // Print the contents as a sequence of string literals, reading the section in blocks.
+    // This avoids creating an initializer expression with one node per byte.
+    QString tgt;
+    OStream s(&tgt);
+    appendType(s, arrayType->as<ArrayType>()->getBaseType());
+    s << " " << section_name << "[" << size << "] =";
+    appendLine(tgt);
+
+    QString row;
+    int rowBytes        = 0;
+    bool inText         = false;
+    bool afterHexEscape = false; // a hex digit here would extend the previous escape
+
+    // The last finished row is only added when the next row is finished,
+    // since the last row of the section must be followed by the terminator.
+    QString lastRow;
+
+    auto endRow = [&]() {
+        if (rowBytes == 0) {
+            return;
+        }
+
+        if (!lastRow.isEmpty()) {
+            appendLine(lastRow);
+
+            if (m_lines.size() >= MAX_BUFFERED_LINES) {
+                print(module);
+            }
+        }
+
+        lastRow = QString("    \"%1\"").arg(row);
+        row.clear();
+        rowBytes       = 0;
+        afterHexEscape = false;
+    };
+
+    Byte block[BLOCK_SIZE + MIN_TEXT_RUN - 1];
+
+    for (uint32_t blockStart = 0; blockStart < size; blockStart += BLOCK_SIZE) {
+        const std::size_t numBytes = std::min<std::size_t>(size - blockStart, BLOCK_SIZE);
+        const std::size_t numRead  = std::min<std::size_t>(size - blockStart,
+                                                          BLOCK_SIZE + MIN_TEXT_RUN - 1);
+
+        // bytes that cannot be read (e.g. from .bss) are 0
+        std::fill_n(block, numRead, 0);
+        image->readNative1(section_start + blockStart, block, numRead);
+
+        for (std::size_t i = 0; i < numBytes; i++) {
+            const Byte c = block[i];
+
+            if (!isTextChar(c)) {
+                inText = false;
+            }
+            else if (!inText && i + MIN_TEXT_RUN <= numRead) {
+                inText = std::all_of(block + i, block + i + MIN_TEXT_RUN, isTextChar);
+            }
+
+            if ((inText && rowBytes >= MAX_TEXT_ROW) || (!inText && rowBytes >= MAX_BINARY_ROW)) {
+                endRow();
+            }
+
+            if (!inText) {
+                row += QString("\\x%1").arg(static_cast<int>(c), 2, 16, QChar('0'));
+                afterHexEscape = true;
+            }
+            else {
+                if (afterHexEscape && std::isxdigit(c)) {
+                    row += "\" \""; // terminate the hex escape
+                }
+
+                switch (c) {
+                case '\n': row += "\\n"; break;
+                case '\t': row += "\\t"; break;
+                case '"': row += "\\\""; break;
+                case '\\': row += "\\\\"; break;
+                case '?': row += row.endsWith('?') ? "\\?" : "?"; break; // avoid trigraphs
+                default: row += QChar(c); break;
+                }
+
+                afterHexEscape = false;
+            }
+
+            rowBytes++;
+
+            if (inText && c == '\n') {
+                endRow();
+            }
+        }
+    }
+
+    endRow();
+    appendLine(lastRow + QString(";// %1 bytes").arg(size));
+    print(module);
 }
 
 
@@ -880,6 +1135,11 @@ void CCodeGenerator::addProcStart(UserProc *proc)
 
     s << "/** address: " << proc->getEntryAddress() << " */";
     appendLine(tgt);
+
+    if (proc->isDegraded()) {
+        addLineComment("Decompilation budget exceeded; this procedure may be imprecise");
+    }
+
     addFunctionSignature(proc, true);
 }
 
@@ -21,6 +21,7 @@
 #include <list>
 #include <map>
 #include <unordered_set>
+#include <vector>
 
 
 class BasicBlock;
@@ -117,9 +118,30 @@ private:
     /// Generate code for a single procedure.
     void generateCode(UserProc *proc);
 
-    /// Generate global variables from data sections.
-    void generateDataSectionCode(const BinaryImage *image, QString sectionName,
-                                 Address sectionStart, uint32_t sectionSize);
+    /**
+     * Generate code for all procedures in \p procs using \p numThreads worker threads,
+     * and write it to the modules in the order given by \p procs.
+     * The output is the same as when generating code for each procedure in turn.
+     */
+    void generateCodeParallel(const std::vector<std::pair<Module *, UserProc *>> &procs,
+                              int numThreads);
+
+    /// Emit the code of \p proc to m_lines. The CFG of \p proc must already be structured.
+    /// This does not modify any state that is shared with other procedures.
+    void emitProc(UserProc *proc);
+
+    /// Generate the contents of all initialized data sections of the binary file of \p prog
+    /// as byte arrays in the root module.
+    void generateDataSections(const Prog *prog);
+
+    /**
+     * Generate global variables from the data section at \p sectionStart
+     * and write them to \p module. The contents of the section are streamed
+     * to the output, so memory usage does not depend on the size of the section.
+     */
+    void generateDataSectionCode(const Module *module, const BinaryImage *image,
+                                 QString sectionName, Address sectionStart,
+                                 uint32_t sectionSize);
 
     /**
      * Print the declaration of a function.
@@ -45,6 +45,9 @@ bool CodeWriter::writeCode(const Module *module, const QStringList &lines)
     }
 
     assert(it != m_dests.end());
-    it->second.m_os << lines.join('\n') << '\n';
+    for (const QString &line : lines) {
+        it->second.m_os << line << '\n';
+    }
+
     return true;
 }
@@ -13,6 +13,8 @@
 #include "boomerang/db/proc/ProcCFG.h"
 #include "boomerang/util/log/Log.h"
 
+#include <utility>
+
 
 ControlFlowAnalyzer::ControlFlowAnalyzer()
 {
@@ -23,7 +25,9 @@ void ControlFlowAnalyzer::structureCFG(ProcCFG *cfg)
 {
     m_cfg = cfg;
 
-    if (m_cfg->findRetNode() == nullptr) {
+    buildNodeIndex();
+
+    if (m_cfg->findRetNode() == nullptr || m_cfg->getEntryBB() == nullptr) {
         return;
     }
 
@@ -38,106 +42,313 @@ void ControlFlowAnalyzer::structureCFG(ProcCFG *cfg)
 }
 
 
+void ControlFlowAnalyzer::buildNodeIndex()
+{
+    m_nodes.clear();
+    m_indices.clear();
+    m_postOrdering.clear();
+    m_revPostOrdering.clear();
+
+    for (BasicBlock *bb : *m_cfg) {
+        bb->setAnalyzerIndex(static_cast<int>(m_nodes.size()));
+        m_indices[bb] = static_cast<int>(m_nodes.size());
+        m_nodes.push_back(bb);
+    }
+
+    m_info.assign(m_nodes.size(), BBStructInfo());
+
+    m_succs.clear();
+    m_preds.clear();
+    m_succStart.assign(1, 0);
+    m_predStart.assign(1, 0);
+
+    for (const BasicBlock *bb : m_nodes) {
+        for (const BasicBlock *succ : bb->getSuccessors()) {
+            m_succs.push_back(getIndex(succ));
+        }
+
+        for (const BasicBlock *pred : bb->getPredecessors()) {
+            m_preds.push_back(getIndex(pred));
+        }
+
+        m_succStart.push_back(static_cast<int>(m_succs.size()));
+        m_predStart.push_back(static_cast<int>(m_preds.size()));
+    }
+}
+
+
+int ControlFlowAnalyzer::getIndex(const BasicBlock *bb) const
+{
+    // The index stored in the BB is only valid if no other analyzer
+    // has structured the CFG since.
+    const int hint = bb ? bb->getAnalyzerIndex() : -1;
+    if (hint >= 0 && hint < static_cast<int>(m_nodes.size()) && m_nodes[hint] == bb) {
+        return hint;
+    }
+
+    auto it = m_indices.find(bb);
+    return it != m_indices.end() ? it->second : -1;
+}
+
+
+const BBStructInfo &ControlFlowAnalyzer::getInfo(const BasicBlock *bb) const
+{
+    static const BBStructInfo noInfo;
+
+    const int node = getIndex(bb);
+    return node >= 0 ? m_info[node] : noInfo;
+}
+
+
+int ControlFlowAnalyzer::getSuccessor(int node, int i) const
+{
+    return (i >= 0 && i < getNumSuccessors(node)) ? m_succs[m_succStart[node] + i] : -1;
+}
+
+
 void ControlFlowAnalyzer::setTimeStamps()
 {
     // set the parenthesis for the nodes as well as setting the post-order ordering between the
     // nodes
+    const int entry = getIndex(m_cfg->getEntryBB());
+    setLoopStamps(entry);
+
+    // set the reverse parenthesis for the nodes
+    setRevLoopStamps(entry);
+
+    const int retNode = getIndex(m_cfg->findRetNode());
+    assert(retNode >= 0);
+    setRevOrder(retNode);
+}
+
+
+void ControlFlowAnalyzer::setLoopStamps(int entry)
+{
+    // Each stack entry holds a node and the number of successors already visited
+    std::vector<std::pair<int, int>> stack;
     int time = 1;
-    m_postOrdering.clear();
 
-    setLoopStamps(m_cfg->getEntryBB(), time, m_postOrdering);
+    // timestamp the current node with the current time and set its traversed flag
+    m_info[entry].m_travType   = TravType::DFS_LNum;
+    m_info[entry].m_preOrderID = time;
+    stack.push_back({ entry, 0 });
+
+    while (!stack.empty()) {
+        const int node = stack.back().first;
+        const int i    = stack.back().second++;
+
+        if (i < getNumSuccessors(node)) {
+            const int succ = getSuccessor(node, i);
+
+            // visit this child if it hasn't already been visited
+            if (succ >= 0 && m_info[succ].m_travType != TravType::DFS_LNum) {
+                m_info[succ].m_travType   = TravType::DFS_LNum;
+                m_info[succ].m_preOrderID = ++time;
+                stack.push_back({ succ, 0 });
+            }
 
-    // set the reverse parenthesis for the nodes
-    time = 1;
-    setRevLoopStamps(m_cfg->getEntryBB(), time);
+            continue;
+        }
 
-    BasicBlock *retNode = m_cfg->findRetNode();
-    assert(retNode);
-    m_revPostOrdering.clear();
-    setRevOrder(retNode, m_revPostOrdering);
+        // set the the second loopStamp value
+        m_info[node].m_postOrderID = ++time;
+
+        // add this node to the ordering structure as well as recording its position within the
+        // ordering
+        m_info[node].m_postOrderIndex = static_cast<int>(m_postOrdering.size());
+        m_postOrdering.push_back(node);
+        stack.pop_back();
+    }
+}
+
+
+void ControlFlowAnalyzer::setRevLoopStamps(int entry)
+{
+    // Each stack entry holds a node and the number of successors already visited
+    std::vector<std::pair<int, int>> stack;
+    int time = 1;
+
+    // timestamp the current node with the current time and set its traversed flag
+    m_info[entry].m_travType      = TravType::DFS_RNum;
+    m_info[entry].m_revPreOrderID = time;
+    stack.push_back({ entry, 0 });
+
+    while (!stack.empty()) {
+        const int node = stack.back().first;
+        const int i    = stack.back().second++;
+
+        if (i < getNumSuccessors(node)) {
+            // visit the unvisited children in reverse order
+            const int succ = getSuccessor(node, getNumSuccessors(node) - 1 - i);
+
+            if (succ >= 0 && m_info[succ].m_travType != TravType::DFS_RNum) {
+                m_info[succ].m_travType      = TravType::DFS_RNum;
+                m_info[succ].m_revPreOrderID = ++time;
+                stack.push_back({ succ, 0 });
+            }
+
+            continue;
+        }
+
+        m_info[node].m_revPostOrderID = ++time;
+        stack.pop_back();
+    }
+}
+
+
+void ControlFlowAnalyzer::setRevOrder(int retNode)
+{
+    // Each stack entry holds a node and the number of predecessors already visited
+    std::vector<std::pair<int, int>> stack;
+
+    // Set this node as having been traversed during the post domimator DFS ordering traversal
+    m_info[retNode].m_travType = TravType::DFS_PDom;
+    stack.push_back({ retNode, 0 });
+
+    while (!stack.empty()) {
+        const int node = stack.back().first;
+        const int i    = stack.back().second++;
+
+        if (i < getNumPredecessors(node)) {
+            const int pred = getPredecessor(node, i);
+
+            if (pred >= 0 && m_info[pred].m_travType != TravType::DFS_PDom) {
+                m_info[pred].m_travType = TravType::DFS_PDom;
+                stack.push_back({ pred, 0 });
+            }
+
+            continue;
+        }
+
+        // add this node to the ordering structure and record the post dom. order of this node as
+        // its index within this ordering structure
+        m_info[node].m_revPostOrderIndex = static_cast<int>(m_revPostOrdering.size());
+        m_revPostOrdering.push_back(node);
+        stack.pop_back();
+    }
 }
 
 
 void ControlFlowAnalyzer::updateImmedPDom()
 {
-    // traverse the nodes in order (i.e from the bottom up)
-    for (int i = m_revPostOrdering.size() - 1; i >= 0; i--) {
-        const BasicBlock *bb = m_revPostOrdering[i];
+    // The return node is the root of the reverse CFG; it is last in the reverse ordering.
+    // Traverse the other nodes from the bottom up until the post dominators do not change
+    // any more. Only successors that already have a post dominator are considered.
+    const int retNode = m_revPostOrdering.back();
+    m_info[retNode].m_immPDom = retNode;
+
+    auto intersect = [this](int a, int b) {
+        while (a != b) {
+            while (m_info[a].m_revPostOrderIndex < m_info[b].m_revPostOrderIndex) {
+                a = m_info[a].m_immPDom;
+            }
+
+            while (m_info[b].m_revPostOrderIndex < m_info[a].m_revPostOrderIndex) {
+                b = m_info[b].m_immPDom;
+            }
+        }
+
+        return a;
+    };
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
 
-        for (BasicBlock *succ : bb->getSuccessors()) {
-            if (getRevOrd(succ) > getRevOrd(bb)) {
-                setImmPDom(bb, commonPDom(getImmPDom(bb), succ));
+        for (int i = static_cast<int>(m_revPostOrdering.size()) - 2; i >= 0; i--) {
+            const int node = m_revPostOrdering[i];
+            int newPDom    = -1;
+
+            for (int j = 0; j < getNumSuccessors(node); j++) {
+                const int succ = getSuccessor(node, j);
+
+                if (succ < 0 || m_info[succ].m_revPostOrderIndex < 0 ||
+                    m_info[succ].m_immPDom < 0) {
+                    continue;
+                }
+
+                newPDom = (newPDom < 0) ? succ : intersect(succ, newPDom);
+            }
+
+            if (m_info[node].m_immPDom != newPDom) {
+                m_info[node].m_immPDom = newPDom;
+                changed                = true;
             }
         }
     }
 
+    m_info[retNode].m_immPDom = -1;
+
     // make a second pass but consider the original CFG ordering this time
-    for (const BasicBlock *bb : m_postOrdering) {
-        if (bb->getNumSuccessors() <= 1) {
+    for (const int node : m_postOrdering) {
+        if (getNumSuccessors(node) <= 1) {
             continue;
         }
 
-        for (auto &succ : bb->getSuccessors()) {
-            BasicBlock *succNode = succ;
-            setImmPDom(bb, commonPDom(getImmPDom(bb), succNode));
+        for (int j = 0; j < getNumSuccessors(node); j++) {
+            m_info[node].m_immPDom = commonPDom(m_info[node].m_immPDom, getSuccessor(node, j));
         }
     }
 
     // one final pass to fix up nodes involved in a loop
-    for (const BasicBlock *bb : m_postOrdering) {
-        if (bb->getNumSuccessors() > 1) {
-            for (auto &succ : bb->getSuccessors()) {
-                BasicBlock *succNode = succ;
-
-                if (isBackEdge(bb, succNode) && (bb->getNumSuccessors() > 1) &&
-                    getImmPDom(succNode) &&
-                    (getPostOrdering(getImmPDom(succ)) < getPostOrdering(getImmPDom(bb)))) {
-                    setImmPDom(bb, commonPDom(getImmPDom(succNode), getImmPDom(bb)));
-                }
-                else {
-                    setImmPDom(bb, commonPDom(getImmPDom(bb), succNode));
-                }
+    for (const int node : m_postOrdering) {
+        if (getNumSuccessors(node) <= 1) {
+            continue;
+        }
+
+        for (int j = 0; j < getNumSuccessors(node); j++) {
+            const int succ     = getSuccessor(node, j);
+            const int nodePDom = m_info[node].m_immPDom;
+            const int succPDom = succ >= 0 ? m_info[succ].m_immPDom : -1;
+
+            if (isBackEdge(node, succ) && succPDom >= 0 &&
+                (m_info[succPDom].m_postOrderIndex <
+                 (nodePDom >= 0 ? m_info[nodePDom].m_postOrderIndex : -1))) {
+                m_info[node].m_immPDom = commonPDom(succPDom, nodePDom);
+            }
+            else {
+                m_info[node].m_immPDom = commonPDom(nodePDom, succ);
             }
         }
     }
 }
 
 
-const BasicBlock *ControlFlowAnalyzer::commonPDom(const BasicBlock *currImmPDom,
-                                                  const BasicBlock *succImmPDom)
+int ControlFlowAnalyzer::commonPDom(int currImmPDom, int succImmPDom) const
 {
-    if (!currImmPDom) {
+    if (currImmPDom < 0) {
         return succImmPDom;
     }
 
-    if (!succImmPDom) {
+    if (succImmPDom < 0) {
         return currImmPDom;
     }
 
-    if (getRevOrd(currImmPDom) == getRevOrd(succImmPDom)) {
+    if (m_info[currImmPDom].m_revPostOrderIndex == m_info[succImmPDom].m_revPostOrderIndex) {
         return currImmPDom; // ordering hasn't been done
     }
 
-    const BasicBlock *oldCurImmPDom  = currImmPDom;
-    const BasicBlock *oldSuccImmPDom = succImmPDom;
+    const int oldCurImmPDom  = currImmPDom;
+    const int oldSuccImmPDom = succImmPDom;
 
     int giveup = 0;
 #define GIVEUP 10000
 
-    while (giveup < GIVEUP && currImmPDom && succImmPDom && (currImmPDom != succImmPDom)) {
-        if (getRevOrd(currImmPDom) > getRevOrd(succImmPDom)) {
-            succImmPDom = getImmPDom(succImmPDom);
+    while (giveup < GIVEUP && currImmPDom >= 0 && succImmPDom >= 0 &&
+           (currImmPDom != succImmPDom)) {
+        if (m_info[currImmPDom].m_revPostOrderIndex > m_info[succImmPDom].m_revPostOrderIndex) {
+            succImmPDom = m_info[succImmPDom].m_immPDom;
         }
         else {
-            currImmPDom = getImmPDom(currImmPDom);
+            currImmPDom = m_info[currImmPDom].m_immPDom;
         }
 
         giveup++;
     }
 
     if (giveup >= GIVEUP) {
-        LOG_VERBOSE("Failed to find commonPDom for %1 and %2", oldCurImmPDom->getLowAddr(),
-                    oldSuccImmPDom->getLowAddr());
+        LOG_VERBOSE("Failed to find commonPDom for %1 and %2",
+                    m_nodes[oldCurImmPDom]->getLowAddr(), m_nodes[oldSuccImmPDom]->getLowAddr());
 
         return oldCurImmPDom; // no change
     }
@@ -149,18 +360,18 @@ const BasicBlock *ControlFlowAnalyzer::commonPDom(const BasicBlock *currImmPDom,
 void ControlFlowAnalyzer::structConds()
 {
     // Process the nodes in order
-    for (const BasicBlock *currNode : m_postOrdering) {
+    for (const int currNode : m_postOrdering) {
         // does the current node have more than one out edge?
-        if (currNode->getNumSuccessors() > 1) {
+        if (getNumSuccessors(currNode) > 1) {
             // if the current conditional header is a two way node and has a back edge, then it
             // won't have a follow
-            if (hasBackEdge(currNode) && (currNode->getType() == BBType::Twoway)) {
+            if (hasBackEdge(currNode) && (m_nodes[currNode]->getType() == BBType::Twoway)) {
                 setStructType(currNode, StructType::Cond);
                 continue;
             }
 
             // set the follow of a node to be its immediate post dominator
-            setCondFollow(currNode, getImmPDom(currNode));
+            m_info[currNode].m_condFollow = m_info[currNode].m_immPDom;
 
             // set the structured type of this node
             setStructType(currNode, StructType::Cond);
@@ -168,34 +379,37 @@ void ControlFlowAnalyzer::structConds()
             // if this is an nway header, then we have to tag each of the nodes within the body of
             // the nway subgraph
             if (getCondType(currNode) == CondType::Case) {
-                setCaseHead(currNode, currNode, getCondFollow(currNode));
+                setCaseHead(currNode, m_info[currNode].m_condFollow);
             }
         }
     }
 }
 
 
-void ControlFlowAnalyzer::determineLoopType(const BasicBlock *header, bool *&loopNodes)
+void ControlFlowAnalyzer::determineLoopType(int header)
 {
-    assert(getLatchNode(header));
+    const int latch = m_info[header].m_latchNode;
+    assert(latch >= 0);
 
     // if the latch node is a two way node then this must be a post tested loop
-    if (getLatchNode(header)->getType() == BBType::Twoway) {
+    if (m_nodes[latch]->getType() == BBType::Twoway) {
         setLoopType(header, LoopType::PostTested);
 
         // if the head of the loop is a two way node and the loop spans more than one block  then it
         // must also be a conditional header
-        if ((header->getType() == BBType::Twoway) && (header != getLatchNode(header))) {
+        if ((m_nodes[header]->getType() == BBType::Twoway) && (header != latch)) {
             setStructType(header, StructType::LoopCond);
         }
     }
 
     // otherwise it is either a pretested or endless loop
-    else if (header->getType() == BBType::Twoway) {
+    else if (m_nodes[header]->getType() == BBType::Twoway) {
         // if the header is a two way node then it must have a conditional follow (since it can't
         // have any backedges leading from it). If this follow is within the loop then this must be
         // an endless loop
-        if (getCondFollow(header) && loopNodes[getPostOrdering(getCondFollow(header))]) {
+        const int follow = m_info[header].m_condFollow;
+
+        if (follow >= 0 && m_loopNodes[m_info[follow].m_postOrderIndex]) {
             setLoopType(header, LoopType::Endless);
 
             // retain the fact that this is also a conditional header
@@ -212,41 +426,43 @@ void ControlFlowAnalyzer::determineLoopType(const BasicBlock *header, bool *&loo
 }
 
 
-void ControlFlowAnalyzer::findLoopFollow(const BasicBlock *header, bool *&loopNodes)
+void ControlFlowAnalyzer::findLoopFollow(int header)
 {
-    assert(getStructType(header) == StructType::Loop ||
-           getStructType(header) == StructType::LoopCond);
+    assert(m_info[header].m_structuringType == StructType::Loop ||
+           m_info[header].m_structuringType == StructType::LoopCond);
     const LoopType loopType = getLoopType(header);
-    const BasicBlock *latch = getLatchNode(header);
+    const int latch         = m_info[header].m_latchNode;
 
     if (loopType == LoopType::PreTested) {
         // if the 'while' loop's true child is within the loop, then its false child is the loop
         // follow
-        if (loopNodes[getPostOrdering(header->getSuccessor(0))]) {
-            setLoopFollow(header, header->getSuccessor(1));
+        if (m_loopNodes[m_info[getSuccessor(header, 0)].m_postOrderIndex]) {
+            m_info[header].m_loopFollow = getSuccessor(header, 1);
         }
         else {
-            setLoopFollow(header, header->getSuccessor(0));
+            m_info[header].m_loopFollow = getSuccessor(header, 0);
         }
     }
     else if (loopType == LoopType::PostTested) {
         // the follow of a post tested ('repeat') loop is the node on the end of the non-back edge
         // from the latch node
-        if (latch->getSuccessor(0) == header) {
-            setLoopFollow(header, latch->getSuccessor(1));
+        if (getSuccessor(latch, 0) == header) {
+            m_info[header].m_loopFollow = getSuccessor(latch, 1);
         }
         else {
-            setLoopFollow(header, latch->getSuccessor(0));
+            m_info[header].m_loopFollow = getSuccessor(latch, 0);
         }
     }
     else {
         // endless loop
-        const BasicBlock *follow = nullptr;
+        int follow = -1;
 
         // traverse the ordering array between the header and latch nodes.
-        // BasicBlock * latch = header->getLatchNode(); initialized at function start
-        for (int i = getPostOrdering(header) - 1; i > getPostOrdering(latch); i--) {
-            const BasicBlock *&desc = m_postOrdering[i];
+        for (int i = m_info[header].m_postOrderIndex - 1; i > m_info[latch].m_postOrderIndex;
+             i--) {
+            const int desc           = m_postOrdering[i];
+            const BBStructInfo &info = m_info[desc];
+
             // the follow for an endless loop will have the following
             // properties:
             //   i) it will have a parent that is a conditional header inside the loop whose follow
@@ -255,13 +471,15 @@ void ControlFlowAnalyzer::findLoopFollow(const BasicBlock *header, bool *&loopNo
             //  ii) it will be outside the loop according to its loop stamp pair
             // iii) have the highest ordering of all suitable follows (i.e. highest in the graph)
 
-            if ((getStructType(desc) == StructType::Cond) && getCondFollow(desc) &&
-                (getLoopHead(desc) == header)) {
-                if (loopNodes[getPostOrdering(getCondFollow(desc))]) {
+            if ((info.m_structuringType == StructType::Cond) && info.m_condFollow >= 0 &&
+                (info.m_loopHead == header)) {
+                const int condFollowOrd = m_info[info.m_condFollow].m_postOrderIndex;
+
+                if (m_loopNodes[condFollowOrd]) {
                     // if the conditional's follow is in the same loop AND is lower in the loop,
                     // jump to this follow
-                    if (getPostOrdering(desc) > getPostOrdering(getCondFollow(desc))) {
-                        i = getPostOrdering(getCondFollow(desc));
+                    if (info.m_postOrderIndex > condFollowOrd) {
+                        i = condFollowOrd;
                     }
                     else {
                         // otherwise there is a backward jump somewhere to a node earlier in this
@@ -273,20 +491,21 @@ void ControlFlowAnalyzer::findLoopFollow(const BasicBlock *header, bool *&loopNo
                 else {
                     // otherwise find the child (if any) of the conditional header that isn't inside
                     // the same loop
-                    const BasicBlock *succ = desc->getSuccessor(0);
+                    int succ = getSuccessor(desc, 0);
 
-                    if (loopNodes[getPostOrdering(succ)]) {
-                        if (!loopNodes[getPostOrdering(desc->getSuccessor(1))]) {
-                            succ = desc->getSuccessor(1);
+                    if (m_loopNodes[m_info[succ].m_postOrderIndex]) {
+                        if (!m_loopNodes[m_info[getSuccessor(desc, 1)].m_postOrderIndex]) {
+                            succ = getSuccessor(desc, 1);
                         }
                         else {
-                            succ = nullptr;
+                            succ = -1;
                         }
                     }
 
                     // if a potential follow was found, compare its ordering with the currently
                     // found follow
-                    if (succ && (!follow || (getPostOrdering(succ) > getPostOrdering(follow)))) {
+                    if (succ >= 0 && (follow < 0 || (m_info[succ].m_postOrderIndex >
+                                                     m_info[follow].m_postOrderIndex))) {
                         follow = succ;
                     }
                 }
@@ -295,14 +514,14 @@ void ControlFlowAnalyzer::findLoopFollow(const BasicBlock *header, bool *&loopNo
 
         // if a follow was found, assign it to be the follow of the loop under
         // investigation
-        if (follow) {
-            setLoopFollow(header, follow);
+        if (follow >= 0) {
+            m_info[header].m_loopFollow = follow;
         }
     }
 }
 
 
-void ControlFlowAnalyzer::tagNodesInLoop(const BasicBlock *header, bool *&loopNodes)
+void ControlFlowAnalyzer::tagNodesInLoop(int header)
 {
     // traverse the ordering structure from the header to the latch node tagging the nodes
     // determined to be within the loop. These are nodes that satisfy the following:
@@ -314,15 +533,15 @@ void ControlFlowAnalyzer::tagNodesInLoop(const BasicBlock *header, bool *&loopNo
     //    OR
     //  iii) curNode is the latch node
 
-    const BasicBlock *latch = getLatchNode(header);
-    assert(latch);
+    const int latch = m_info[header].m_latchNode;
+    assert(latch >= 0);
 
-    for (int i = getPostOrdering(header) - 1; i >= getPostOrdering(latch); i--) {
+    for (int i = m_info[header].m_postOrderIndex - 1; i >= m_info[latch].m_postOrderIndex; i--) {
         if (isBBInLoop(m_postOrdering[i], header, latch)) {
             // update the membership map to reflect that this node is within the loop
-            loopNodes[i] = true;
+            m_loopNodes[i] = true;
 
-            setLoopHead(m_postOrdering[i], header);
+            m_info[m_postOrdering[i]].m_loopHead = header;
         }
     }
 }
@@ -330,9 +549,12 @@ void ControlFlowAnalyzer::tagNodesInLoop(const BasicBlock *header, bool *&loopNo
 
 void ControlFlowAnalyzer::structLoops()
 {
-    for (int i = m_postOrdering.size() - 1; i >= 0; i--) {
-        const BasicBlock *currNode = m_postOrdering[i]; // the current node under investigation
-        const BasicBlock *latch    = nullptr;           // the latching node of the loop
+    // maps each node (by post order index) to whether or not it is within the current loop
+    m_loopNodes.assign(m_postOrdering.size(), false);
+
+    for (int i = static_cast<int>(m_postOrdering.size()) - 1; i >= 0; i--) {
+        const int currNode = m_postOrdering[i]; // the current node under investigation
+        int latch          = -1;                // the latching node of the loop
 
         // If the current node has at least one back edge into it, it is a loop header. If there are
         // numerous back edges into the header, determine which one comes form the proper latching
@@ -345,31 +567,32 @@ void ControlFlowAnalyzer::structLoops()
         //    vi) has a lower ordering than all other suitable candiates
         // If no nodes meet the above criteria, then the current node is not a loop header
 
-        for (const BasicBlock *pred : currNode->getPredecessors()) {
-            if ((getCaseHead(pred) == getCaseHead(currNode)) &&                      // ii)
-                (getLoopHead(pred) == getLoopHead(currNode)) &&                      // iii)
-                (!latch || (getPostOrdering(latch) > getPostOrdering(pred))) &&      // vi)
-                !(getLoopHead(pred) && (getLatchNode(getLoopHead(pred)) == pred)) && // v)
-                isBackEdge(pred, currNode)) {                                        // i)
-                latch = pred;
+        for (int j = 0; j < getNumPredecessors(currNode); j++) {
+            const int pred = getPredecessor(currNode, j);
+            if (pred < 0) {
+                continue;
             }
-        }
 
-        // if a latching node was found for the current node then it is a loop header.
-        if (latch) {
-            // define the map that maps each node to whether or not it is within the current loop
-            bool *loopNodes = new bool[m_postOrdering.size()];
+            const int predLoopHead = m_info[pred].m_loopHead;
 
-            for (unsigned int j = 0; j < m_postOrdering.size(); j++) {
-                loopNodes[j] = false;
+            if ((m_info[pred].m_caseHead == m_info[currNode].m_caseHead) &&   // ii)
+                (predLoopHead == m_info[currNode].m_loopHead) &&              // iii)
+                (latch < 0 ||                                                 // vi)
+                 (m_info[latch].m_postOrderIndex > m_info[pred].m_postOrderIndex)) &&
+                !(predLoopHead >= 0 && (m_info[predLoopHead].m_latchNode == pred)) && // v)
+                isBackEdge(pred, currNode)) {                                         // i)
+                latch = pred;
             }
+        }
 
-            setLatchNode(currNode, latch);
+        // if a latching node was found for the current node then it is a loop header.
+        if (latch >= 0) {
+            m_info[currNode].m_latchNode = latch;
 
             // the latching node may already have been structured as a conditional header. If it is
             // not also the loop header (i.e. the loop is over more than one block) then reset it to
             // be a sequential node otherwise it will be correctly set as a loop header only later
-            if ((latch != currNode) && (getStructType(latch) == StructType::Cond)) {
+            if ((latch != currNode) && (m_info[latch].m_structuringType == StructType::Cond)) {
                 setStructType(latch, StructType::Seq);
             }
 
@@ -377,15 +600,17 @@ void ControlFlowAnalyzer::structLoops()
             setStructType(currNode, StructType::Loop);
 
             // tag the members of this loop
-            tagNodesInLoop(currNode, loopNodes);
+            tagNodesInLoop(currNode);
 
             // calculate the type of this loop
-            determineLoopType(currNode, loopNodes);
+            determineLoopType(currNode);
 
             // calculate the follow node of this loop
-            findLoopFollow(currNode, loopNodes);
+            findLoopFollow(currNode);
 
-            delete[] loopNodes;
+            // only nodes between the header and the latch can have been tagged
+            std::fill(m_loopNodes.begin() + m_info[latch].m_postOrderIndex,
+                      m_loopNodes.begin() + m_info[currNode].m_postOrderIndex, false);
         }
     }
 }
@@ -393,24 +618,26 @@ void ControlFlowAnalyzer::structLoops()
 
 void ControlFlowAnalyzer::checkConds()
 {
-    for (const BasicBlock *currNode : m_postOrdering) {
+    for (const int currNode : m_postOrdering) {
+        const BBStructInfo &info = m_info[currNode];
+
         // consider only conditional headers that have a follow and aren't case headers
-        if (((getStructType(currNode) == StructType::Cond) ||
-             (getStructType(currNode) == StructType::LoopCond)) &&
-            getCondFollow(currNode) && (getCondType(currNode) != CondType::Case)) {
+        if (((info.m_structuringType == StructType::Cond) ||
+             (info.m_structuringType == StructType::LoopCond)) &&
+            info.m_condFollow >= 0 && (getCondType(currNode) != CondType::Case)) {
             // define convenient aliases for the relevant loop and case heads and the out edges
-            const BasicBlock *myLoopHead = (getStructType(currNode) == StructType::LoopCond)
-                                               ? currNode
-                                               : getLoopHead(currNode);
-            const BasicBlock *follLoopHead = getLoopHead(getCondFollow(currNode));
-            const BasicBlock *bbThen       = currNode->getSuccessor(BTHEN);
-            const BasicBlock *bbElse       = currNode->getSuccessor(BELSE);
+            const int myLoopHead = (info.m_structuringType == StructType::LoopCond)
+                                       ? currNode
+                                       : info.m_loopHead;
+            const int follLoopHead = m_info[info.m_condFollow].m_loopHead;
+            const int bbThen       = getSuccessor(currNode, BTHEN);
+            const int bbElse       = getSuccessor(currNode, BELSE);
 
             // analyse whether this is a jump into/outof a loop
             if (myLoopHead != follLoopHead) {
                 // we want to find the branch that the latch node is on for a jump out of a loop
-                if (myLoopHead) {
-                    const BasicBlock *myLoopLatch = getLatchNode(myLoopHead);
+                if (myLoopHead >= 0) {
+                    const int myLoopLatch = m_info[myLoopHead].m_latchNode;
 
                     // does the then branch goto the loop latch?
                     if (isBackEdge(bbThen, myLoopLatch)) {
@@ -424,7 +651,7 @@ void ControlFlowAnalyzer::checkConds()
                     }
                 }
 
-                if ((getUnstructType(currNode) == UnstructType::Structured) && follLoopHead) {
+                if ((getUnstructType(currNode) == UnstructType::Structured) && follLoopHead >= 0) {
                     // find the branch that the loop head is on for a jump into a loop body. If a
                     // branch has already been found, then it will match this one anyway
 
@@ -443,20 +670,19 @@ void ControlFlowAnalyzer::checkConds()
 
             // this is a jump into a case body if either of its children don't have the same same
             // case header as itself
-            if ((getUnstructType(currNode) == UnstructType::Structured) &&
-                ((getCaseHead(currNode) != getCaseHead(bbThen)) ||
-                 (getCaseHead(currNode) != getCaseHead(bbElse)))) {
-                const BasicBlock *myCaseHead   = getCaseHead(currNode);
-                const BasicBlock *thenCaseHead = getCaseHead(bbThen);
-                const BasicBlock *elseCaseHead = getCaseHead(bbElse);
+            const int myCaseHead   = info.m_caseHead;
+            const int thenCaseHead = bbThen >= 0 ? m_info[bbThen].m_caseHead : -1;
+            const int elseCaseHead = bbElse >= 0 ? m_info[bbElse].m_caseHead : -1;
 
+            if ((getUnstructType(currNode) == UnstructType::Structured) &&
+                ((myCaseHead != thenCaseHead) || (myCaseHead != elseCaseHead))) {
                 if ((thenCaseHead == myCaseHead) &&
-                    (!myCaseHead || (elseCaseHead != getCondFollow(myCaseHead)))) {
+                    (myCaseHead < 0 || (elseCaseHead != m_info[myCaseHead].m_condFollow))) {
                     setUnstructType(currNode, UnstructType::JumpIntoCase);
                     setCondType(currNode, CondType::IfElse);
                 }
                 else if ((elseCaseHead == myCaseHead) &&
-                         (!myCaseHead || (thenCaseHead != getCondFollow(myCaseHead)))) {
+                         (myCaseHead < 0 || (thenCaseHead != m_info[myCaseHead].m_condFollow))) {
                     setUnstructType(currNode, UnstructType::JumpIntoCase);
                     setCondType(currNode, CondType::IfThen);
                 }
@@ -466,18 +692,18 @@ void ControlFlowAnalyzer::checkConds()
         // for 2 way conditional headers that don't have a follow (i.e. are the source of a back
         // edge) and haven't been structured as latching nodes, set their follow to be the non-back
         // edge child.
-        if ((getStructType(currNode) == StructType::Cond) && !getCondFollow(currNode) &&
+        if ((info.m_structuringType == StructType::Cond) && info.m_condFollow < 0 &&
             (getCondType(currNode) != CondType::Case) &&
             (getUnstructType(currNode) == UnstructType::Structured)) {
             // latching nodes will already have been reset to Seq structured type
             if (hasBackEdge(currNode)) {
-                if (isBackEdge(currNode, currNode->getSuccessor(BTHEN))) {
+                if (isBackEdge(currNode, getSuccessor(currNode, BTHEN))) {
                     setCondType(currNode, CondType::IfThen);
-                    setCondFollow(currNode, currNode->getSuccessor(BELSE));
+                    m_info[currNode].m_condFollow = getSuccessor(currNode, BELSE);
                 }
                 else {
                     setCondType(currNode, CondType::IfElse);
-                    setCondFollow(currNode, currNode->getSuccessor(BTHEN));
+                    m_info[currNode].m_condFollow = getSuccessor(currNode, BTHEN);
                 }
             }
         }
@@ -487,18 +713,29 @@ void ControlFlowAnalyzer::checkConds()
 
 bool ControlFlowAnalyzer::isBackEdge(const BasicBlock *source, const BasicBlock *dest) const
 {
+    return dest == source || isBackEdge(getIndex(source), getIndex(dest));
+}
+
+
+bool ControlFlowAnalyzer::isBackEdge(int source, int dest) const
+{
+    if (source < 0 || dest < 0) {
+        return false;
+    }
+
     return dest == source || isAncestorOf(dest, source);
 }
 
 
 bool ControlFlowAnalyzer::isCaseOption(const BasicBlock *bb) const
 {
-    if (!getCaseHead(bb)) {
+    const BasicBlock *caseHead = getCaseHead(bb);
+    if (!caseHead) {
         return false;
     }
 
-    for (int i = 0; i < getCaseHead(bb)->getNumSuccessors() - 1; i++) {
-        if (getCaseHead(bb)->getSuccessor(i) == bb) {
+    for (int i = 0; i < caseHead->getNumSuccessors() - 1; i++) {
+        if (caseHead->getSuccessor(i) == bb) {
             return true;
         }
     }
@@ -507,229 +744,260 @@ bool ControlFlowAnalyzer::isCaseOption(const BasicBlock *bb) const
 }
 
 
-bool ControlFlowAnalyzer::isAncestorOf(const BasicBlock *bb, const BasicBlock *other) const
+bool ControlFlowAnalyzer::isAncestorOf(int node, int other) const
 {
-    return (m_info[bb].m_preOrderID < m_info[other].m_preOrderID &&
-            m_info[bb].m_postOrderID > m_info[other].m_postOrderID) ||
-           (m_info[bb].m_revPreOrderID < m_info[other].m_revPreOrderID &&
-            m_info[bb].m_revPostOrderID > m_info[other].m_revPostOrderID);
+    const BBStructInfo &info      = m_info[node];
+    const BBStructInfo &otherInfo = m_info[other];
+
+    return (info.m_preOrderID < otherInfo.m_preOrderID &&
+            info.m_postOrderID > otherInfo.m_postOrderID) ||
+           (info.m_revPreOrderID < otherInfo.m_revPreOrderID &&
+            info.m_revPostOrderID > otherInfo.m_revPostOrderID);
 }
 
 
-void ControlFlowAnalyzer::setLoopStamps(const BasicBlock *bb, int &time,
-                                        std::vector<const BasicBlock *> &postOrder)
+void ControlFlowAnalyzer::setCaseHead(int head, int follow)
 {
-    // timestamp the current node with the current time
-    // and set its traversed flag
-    setTravType(bb, TravType::DFS_LNum);
-    m_info[bb].m_preOrderID = time;
+    // Each stack entry holds a node and the number of successors already visited
+    std::vector<std::pair<int, int>> stack;
 
-    // recurse on unvisited children and set inedges for all children
-    for (const BasicBlock *succ : bb->getSuccessors()) {
-        // set the in edge from this child to its parent (the current node)
-        // (not done here, might be a problem)
-        // outEdges[i]->inEdges.Add(this);
+    auto visit = [this, head, &stack](int node) {
+        assert(m_info[node].m_caseHead < 0);
 
-        // recurse on this child if it hasn't already been visited
-        if (getTravType(succ) != TravType::DFS_LNum) {
-            setLoopStamps(succ, ++time, postOrder);
+        m_info[node].m_travType = TravType::DFS_Case;
+
+        // don't tag this node if it is the case header under investigation
+        if (node != head) {
+            m_info[node].m_caseHead = head;
         }
-    }
 
-    // set the the second loopStamp value
-    m_info[bb].m_postOrderID = ++time;
+        stack.push_back({ node, 0 });
+    };
 
-    // add this node to the ordering structure as well as recording its position within the ordering
-    m_info[bb].m_postOrderIndex = static_cast<int>(postOrder.size());
-    postOrder.push_back(bb);
-}
+    visit(head);
 
+    while (!stack.empty()) {
+        const int node = stack.back().first;
+        const int i    = stack.back().second++;
 
-void ControlFlowAnalyzer::setRevLoopStamps(const BasicBlock *bb, int &time)
-{
-    // timestamp the current node with the current time and set its traversed flag
-    setTravType(bb, TravType::DFS_RNum);
-    m_info[bb].m_revPreOrderID = time;
+        // if this is a nested case header, then it's member nodes
+        // will already have been tagged so skip straight to its follow
+        if (m_nodes[node]->isType(BBType::Nway) && (node != head)) {
+            const int nestedFollow = m_info[node].m_condFollow;
 
-    // recurse on the unvisited children in reverse order
-    for (int i = bb->getNumSuccessors() - 1; i >= 0; i--) {
-        // recurse on this child if it hasn't already been visited
-        if (getTravType(bb->getSuccessor(i)) != TravType::DFS_RNum) {
-            setRevLoopStamps(bb->getSuccessor(i), ++time);
-        }
-    }
+            if (i == 0 && nestedFollow >= 0 &&
+                (m_info[nestedFollow].m_travType != TravType::DFS_Case) &&
+                (nestedFollow != follow)) {
+                visit(nestedFollow);
+            }
+            else if (i > 0) {
+                stack.pop_back();
+            }
 
-    m_info[bb].m_revPostOrderID = ++time;
-}
+            continue;
+        }
 
+        if (i >= getNumSuccessors(node)) {
+            stack.pop_back();
+            continue;
+        }
 
-void ControlFlowAnalyzer::setRevOrder(const BasicBlock *bb, std::vector<const BasicBlock *> &order)
-{
-    // Set this node as having been traversed during the post domimator DFS ordering traversal
-    setTravType(bb, TravType::DFS_PDom);
+        // traverse each child of this node that:
+        //   i) isn't on a back-edge,
+        //  ii) hasn't already been traversed in a case tagging traversal and,
+        // iii) isn't the follow node.
+        const int succ = getSuccessor(node, i);
 
-    // recurse on unvisited children
-    for (const BasicBlock *pred : bb->getPredecessors()) {
-        if (getTravType(pred) != TravType::DFS_PDom) {
-            setRevOrder(pred, order);
+        if (succ >= 0 && !isBackEdge(node, succ) &&
+            (m_info[succ].m_travType != TravType::DFS_Case) && (succ != follow)) {
+            visit(succ);
         }
     }
-
-    // add this node to the ordering structure and record the post dom. order of this node as its
-    // index within this ordering structure
-    m_info[bb].m_revPostOrderIndex = static_cast<int>(order.size());
-    order.push_back(bb);
 }
 
 
-void ControlFlowAnalyzer::setCaseHead(const BasicBlock *bb, const BasicBlock *head,
-                                      const BasicBlock *follow)
+void ControlFlowAnalyzer::setTravType(const BasicBlock *bb, TravType type)
 {
-    assert(!getCaseHead(bb));
-
-    setTravType(bb, TravType::DFS_Case);
+    const int node = getIndex(bb);
+    assert(node >= 0);
 
-    // don't tag this node if it is the case header under investigation
-    if (bb != head) {
-        m_info[bb].m_caseHead = head;
+    if (node >= 0) {
+        m_info[node].m_travType = type;
     }
+}
 
-    // if this is a nested case header, then it's member nodes
-    // will already have been tagged so skip straight to its follow
-    if (bb->isType(BBType::Nway) && (bb != head)) {
-        if (getCondFollow(bb) && (getTravType(getCondFollow(bb)) != TravType::DFS_Case) &&
-            (getCondFollow(bb) != follow)) {
-            setCaseHead(bb, head, follow);
-        }
-    }
-    else {
-        // traverse each child of this node that:
-        //   i) isn't on a back-edge,
-        //  ii) hasn't already been traversed in a case tagging traversal and,
-        // iii) isn't the follow node.
-        for (BasicBlock *succ : bb->getSuccessors()) {
-            if (!isBackEdge(bb, succ) && (getTravType(succ) != TravType::DFS_Case) &&
-                (succ != follow)) {
-                setCaseHead(succ, head, follow);
-            }
-        }
+
+void ControlFlowAnalyzer::setStructType(const BasicBlock *bb, StructType structType)
+{
+    const int node = getIndex(bb);
+    assert(node >= 0);
+
+    if (node >= 0) {
+        setStructType(node, structType);
     }
 }
 
 
-void ControlFlowAnalyzer::setStructType(const BasicBlock *bb, StructType structType)
+void ControlFlowAnalyzer::setStructType(int node, StructType structType)
 {
+    BBStructInfo &info = m_info[node];
+
     // if this is a conditional header, determine exactly which type of conditional header it is
     // (i.e. switch, if-then, if-then-else etc.)
     if (structType == StructType::Cond) {
-        if (bb->isType(BBType::Nway)) {
-            m_info[bb].m_conditionHeaderType = CondType::Case;
+        if (m_nodes[node]->isType(BBType::Nway)) {
+            info.m_conditionHeaderType = CondType::Case;
         }
-        else if (bb->getSuccessor(BELSE) == getCondFollow(bb)) {
-            m_info[bb].m_conditionHeaderType = CondType::IfThen;
+        else if (getSuccessor(node, BELSE) == info.m_condFollow) {
+            info.m_conditionHeaderType = CondType::IfThen;
         }
-        else if (bb->getSuccessor(BTHEN) == getCondFollow(bb)) {
-            m_info[bb].m_conditionHeaderType = CondType::IfElse;
+        else if (getSuccessor(node, BTHEN) == info.m_condFollow) {
+            info.m_conditionHeaderType = CondType::IfElse;
         }
         else {
-            m_info[bb].m_conditionHeaderType = CondType::IfThenElse;
+            info.m_conditionHeaderType = CondType::IfThenElse;
         }
     }
 
-    m_info[bb].m_structuringType = structType;
+    info.m_structuringType = structType;
 }
 
 
-void ControlFlowAnalyzer::setUnstructType(const BasicBlock *bb, UnstructType unstructType)
+void ControlFlowAnalyzer::setUnstructType(int node, UnstructType unstructType)
 {
-    assert((m_info[bb].m_structuringType == StructType::Cond ||
-            m_info[bb].m_structuringType == StructType::LoopCond) &&
-           m_info[bb].m_conditionHeaderType != CondType::Case);
-    m_info[bb].m_unstructuredType = unstructType;
+    assert((m_info[node].m_structuringType == StructType::Cond ||
+            m_info[node].m_structuringType == StructType::LoopCond) &&
+           m_info[node].m_conditionHeaderType != CondType::Case);
+    m_info[node].m_unstructuredType = unstructType;
 }
 
 
 UnstructType ControlFlowAnalyzer::getUnstructType(const BasicBlock *bb) const
 {
-    assert((m_info[bb].m_structuringType == StructType::Cond ||
-            m_info[bb].m_structuringType == StructType::LoopCond));
+    const BBStructInfo &info = getInfo(bb);
+
+    assert((info.m_structuringType == StructType::Cond ||
+            info.m_structuringType == StructType::LoopCond));
     // fails when cenerating code for switches; not sure if actually needed TODO
     // assert(m_conditionHeaderType != CondType::Case);
 
-    return m_info[bb].m_unstructuredType;
+    return info.m_unstructuredType;
 }
 
 
-void ControlFlowAnalyzer::setLoopType(const BasicBlock *bb, LoopType l)
+UnstructType ControlFlowAnalyzer::getUnstructType(int node) const
 {
-    assert(getStructType(bb) == StructType::Loop || getStructType(bb) == StructType::LoopCond);
-    m_info[bb].m_loopHeaderType = l;
+    assert((m_info[node].m_structuringType == StructType::Cond ||
+            m_info[node].m_structuringType == StructType::LoopCond));
+
+    return m_info[node].m_unstructuredType;
+}
+
+
+void ControlFlowAnalyzer::setLoopType(int node, LoopType l)
+{
+    BBStructInfo &info = m_info[node];
+
+    assert(info.m_structuringType == StructType::Loop ||
+           info.m_structuringType == StructType::LoopCond);
+    info.m_loopHeaderType = l;
 
     // set the structured class (back to) just Loop if the loop type is PreTested OR it's PostTested
     // and is a single block loop
-    if ((m_info[bb].m_loopHeaderType == LoopType::PreTested) ||
-        ((m_info[bb].m_loopHeaderType == LoopType::PostTested) && (bb == getLatchNode(bb)))) {
-        setStructType(bb, StructType::Loop);
+    if ((info.m_loopHeaderType == LoopType::PreTested) ||
+        ((info.m_loopHeaderType == LoopType::PostTested) && (node == info.m_latchNode))) {
+        setStructType(node, StructType::Loop);
     }
 }
 
 
 LoopType ControlFlowAnalyzer::getLoopType(const BasicBlock *bb) const
 {
-    assert(getStructType(bb) == StructType::Loop || getStructType(bb) == StructType::LoopCond);
-    return m_info[bb].m_loopHeaderType;
+    const BBStructInfo &info = getInfo(bb);
+
+    assert(info.m_structuringType == StructType::Loop ||
+           info.m_structuringType == StructType::LoopCond);
+    return info.m_loopHeaderType;
+}
+
+
+LoopType ControlFlowAnalyzer::getLoopType(int node) const
+{
+    assert(m_info[node].m_structuringType == StructType::Loop ||
+           m_info[node].m_structuringType == StructType::LoopCond);
+    return m_info[node].m_loopHeaderType;
 }
 
 
-void ControlFlowAnalyzer::setCondType(const BasicBlock *bb, CondType condType)
+void ControlFlowAnalyzer::setCondType(int node, CondType condType)
 {
-    assert(getStructType(bb) == StructType::Cond || getStructType(bb) == StructType::LoopCond);
-    m_info[bb].m_conditionHeaderType = condType;
+    assert(m_info[node].m_structuringType == StructType::Cond ||
+           m_info[node].m_structuringType == StructType::LoopCond);
+    m_info[node].m_conditionHeaderType = condType;
 }
 
 
 CondType ControlFlowAnalyzer::getCondType(const BasicBlock *bb) const
 {
-    assert(getStructType(bb) == StructType::Cond || getStructType(bb) == StructType::LoopCond);
-    return m_info[bb].m_conditionHeaderType;
+    const BBStructInfo &info = getInfo(bb);
+
+    assert(info.m_structuringType == StructType::Cond ||
+           info.m_structuringType == StructType::LoopCond);
+    return info.m_conditionHeaderType;
+}
+
+
+CondType ControlFlowAnalyzer::getCondType(int node) const
+{
+    assert(m_info[node].m_structuringType == StructType::Cond ||
+           m_info[node].m_structuringType == StructType::LoopCond);
+    return m_info[node].m_conditionHeaderType;
 }
 
 
-bool ControlFlowAnalyzer::isBBInLoop(const BasicBlock *bb, const BasicBlock *header,
-                                     const BasicBlock *latch) const
+bool ControlFlowAnalyzer::isBBInLoop(int node, int header, int latch) const
 {
-    assert(getLatchNode(header) == latch);
-    assert(header == latch || ((m_info[header].m_preOrderID > m_info[latch].m_preOrderID &&
-                                m_info[latch].m_postOrderID > m_info[header].m_postOrderID) ||
-                               (m_info[header].m_preOrderID < m_info[latch].m_preOrderID &&
-                                m_info[latch].m_postOrderID < m_info[header].m_postOrderID)));
+    const BBStructInfo &info       = m_info[node];
+    const BBStructInfo &headerInfo = m_info[header];
+    const BBStructInfo &latchInfo  = m_info[latch];
+
+    assert(headerInfo.m_latchNode == latch);
+    assert(header == latch || ((headerInfo.m_preOrderID > latchInfo.m_preOrderID &&
+                                latchInfo.m_postOrderID > headerInfo.m_postOrderID) ||
+                               (headerInfo.m_preOrderID < latchInfo.m_preOrderID &&
+                                latchInfo.m_postOrderID < headerInfo.m_postOrderID)));
 
     // this node is in the loop if it is the latch node OR
     // this node is within the header and the latch is within this when using the forward loop
     // stamps OR this node is within the header and the latch is within this when using the reverse
     // loop stamps
-    return bb == latch ||
-           (m_info[header].m_preOrderID < m_info[bb].m_preOrderID &&
-            m_info[bb].m_postOrderID < m_info[header].m_postOrderID &&
-            m_info[bb].m_preOrderID < m_info[latch].m_preOrderID &&
-            m_info[latch].m_postOrderID < m_info[bb].m_postOrderID) ||
-           (m_info[header].m_revPreOrderID < m_info[bb].m_revPreOrderID &&
-            m_info[bb].m_revPostOrderID < m_info[header].m_revPostOrderID &&
-            m_info[bb].m_revPreOrderID < m_info[latch].m_revPreOrderID &&
-            m_info[latch].m_revPostOrderID < m_info[bb].m_revPostOrderID);
+    return node == latch ||
+           (headerInfo.m_preOrderID < info.m_preOrderID &&
+            info.m_postOrderID < headerInfo.m_postOrderID &&
+            info.m_preOrderID < latchInfo.m_preOrderID &&
+            latchInfo.m_postOrderID < info.m_postOrderID) ||
+           (headerInfo.m_revPreOrderID < info.m_revPreOrderID &&
+            info.m_revPostOrderID < headerInfo.m_revPostOrderID &&
+            info.m_revPreOrderID < latchInfo.m_revPreOrderID &&
+            latchInfo.m_revPostOrderID < info.m_revPostOrderID);
 }
 
 
-bool ControlFlowAnalyzer::hasBackEdge(const BasicBlock *bb) const
+bool ControlFlowAnalyzer::hasBackEdge(int node) const
 {
-    return std::any_of(bb->getSuccessors().begin(), bb->getSuccessors().end(),
-                       [this, bb](const BasicBlock *succ) { return isBackEdge(bb, succ); });
+    for (int i = 0; i < getNumSuccessors(node); i++) {
+        if (isBackEdge(node, getSuccessor(node, i))) {
+            return true;
+        }
+    }
+
+    return false;
 }
 
 
 void ControlFlowAnalyzer::unTraverse()
 {
-    for (auto &elem : m_info) {
-        elem.second.m_travType = TravType::Untraversed;
+    for (BBStructInfo &info : m_info) {
+        info.m_travType = TravType::Untraversed;
     }
 }
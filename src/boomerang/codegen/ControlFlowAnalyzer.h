@@ -10,6 +10,9 @@
 #pragma once
 
 
+#include "boomerang/core/BoomerangAPI.h"
+
+#include <cstdint>
 #include <unordered_map>
 #include <vector>
 
@@ -88,6 +91,7 @@ enum class SBBType : uint8_t
 
 
 /// Holds all information about control Flow Structure.
+/// Other nodes are referenced by their index in the ControlFlowAnalyzer, or -1 for no node.
 struct BBStructInfo
 {
     /// Control flow analysis stuff, lifted from Doug Simon's honours thesis.
@@ -118,20 +122,25 @@ struct BBStructInfo
     LoopType m_loopHeaderType      = LoopType::Invalid; ///< the loop type of a loop header
 
     // analysis information
-    const BasicBlock *m_immPDom    = nullptr; ///< immediate post dominator
-    const BasicBlock *m_loopHead   = nullptr; ///< head of the most nested enclosing loop
-    const BasicBlock *m_caseHead   = nullptr; ///< head of the most nested enclosing case
-    const BasicBlock *m_condFollow = nullptr; ///< follow of a conditional header
-    const BasicBlock *m_loopFollow = nullptr; ///< follow of a loop header
-    const BasicBlock *m_latchNode  = nullptr; ///< latching node of a loop header
+    int m_immPDom    = -1; ///< immediate post dominator
+    int m_loopHead   = -1; ///< head of the most nested enclosing loop
+    int m_caseHead   = -1; ///< head of the most nested enclosing case
+    int m_condFollow = -1; ///< follow of a conditional header
+    int m_loopFollow = -1; ///< follow of a loop header
+    int m_latchNode  = -1; ///< latching node of a loop header
 };
 
 
 /**
  * Control flow analysis stuff, lifted from Doug Simon's honours thesis.
  * Analyzes the control flow of a CFG and tags loop constructs etc.
+ *
+ * All nodes of the CFG are numbered when structuring starts. Structuring information
+ * and the edges of the CFG are stored in flat arrays indexed by node number,
+ * and all traversals use an explicit stack, so even very large CFGs can be structured
+ * quickly and without running out of stack space.
  */
-class ControlFlowAnalyzer
+class BOOMERANG_API ControlFlowAnalyzer
 {
 public:
     ControlFlowAnalyzer();
@@ -143,15 +152,92 @@ public:
     /// establish if \p source has a back edge to \p dest
     bool isBackEdge(const BasicBlock *source, const BasicBlock *dest) const;
 
+    bool isCaseOption(const BasicBlock *bb) const;
+
+    inline bool isLatchNode(const BasicBlock *bb) const
+    {
+        const BasicBlock *loopHead = getLoopHead(bb);
+        if (!loopHead) {
+            return false;
+        }
+
+        return getLatchNode(loopHead) == bb;
+    }
+
+    const BasicBlock *getLatchNode(const BasicBlock *bb) const
+    {
+        return getNode(getInfo(bb).m_latchNode);
+    }
+
+    const BasicBlock *getLoopHead(const BasicBlock *bb) const
+    {
+        return getNode(getInfo(bb).m_loopHead);
+    }
+
+    const BasicBlock *getLoopFollow(const BasicBlock *bb) const
+    {
+        return getNode(getInfo(bb).m_loopFollow);
+    }
+
+    const BasicBlock *getCondFollow(const BasicBlock *bb) const
+    {
+        return getNode(getInfo(bb).m_condFollow);
+    }
+
+    const BasicBlock *getCaseHead(const BasicBlock *bb) const
+    {
+        return getNode(getInfo(bb).m_caseHead);
+    }
+
+    const BasicBlock *getImmPDom(const BasicBlock *bb) const
+    {
+        return getNode(getInfo(bb).m_immPDom);
+    }
+
+    int getPostOrdering(const BasicBlock *bb) const { return getInfo(bb).m_postOrderIndex; }
+    int getRevOrd(const BasicBlock *bb) const { return getInfo(bb).m_revPostOrderIndex; }
+
+    TravType getTravType(const BasicBlock *bb) const { return getInfo(bb).m_travType; }
+    StructType getStructType(const BasicBlock *bb) const { return getInfo(bb).m_structuringType; }
+    CondType getCondType(const BasicBlock *bb) const;
+    UnstructType getUnstructType(const BasicBlock *bb) const;
+    LoopType getLoopType(const BasicBlock *bb) const;
+
+    void setTravType(const BasicBlock *bb, TravType type);
+    void setStructType(const BasicBlock *bb, StructType s);
+
 private:
+    /// Number the nodes of the CFG and set up the edge arrays.
+    void buildNodeIndex();
+
+    /// \returns the index of \p bb, or -1 if \p bb is not part of the structured CFG.
+    int getIndex(const BasicBlock *bb) const;
+    const BasicBlock *getNode(int node) const { return node >= 0 ? m_nodes[node] : nullptr; }
+
+    /// \returns the structuring information of \p bb, or default information
+    /// if \p bb is not part of the structured CFG.
+    const BBStructInfo &getInfo(const BasicBlock *bb) const;
+
+    int getNumSuccessors(int node) const { return m_succStart[node + 1] - m_succStart[node]; }
+    int getNumPredecessors(int node) const { return m_predStart[node + 1] - m_predStart[node]; }
+
+    /// \returns the index of the i-th successor of \p node, or -1 if it does not exist
+    int getSuccessor(int node, int i) const;
+    int getPredecessor(int node, int i) const { return m_preds[m_predStart[node] + i]; }
+
     void setTimeStamps();
 
+    /// Depth-first traversals of the CFG, numbering the nodes in pre- and post-order.
+    void setLoopStamps(int entry);
+    void setRevLoopStamps(int entry);
+    void setRevOrder(int retNode);
+
     /**
      * Finds the immediate post dominator of each node in the CFG.
      *
-     * Adapted version of the dominators algorithm by Hecht and Ullman;
-     * finds immediate post dominators only.
-     * \note graph should be reducible
+     * Post dominators of nodes that reach the return node are computed with the iterative
+     * algorithm by Cooper, Harvey and Kennedy on the reverse CFG. The remaining nodes
+     * and loops are fixed up like in the dominators algorithm by Hecht and Ullman.
      */
     void updateImmedPDom();
 
@@ -171,125 +257,63 @@ private:
 
     /// Finds the common post dominator of the current immediate post dominator and its successor's
     /// immediate post dominator
-    const BasicBlock *commonPDom(const BasicBlock *curImmPDom, const BasicBlock *succImmPDom);
+    int commonPDom(int curImmPDom, int succImmPDom) const;
 
     /// \pre  The loop induced by (head,latch) has already had all its member nodes tagged
     /// \post The type of loop has been deduced
-    void determineLoopType(const BasicBlock *header, bool *&loopNodes);
+    void determineLoopType(int header);
 
     /// \pre  The loop headed by header has been induced and all it's member nodes have been tagged
     /// \post The follow of the loop has been determined.
-    void findLoopFollow(const BasicBlock *header, bool *&loopNodes);
+    void findLoopFollow(int header);
 
     /// \pre header has been detected as a loop header and has the details of the
     ///        latching node
     /// \post the nodes within the loop have been tagged
-    void tagNodesInLoop(const BasicBlock *header, bool *&loopNodes);
+    void tagNodesInLoop(int header);
 
-public:
-    void setLoopStamps(const BasicBlock *bb, int &time, std::vector<const BasicBlock *> &order);
-    void setRevLoopStamps(const BasicBlock *bb, int &time);
-    void setRevOrder(const BasicBlock *bb, std::vector<const BasicBlock *> &order);
+    /// Tag all nodes of the case statement headed by \p head with \p head.
+    void setCaseHead(int head, int follow);
 
-    void setLoopHead(const BasicBlock *bb, const BasicBlock *head) { m_info[bb].m_loopHead = head; }
-    void setLatchNode(const BasicBlock *bb, const BasicBlock *latch)
-    {
-        m_info[bb].m_latchNode = latch;
-    }
+    bool isBackEdge(int source, int dest) const;
 
-    void setCaseHead(const BasicBlock *bb, const BasicBlock *head, const BasicBlock *follow);
+    /// establish if this node has any back edges leading FROM it
+    bool hasBackEdge(int node) const;
 
-    void setUnstructType(const BasicBlock *bb, UnstructType unstructType);
-    void setLoopType(const BasicBlock *bb, LoopType loopType);
-    void setCondType(const BasicBlock *bb, CondType condType);
+    /// establish if \p node is an ancestor of \p other
+    bool isAncestorOf(int node, int other) const;
+    bool isBBInLoop(int node, int header, int latch) const;
 
-    void setLoopFollow(const BasicBlock *bb, const BasicBlock *follow)
-    {
-        m_info[bb].m_loopFollow = follow;
-    }
-
-    void setCondFollow(const BasicBlock *bb, const BasicBlock *follow)
-    {
-        m_info[bb].m_condFollow = follow;
-    }
-
-    /// establish if this bb has any back edges leading FROM it
-    bool hasBackEdge(const BasicBlock *bb) const;
+    void setStructType(int node, StructType structType);
+    void setUnstructType(int node, UnstructType unstructType);
+    void setLoopType(int node, LoopType loopType);
+    void setCondType(int node, CondType condType);
 
-    /// establish if this bb is an ancestor of another BB
-    bool isAncestorOf(const BasicBlock *bb, const BasicBlock *other) const;
-    bool isBBInLoop(const BasicBlock *bb, const BasicBlock *header, const BasicBlock *latch) const;
-
-    int getPostOrdering(const BasicBlock *bb) const { return m_info[bb].m_postOrderIndex; }
-    int getRevOrd(const BasicBlock *bb) const { return m_info[bb].m_revPostOrderIndex; }
-
-    const BasicBlock *getImmPDom(const BasicBlock *bb) const { return m_info[bb].m_immPDom; }
-
-    void setImmPDom(const BasicBlock *bb, const BasicBlock *immPDom)
-    {
-        m_info[bb].m_immPDom = immPDom;
-    }
+    CondType getCondType(int node) const;
+    UnstructType getUnstructType(int node) const;
+    LoopType getLoopType(int node) const;
 
     void unTraverse();
 
-public:
-    inline bool isLatchNode(const BasicBlock *bb) const
-    {
-        const BasicBlock *loopHead = getLoopHead(bb);
-        if (!loopHead) {
-            return false;
-        }
-
-        return getLatchNode(loopHead) == bb;
-    }
-
-    inline const BasicBlock *getLatchNode(const BasicBlock *bb) const
-    {
-        return m_info[bb].m_latchNode;
-    }
-
-    inline const BasicBlock *getLoopHead(const BasicBlock *bb) const
-    {
-        return m_info[bb].m_loopHead;
-    }
-
-    inline const BasicBlock *getLoopFollow(const BasicBlock *bb) const
-    {
-        return m_info[bb].m_loopFollow;
-    }
-
-    inline const BasicBlock *getCondFollow(const BasicBlock *bb) const
-    {
-        return m_info[bb].m_condFollow;
-    }
-
-    inline const BasicBlock *getCaseHead(const BasicBlock *bb) const
-    {
-        return m_info[bb].m_caseHead;
-    }
+private:
+    ProcCFG *m_cfg = nullptr;
 
-    TravType getTravType(const BasicBlock *bb) const { return m_info[bb].m_travType; }
-    StructType getStructType(const BasicBlock *bb) const { return m_info[bb].m_structuringType; }
-    CondType getCondType(const BasicBlock *bb) const;
-    UnstructType getUnstructType(const BasicBlock *bb) const;
-    LoopType getLoopType(const BasicBlock *bb) const;
+    std::vector<const BasicBlock *> m_nodes;              ///< node index -> BB
+    std::unordered_map<const BasicBlock *, int> m_indices; ///< BB -> node index
 
-    void setTravType(const BasicBlock *bb, TravType type) { m_info[bb].m_travType = type; }
-    void setStructType(const BasicBlock *bb, StructType s);
+    /// Successors and predecessors of all nodes. The edges of node i
+    /// are stored at [start[i], start[i+1]).
+    std::vector<int> m_succs, m_succStart;
+    std::vector<int> m_preds, m_predStart;
 
-    bool isCaseOption(const BasicBlock *bb) const;
+    std::vector<BBStructInfo> m_info; ///< structuring information, by node index
 
-private:
-    ProcCFG *m_cfg = nullptr;
+    /// Ordering of nodes for control flow structuring
+    std::vector<int> m_postOrdering;
 
-    /// Ordering of BBs for control flow structuring
-    std::vector<const BasicBlock *> m_postOrdering;
+    /// Ordering of nodes for control flow structuring
+    std::vector<int> m_revPostOrdering;
 
-    /// Ordering of BBs for control flow structuring
-    std::vector<const BasicBlock *> m_revPostOrdering;
-
-private:
-    /// mutable to allow using the map in const methods (might create entries).
-    /// DO NOT change BBStructInfo in const methods!
-    mutable std::unordered_map<const BasicBlock *, BBStructInfo> m_info;
+    /// Loop membership of nodes by post order index, for the loop under investigation
+    std::vector<bool> m_loopNodes;
 };
@@ -14,7 +14,11 @@
 #include "boomerang/core/Watcher.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/db/binary/BinarySymbolTable.h"
+#include "boomerang/db/binary/FunctionPatternDB.h"
+#include "boomerang/db/module/Module.h"
+#include "boomerang/db/proc/UserProc.h"
 #include "boomerang/decomp/ProgDecompiler.h"
+#include "boomerang/frontend/FunctionStartFinder.h"
 #include "boomerang/frontend/mips/MIPSFrontEnd.h"
 #include "boomerang/frontend/pentium/PentiumFrontEnd.h"
 #include "boomerang/frontend/ppc/PPCFrontEnd.h"
@@ -24,6 +28,7 @@
 #include "boomerang/util/CallGraphDotWriter.h"
 #include "boomerang/util/ProgSymbolWriter.h"
 #include "boomerang/util/log/Log.h"
+#include "boomerang/util/log/Trace.h"
 
 
 Project::Project()
@@ -117,6 +122,7 @@ bool Project::loadBinaryFile(const QString &filePath)
     }
 
     m_loadedBinary.reset(new BinaryFile(srcFile.readAll(), loader));
+    loader->setThreading(getSettings()->numThreads, getSettings()->loaderMinEntriesPerThread);
 
     if (loader->loadFromFile(m_loadedBinary.get()) == false) {
         return false;
@@ -150,6 +156,10 @@ bool Project::isBinaryLoaded() const
 
 void Project::unloadBinaryFile()
 {
+    // pending events refer to functions of the unloaded program
+    m_pendingEvents.clear();
+    m_progress = DecompileProgress();
+
     m_prog.reset();
     m_loadedBinary.reset();
 }
@@ -157,6 +167,8 @@ void Project::unloadBinaryFile()
 
 bool Project::decodeBinaryFile()
 {
+    TRACE_SPAN("Decode binary file");
+
     if (!getProg()) {
         LOG_ERROR("Cannot decode binary file: No binary file is loaded.");
         return false;
@@ -166,7 +178,9 @@ bool Project::decodeBinaryFile()
         return false;
     }
 
-    loadSymbols();
+    if (!loadSymbols()) {
+        return false;
+    }
 
     if (!getSettings()->m_entryPoints.empty()) { // decode only specified procs
         // decode entry points from -e (and -E) switch(es)
@@ -197,6 +211,8 @@ bool Project::decodeBinaryFile()
 
 bool Project::decompileBinaryFile()
 {
+    TRACE_SPAN("Decompile binary file");
+
     if (!m_prog) {
         LOG_ERROR("Cannot decompile binary file: No binary file is loaded.");
         return false;
@@ -209,12 +225,15 @@ bool Project::decompileBinaryFile()
     ProgDecompiler dcomp(m_prog.get());
     dcomp.decompile();
 
+    alertDecompilationEnd();
     return true;
 }
 
 
 bool Project::generateCode(Module *module)
 {
+    TRACE_SPAN("Generate code");
+
     if (!m_prog) {
         LOG_ERROR("Cannot generate code: No binary file is loaded.");
         return false;
@@ -226,6 +245,8 @@ bool Project::generateCode(Module *module)
 
     LOG_MSG("Generating code...");
     m_codeGenerator->generateCode(getProg(), module);
+
+    flushWatcherEvents();
     return true;
 }
 
@@ -238,6 +259,9 @@ Prog *Project::createProg(BinaryFile *file, const QString &name)
     }
 
     // unload old Prog before creating a new one
+    m_pendingEvents.clear();
+    m_progress = DecompileProgress();
+
     m_fe.reset();
     m_prog.reset();
 
@@ -270,7 +294,7 @@ IFrontEnd *Project::createFrontEnd()
 }
 
 
-void Project::loadSymbols()
+bool Project::loadSymbols()
 {
     // Add symbols from -s switch(es)
     for (const std::pair<Address, QString> &elem : getSettings()->m_symbolMap) {
@@ -283,6 +307,60 @@ void Project::loadSymbols()
         LOG_MSG("Reading symbol file '%1'", sf);
         m_prog->addSymbolsFromSymbolFile(sf);
     }
+
+    return identifyLibraryFunctions();
+}
+
+
+bool Project::identifyLibraryFunctions()
+{
+    std::vector<QString> patternFiles = getSettings()->m_patternFiles;
+
+    // default patterns are stored next to the library catalog, e.g. signatures/pentium.pat
+    const QString libCatalogName = Prog::getLibraryCatalogName(m_prog->getMachine());
+    if (!libCatalogName.isEmpty()) {
+        const QString defaultFile = getSettings()->getDataDirectory().absoluteFilePath(
+            QString(libCatalogName).replace(".hs", ".pat"));
+
+        if (QFile::exists(defaultFile)) {
+            patternFiles.push_back(defaultFile);
+        }
+    }
+
+    if (patternFiles.empty()) {
+        return true;
+    }
+
+    FunctionPatternDB patternDB;
+    for (const QString &patternFile : patternFiles) {
+        LOG_MSG("Reading pattern file '%1'", patternFile);
+
+        if (!patternDB.readPatternFile(patternFile)) {
+            LOG_ERROR("Cannot identify library functions: Reading pattern file '%1' failed",
+                      patternFile);
+            return false;
+        }
+    }
+
+    // Nothing is decoded yet, so patterns are only matched at the entry points
+    // and at the targets of direct calls found by a linear sweep (x86 only).
+    std::set<Address> functionStarts = { m_loadedBinary->getEntryPoint(),
+                                         m_loadedBinary->getMainEntryPoint() };
+
+    FunctionStartFinder finder(m_loadedBinary->getImage(), m_loadedBinary->getMachine());
+    for (const FunctionStartFinder::Candidate &candidate :
+         finder.findCandidates(0, getSettings()->numThreads)) {
+        if (candidate.numCalls > 0) {
+            functionStarts.insert(candidate.addr);
+        }
+    }
+
+    functionStarts.erase(Address::INVALID);
+
+    const int numIdentified = patternDB.identifyFunctions(
+        m_loadedBinary->getImage(), m_loadedBinary->getSymbols(), functionStarts);
+    LOG_MSG("Identified %1 statically linked library functions", numIdentified);
+    return true;
 }
 
 
@@ -312,6 +390,14 @@ bool Project::decodeAll()
         }
     }
 
+    if (getSettings()->linearSweep) {
+        LOG_MSG("Looking for functions not reachable from the entry points...");
+        if (!m_fe->decodeLinearSweep()) {
+            LOG_ERROR("Aborting load due to decode failure");
+            return false;
+        }
+    }
+
     return true;
 }
 
@@ -362,8 +448,96 @@ void Project::addWatcher(IWatcher *watcher)
 }
 
 
+void Project::flushWatcherEvents()
+{
+    bool hasCoalescedWatchers = false;
+    for (IWatcher *watcher : m_watchers) {
+        hasCoalescedWatchers |= !watcher->wantsAllEvents();
+    }
+
+    m_progressTimer.start();
+
+    if (!hasCoalescedWatchers) {
+        m_pendingEvents.clear();
+        return;
+    }
+
+    // watchers might add new events
+    std::vector<std::function<void(IWatcher *)>> events;
+    std::swap(events, m_pendingEvents);
+
+    for (IWatcher *watcher : m_watchers) {
+        if (!watcher->wantsAllEvents()) {
+            for (const auto &event : events) {
+                event(watcher);
+            }
+
+            watcher->onProgress(m_progress);
+        }
+    }
+}
+
+
+void Project::postEvent(const std::function<void(IWatcher *)> &event)
+{
+    bool hasCoalescedWatchers = false;
+
+    for (IWatcher *watcher : m_watchers) {
+        if (watcher->wantsAllEvents()) {
+            event(watcher);
+        }
+        else {
+            hasCoalescedWatchers = true;
+        }
+    }
+
+    if (hasCoalescedWatchers) {
+        m_pendingEvents.push_back(event);
+        updateProgress();
+    }
+}
+
+
+void Project::updateProgress()
+{
+    /// Minimum time between two progress updates, in ms
+    static const qint64 PROGRESS_INTERVAL = 100;
+
+    if (!m_progressTimer.isValid() || m_progressTimer.hasExpired(PROGRESS_INTERVAL)) {
+        flushWatcherEvents();
+    }
+}
+
+
+void Project::countProcStatus(ProcStatus status, int delta)
+{
+    auto it = m_progress.numProcsByStatus.find(status);
+
+    if (it == m_progress.numProcsByStatus.end()) {
+        if (delta > 0) {
+            m_progress.numProcsByStatus[status] = delta;
+        }
+    }
+    else if (it->second + delta > 0) {
+        it->second += delta;
+    }
+    else {
+        m_progress.numProcsByStatus.erase(it);
+    }
+}
+
+
 void Project::alertDecompileDebugPoint(UserProc *p, const char *description)
 {
+    // A watcher that stops at the debug point must see all previous events first.
+    // Debug points are raised after every pass, so do not flush otherwise.
+    for (IWatcher *watcher : m_watchers) {
+        if (!watcher->wantsAllEvents() && watcher->stopsAtDebugPoint(p)) {
+            flushWatcherEvents();
+            break;
+        }
+    }
+
     for (IWatcher *elem : m_watchers) {
         elem->onDecompileDebugPoint(p, description);
     }
@@ -372,14 +546,26 @@ void Project::alertDecompileDebugPoint(UserProc *p, const char *description)
 
 void Project::alertFunctionCreated(Function *function)
 {
-    for (IWatcher *it : m_watchers) {
-        it->onFunctionCreated(function);
+    if (!function->isLib()) {
+        countProcStatus(static_cast<UserProc *>(function)->getStatus(), +1);
     }
+
+    postEvent([function](IWatcher *watcher) {
+        watcher->onFunctionCreated(function);
+    });
 }
 
 
 void Project::alertFunctionRemoved(Function *function)
 {
+    // Pending events might refer to the function, so they must be delivered
+    // before the function is deleted.
+    flushWatcherEvents();
+
+    if (!function->isLib()) {
+        countProcStatus(static_cast<UserProc *>(function)->getStatus(), -1);
+    }
+
     for (IWatcher *it : m_watchers) {
         it->onFunctionRemoved(function);
     }
@@ -388,38 +574,47 @@ void Project::alertFunctionRemoved(Function *function)
 
 void Project::alertSignatureUpdated(Function *function)
 {
-    for (IWatcher *it : m_watchers) {
-        it->onSignatureUpdated(function);
-    }
+    postEvent([function](IWatcher *watcher) {
+        watcher->onSignatureUpdated(function);
+    });
 }
 
 
 void Project::alertInstructionDecoded(Address pc, int numBytes)
 {
+    m_progress.numInstructionsDecoded++;
+    m_progress.numBytesDecoded += numBytes;
+
     for (IWatcher *it : m_watchers) {
-        it->onInstructionDecoded(pc, numBytes);
+        if (it->wantsAllEvents()) {
+            it->onInstructionDecoded(pc, numBytes);
+        }
     }
+
+    updateProgress();
 }
 
 
 void Project::alertBadDecode(Address pc)
 {
-    for (IWatcher *it : m_watchers) {
-        it->onBadDecode(pc);
-    }
+    postEvent([pc](IWatcher *watcher) {
+        watcher->onBadDecode(pc);
+    });
 }
 
 
 void Project::alertFunctionDecoded(Function *p, Address pc, Address last, int numBytes)
 {
-    for (IWatcher *it : m_watchers) {
-        it->onFunctionDecoded(p, pc, last, numBytes);
-    }
+    postEvent([p, pc, last, numBytes](IWatcher *watcher) {
+        watcher->onFunctionDecoded(p, pc, last, numBytes);
+    });
 }
 
 
 void Project::alertStartDecode(Address start, int numBytes)
 {
+    flushWatcherEvents();
+
     for (IWatcher *it : m_watchers) {
         it->onStartDecode(start, numBytes);
     }
@@ -428,6 +623,8 @@ void Project::alertStartDecode(Address start, int numBytes)
 
 void Project::alertEndDecode()
 {
+    flushWatcherEvents();
+
     for (IWatcher *it : m_watchers) {
         it->onEndDecode();
     }
@@ -436,46 +633,55 @@ void Project::alertEndDecode()
 
 void Project::alertStartDecompile(UserProc *proc)
 {
-    for (IWatcher *it : m_watchers) {
-        it->onStartDecompile(proc);
-    }
+    postEvent([proc](IWatcher *watcher) {
+        watcher->onStartDecompile(proc);
+    });
 }
 
 
-void Project::alertProcStatusChanged(UserProc *proc)
+void Project::alertProcStatusChanged(UserProc *proc, ProcStatus oldStatus)
 {
+    countProcStatus(oldStatus, -1);
+    countProcStatus(proc->getStatus(), +1);
+
     for (IWatcher *it : m_watchers) {
-        it->onProcStatusChange(proc);
+        if (it->wantsAllEvents()) {
+            it->onProcStatusChange(proc);
+        }
     }
+
+    updateProgress();
 }
 
 
 void Project::alertEndDecompile(UserProc *proc)
 {
-    for (IWatcher *it : m_watchers) {
-        it->onEndDecompile(proc);
-    }
+    postEvent([proc](IWatcher *watcher) {
+        watcher->onEndDecompile(proc);
+    });
 }
 
 
 void Project::alertDiscovered(Function *function)
 {
-    for (IWatcher *it : m_watchers) {
-        it->onFunctionDiscovered(function);
-    }
+    postEvent([function](IWatcher *watcher) {
+        watcher->onFunctionDiscovered(function);
+    });
 }
 
 
 void Project::alertDecompiling(UserProc *proc)
 {
-    for (IWatcher *it : m_watchers) {
-        it->onDecompileInProgress(proc);
-    }
+    postEvent([proc](IWatcher *watcher) {
+        watcher->onDecompileInProgress(proc);
+    });
 }
 
 
 void Project::alertDecompilationEnd()
 {
+    flushWatcherEvents();
+
     for (IWatcher *w : m_watchers) {
         w->onDecompilationEnd();
     }
@@ -11,9 +11,13 @@
 
 
 #include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/core/Watcher.h"
 #include "boomerang/ifc/IFileLoader.h"
 #include "boomerang/util/Address.h"
 
+#include <QElapsedTimer>
+
+#include <functional>
 #include <memory>
 #include <set>
 #include <vector>
@@ -23,7 +27,6 @@ class BinaryFile;
 class ICodeGenerator;
 class IFrontEnd;
 class ITypeRecovery;
-class IWatcher;
 class Function;
 class Module;
 class Prog;
@@ -124,6 +127,10 @@ public:
     /// Does NOT take ownership of the pointer.
     void addWatcher(IWatcher *watcher);
 
+    /// Send all pending events and the current progress to the watchers
+    /// that do not want all events.
+    void flushWatcherEvents();
+
     /// Called once after a function was created.
     void alertFunctionCreated(Function *function);
 
@@ -152,8 +159,8 @@ public:
     /// Called once for every function on decompilation start (before earlyDecompile)
     void alertStartDecompile(UserProc *proc);
 
-    /// Called every time the status of \p proc has changed.
-    void alertProcStatusChanged(UserProc *proc);
+    /// Called every time the status of \p proc has changed from \p oldStatus.
+    void alertProcStatusChanged(UserProc *proc, ProcStatus oldStatus);
 
     /// Called once for every completely decompiled proc \p proc.
     void alertEndDecompile(UserProc *proc);
@@ -164,6 +171,7 @@ public:
     /// Called during the decompilation process when resuming decompilation of this proc.
     void alertDecompiling(UserProc *proc);
 
+    /// Called at interesting points of the decompilation of \p p, e.g. after every pass.
     void alertDecompileDebugPoint(UserProc *p, const char *description);
 
     /// Called once on decompilation end.
@@ -191,8 +199,16 @@ private:
 
     /**
      * Define symbols from symbol files and command line switches ("-s")
+     * \returns false if a pattern file could not be read.
+     */
+    bool loadSymbols();
+
+    /**
+     * Identify statically linked library functions by the patterns in the
+     * default pattern file of the machine and the pattern files given by "--lib-patterns".
+     * \returns false if a pattern file could not be read.
      */
-    void loadSymbols();
+    bool identifyLibraryFunctions();
 
     /**
      * Disassemble the whole binary file.
@@ -200,12 +216,30 @@ private:
      */
     bool decodeAll();
 
+    /// Deliver \p event to all watchers. Watchers that do not want all events
+    /// receive it with the next progress update.
+    void postEvent(const std::function<void(IWatcher *)> &event);
+
+    /// Send pending events and a progress update to watchers that do not want all events
+    /// if enough time has passed since the last update.
+    void updateProgress();
+
+    /// Add \p delta to the number of procs with status \p status in the progress snapshot.
+    void countProcStatus(ProcStatus status, int delta);
+
 private:
     std::unique_ptr<Settings> m_settings;
 
     /// The watchers which are interested in this decompilation.
     std::set<IWatcher *> m_watchers;
 
+    /// Events not yet delivered to watchers that do not want all events.
+    /// Like the watchers themselves, the pending events and the progress are not guarded:
+    /// all alerts must be raised by the thread that runs the decompilation.
+    std::vector<std::function<void(IWatcher *)>> m_pendingEvents;
+    DecompileProgress m_progress; ///< kept up to date by the alerts
+    QElapsedTimer m_progressTimer; ///< time since the last progress update
+
     // Plugins
     std::vector<std::unique_ptr<LoaderPlugin>> m_loaderPlugins;
 
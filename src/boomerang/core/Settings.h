@@ -77,6 +77,7 @@ public:
     bool removeReturns     = true;
     bool decodeThruIndCall = false;
     bool decodeChildren    = true;
+    bool decodeAddrOrder   = false; ///< Decode the BBs of a procedure in address order
     bool useProof          = true;
     bool changeSignatures  = true;
     bool dfaTypeAnalysis   = true;
@@ -86,6 +87,25 @@ public:
     bool useGlobals        = true;
     bool assumeABI         = false; ///< Assume ABI compliance
     bool experimental      = false; ///< Activate experimental code. Caution!
+    int numThreads         = 1;     ///< Number of worker threads (0 = one per CPU core)
+
+    /// Binary file loaders only split symbol and relocation tables between worker threads
+    /// if each thread gets at least this many entries
+    int loaderMinEntriesPerThread = 0x4000;
+
+    /// Write the contents of initialized data sections as byte arrays
+    bool generateDataSections = false;
+
+    /// Look for functions not reachable from the entry points by a linear sweep
+    /// over the code sections, and decode the ones with at least this confidence score
+    bool linearSweep       = false;
+    int sweepMinConfidence = 60;
+
+    /// Per-procedure decompilation budgets (0 = unlimited). Procedures exceeding a budget
+    /// are decompiled with a cheaper pipeline and reported as degraded.
+    double procTimeBudget = 0.0; ///< Max time spent in the passes of a procedure (in seconds)
+    int procStmtBudget    = 0;   ///< Max number of statements per procedure
+    int procPassBudget    = 0;   ///< Max number of propagation passes per procedure
 
     QString replayFile; ///< file with commands to execute in interactive mode
 
@@ -95,6 +115,9 @@ public:
     /// A vector containing the names of all symbol files to load.
     std::vector<QString> m_symbolFiles;
 
+    /// A vector containing the names of all library function pattern files to load.
+    std::vector<QString> m_patternFiles;
+
     /// A map to find a name by a given address.
     std::map<Address, QString> m_symbolMap;
 
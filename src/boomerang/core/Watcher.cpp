@@ -10,6 +10,23 @@
 #include "Watcher.h"
 
 
+bool IWatcher::wantsAllEvents() const
+{
+    return false;
+}
+
+
+bool IWatcher::stopsAtDebugPoint(UserProc *) const
+{
+    return false;
+}
+
+
+void IWatcher::onProgress(const DecompileProgress &)
+{
+}
+
+
 void IWatcher::onFunctionCreated(Function *)
 {
 }
@@ -13,12 +13,35 @@
 #include "boomerang/core/BoomerangAPI.h"
 #include "boomerang/util/Address.h"
 
+#include <map>
+
 
 class Function;
 class UserProc;
 
+enum ProcStatus : uint8_t;
+
+
+/// Snapshot of the progress of the decompilation.
+/// \sa IWatcher::onProgress
+struct DecompileProgress
+{
+    uint64 numInstructionsDecoded = 0;
+    uint64 numBytesDecoded        = 0; ///< total size of all decoded instructions
+    std::map<ProcStatus, int> numProcsByStatus;
+};
+
 
-/// Virtual class to monitor the decompilation.
+/**
+ * Virtual class to monitor the decompilation.
+ *
+ * By default, high-frequency events (onInstructionDecoded, onProcStatusChange) are not
+ * delivered to the watcher; instead, the watcher periodically receives a progress snapshot
+ * via onProgress. All other events except onFunctionRemoved and onDecompileDebugPoint
+ * are delivered in batches together with the progress snapshot.
+ * Watchers that need to see every event as it happens must override wantsAllEvents.
+ * All events are raised by the thread that runs the decompilation.
+ */
 class BOOMERANG_API IWatcher
 {
 public:
@@ -26,6 +49,17 @@ public:
     virtual ~IWatcher() = default;
 
 public:
+    /// \returns true if this watcher wants to receive all events immediately.
+    virtual bool wantsAllEvents() const;
+
+    /// \returns true if this watcher stops the decompilation at the debug points of \p proc.
+    /// Pending events are only delivered before debug points where some watcher stops.
+    virtual bool stopsAtDebugPoint(UserProc *proc) const;
+
+    /// Called periodically with the current progress of the decompilation,
+    /// and at the end of the decoding and decompilation phases.
+    virtual void onProgress(const DecompileProgress &progress);
+
     /// Called once after a function was created.
     virtual void onFunctionCreated(Function *function);
 
@@ -104,6 +104,11 @@ public:
     inline const Function *getFunction() const { return m_function; }
     inline Function *getFunction() { return m_function; }
 
+    /// Node index of this BB in the control flow analysis that structured its CFG last.
+    /// This is only a hint for ControlFlowAnalyzer, which verifies it before use.
+    inline int getAnalyzerIndex() const { return m_analyzerIndex; }
+    inline void setAnalyzerIndex(int index) { m_analyzerIndex = index; }
+
     /**
      * \returns the lowest real address associated with this BB.
      * \note although this is usually the address of the first RTL, it is not
@@ -281,6 +286,8 @@ protected:
 
     BBType m_bbType = BBType::Invalid; ///< type of basic block
 
+    int m_analyzerIndex = -1; ///< \sa getAnalyzerIndex
+
     /* in-edges and out-edges */
     std::vector<BasicBlock *> m_predecessors; ///< Vector of in-edges
     std::vector<BasicBlock *> m_successors;   ///< Vector of out-edges
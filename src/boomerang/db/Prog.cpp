@@ -48,6 +48,7 @@
 #include <QFileInfo>
 #include <QSaveFile>
 
+#include <algorithm>
 #include <cctype>
 
 
@@ -72,6 +73,9 @@ void Prog::setFrontEnd(IFrontEnd *frontEnd)
 {
     m_fe = frontEnd;
 
+    m_functionsByAddr.clear();
+    m_functionsByName.clear();
+    m_codeIndex.clear();
     m_moduleList.clear();
     m_rootModule = getOrInsertModule(m_name);
 }
@@ -232,27 +236,174 @@ LibProc *Prog::getOrCreateLibraryProc(const QString &name)
 
 Function *Prog::getFunctionByAddr(Address entryAddr) const
 {
-    for (const auto &m : m_moduleList) {
-        Function *proc = m->getFunction(entryAddr);
+    auto it = m_functionsByAddr.find(entryAddr);
+    return (it != m_functionsByAddr.end()) ? it->second : nullptr;
+}
 
-        if (proc != nullptr) {
-            assert(proc != reinterpret_cast<Function *>(-1));
-            return proc;
+
+Function *Prog::getFunctionByName(const QString &name) const
+{
+    // If there are multiple functions with the same name, return the one created first.
+    auto it = m_functionsByName.lower_bound(name);
+    return (it != m_functionsByName.end() && it->first == name) ? it->second : nullptr;
+}
+
+
+UserProc *Prog::getFunctionContaining(Address addr) const
+{
+    auto it = m_codeIndex.upper_bound(addr);
+    if (it == m_codeIndex.begin()) {
+        return nullptr;
+    }
+
+    --it;
+    return (addr < it->second.upper) ? it->second.proc : nullptr;
+}
+
+
+void Prog::addDecodedCode(UserProc *proc, Address lower, Address upper)
+{
+    assert(proc != nullptr);
+
+    // Find the first range that ends after lower
+    auto it = m_codeIndex.upper_bound(lower);
+    if (it != m_codeIndex.begin() && lower < std::prev(it)->second.upper) {
+        --it;
+    }
+
+    // Add the parts of [lower, upper) that are not covered by existing ranges
+    while (lower < upper) {
+        if (it != m_codeIndex.end() && it->first <= lower) {
+            // already decoded
+            lower = std::max(lower, it->second.upper);
+            ++it;
+            continue;
         }
+
+        const Address gapEnd = (it != m_codeIndex.end()) ? std::min(upper, it->first) : upper;
+        auto gapIt           = m_codeIndex.insert(it, { lower, CodeRange{ gapEnd, proc } });
+
+        // Merge with the previous range (the common case of sequential decoding)
+        if (gapIt != m_codeIndex.begin()) {
+            auto prevIt = std::prev(gapIt);
+            if (prevIt->second.upper == lower && prevIt->second.proc == proc) {
+                prevIt->second.upper = gapEnd;
+                m_codeIndex.erase(gapIt);
+                gapIt = prevIt;
+            }
+        }
+
+        // Merge with the next range
+        if (it != m_codeIndex.end() && it->first == gapEnd && it->second.proc == proc) {
+            gapIt->second.upper = it->second.upper;
+            it                  = m_codeIndex.erase(it);
+        }
+
+        lower = gapIt->second.upper;
     }
+}
 
-    return nullptr;
+
+void Prog::removeDecodedCode(UserProc *proc)
+{
+    for (auto it = m_codeIndex.begin(); it != m_codeIndex.end();) {
+        if (it->second.proc == proc) {
+            it = m_codeIndex.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
 }
 
 
-Function *Prog::getFunctionByName(const QString &name) const
+std::vector<std::pair<Address, Address>> Prog::getDecodedCode() const
 {
-    for (const auto &module : m_moduleList) {
-        Function *f = module->getFunction(name);
+    std::vector<std::pair<Address, Address>> ranges;
+    ranges.reserve(m_codeIndex.size());
 
-        if (f) {
-            assert(f != reinterpret_cast<Function *>(-1));
-            return f;
+    for (const auto &[lower, range] : m_codeIndex) {
+        ranges.push_back({ lower, range.upper });
+    }
+
+    return ranges;
+}
+
+
+std::vector<Function *> Prog::getFunctionsInRange(Address from, Address to) const
+{
+    std::vector<Function *> result;
+
+    for (auto it = m_functionsByAddr.lower_bound(from); it != m_functionsByAddr.end(); ++it) {
+        if (it->first >= to) {
+            break;
+        }
+
+        result.push_back(it->second);
+    }
+
+    return result;
+}
+
+
+void Prog::addFunctionToIndex(Function *function)
+{
+    assert(function != nullptr);
+
+    if (function->getEntryAddress() != Address::INVALID) {
+        m_functionsByAddr[function->getEntryAddress()] = function;
+    }
+
+    m_functionsByName.insert({ function->getName(), function });
+}
+
+
+bool Prog::removeFunctionFromIndex(Function *function)
+{
+    assert(function != nullptr);
+    bool found = false;
+
+    auto addrIt = m_functionsByAddr.find(function->getEntryAddress());
+    if (addrIt != m_functionsByAddr.end() && addrIt->second == function) {
+        m_functionsByAddr.erase(addrIt);
+        found = true;
+    }
+
+    auto range = m_functionsByName.equal_range(function->getName());
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == function) {
+            m_functionsByName.erase(it);
+            found = true;
+            break;
+        }
+    }
+
+    return found;
+}
+
+
+void Prog::addToDecodeWorklist(Address entryAddr)
+{
+    if (entryAddr != Address::INVALID) {
+        m_decodeWorklist.push_back(entryAddr);
+    }
+}
+
+
+UserProc *Prog::takeNextUndecodedProc()
+{
+    while (!m_decodeWorklist.empty()) {
+        const Address entryAddr = m_decodeWorklist.front();
+        m_decodeWorklist.pop_front();
+
+        Function *function = getFunctionByAddr(entryAddr);
+        if (!function || function->isLib()) {
+            continue;
+        }
+
+        UserProc *proc = static_cast<UserProc *>(function);
+        if (!proc->isDecoded()) {
+            return proc;
         }
     }
 
@@ -266,6 +417,12 @@ bool Prog::removeFunction(const QString &name)
 
     if (function) {
         function->removeFromModule();
+
+        // The code of the function does not belong to any function anymore
+        if (!function->isLib()) {
+            removeDecodedCode(static_cast<UserProc *>(function));
+        }
+
         m_project->alertFunctionRemoved(function);
         // FIXME: this function removes the function from module, but it leaks it
         return true;
@@ -339,20 +496,25 @@ Machine Prog::getMachine() const
 }
 
 
+QString Prog::getLibraryCatalogName(Machine machine)
+{
+    switch (machine) {
+    case Machine::PENTIUM: return "signatures/pentium.hs";
+    case Machine::SPARC: return "signatures/sparc.hs";
+    case Machine::HPRISC: return "signatures/parisc.hs";
+    case Machine::PPC: return "signatures/ppc.hs";
+    case Machine::ST20: return "signatures/st20.hs";
+    case Machine::MIPS: return "signatures/mips.hs";
+    default: return "";
+    }
+}
+
+
 void Prog::readDefaultLibraryCatalogues()
 {
     QDir dataDir = m_project->getSettings()->getDataDirectory();
 
-    QString libCatalogName;
-    switch (getMachine()) {
-    case Machine::PENTIUM: libCatalogName = "signatures/pentium.hs"; break;
-    case Machine::SPARC: libCatalogName = "signatures/sparc.hs"; break;
-    case Machine::HPRISC: libCatalogName = "signatures/parisc.hs"; break;
-    case Machine::PPC: libCatalogName = "signatures/ppc.hs"; break;
-    case Machine::ST20: libCatalogName = "signatures/st20.hs"; break;
-    case Machine::MIPS: libCatalogName = "signatures/mips.hs"; break;
-    default: libCatalogName = ""; break;
-    }
+    const QString libCatalogName = getLibraryCatalogName(getMachine());
 
     m_symbolProvider->readLibraryCatalog(dataDir.absoluteFilePath("signatures/common.hs"));
 
@@ -641,6 +803,8 @@ bool Prog::reDecode(UserProc *proc)
         return false;
     }
 
+    // The code might be decoded differently this time
+    removeDecodedCode(proc);
     return m_fe->processProc(proc, proc->getEntryAddress());
 }
 
@@ -20,10 +20,13 @@
 
 #include <QString>
 
+#include <deque>
 #include <list>
 #include <map>
 #include <memory>
 #include <set>
+#include <utility>
+#include <vector>
 
 
 class ArrayType;
@@ -130,11 +133,63 @@ public:
     /// or nullptr if no such function exists.
     Function *getFunctionByName(const QString &name) const;
 
+    /**
+     * \returns the user procedure whose decoded code contains \p addr,
+     * or nullptr if no such procedure exists. If multiple procedures share the code at \p addr,
+     * the procedure that decoded it first is returned.
+     */
+    UserProc *getFunctionContaining(Address addr) const;
+
+    /**
+     * Add the instruction(s) in [\p lower, \p upper) to the decoded code of \p proc.
+     * This is called by the front end for each decoded instruction.
+     * Code that is already part of the decoded code of another procedure is not added again.
+     */
+    void addDecodedCode(UserProc *proc, Address lower, Address upper);
+
+    /// Remove all decoded code of \p proc, e.g. because its decode failed
+    /// or it is about to be decoded again.
+    void removeDecodedCode(UserProc *proc);
+
+    /// \returns the right-open address ranges of the decoded code of all user procedures,
+    /// sorted by address. Each range ends at the end of its last decoded instruction.
+    std::vector<std::pair<Address, Address>> getDecodedCode() const;
+
+    /// \returns all functions with entry address in [\p from, \p to),
+    /// ordered by entry address.
+    std::vector<Function *> getFunctionsInRange(Address from, Address to) const;
+
     /// Removes the function with name \p name.
     /// If there is no such function, nothing happens.
     /// \returns true if function was found and removed.
     bool removeFunction(const QString &name);
 
+    /**
+     * Add \p function to the program-wide function index, or remove it.
+     * These are called by Module and Function whenever a function is added to or removed
+     * from a module of this program, and around changes of the name or entry address
+     * of a function.
+     * \returns true if the function was in the index before removal.
+     */
+    void addFunctionToIndex(Function *function);
+    bool removeFunctionFromIndex(Function *function);
+
+    /**
+     * Add the user procedure at \p entryAddr to the worklist of procedures
+     * that still have to be decoded. This is called by Module whenever a new user procedure
+     * is created, so the front end does not have to search the whole program
+     * for undecoded procedures.
+     */
+    void addToDecodeWorklist(Address entryAddr);
+
+    /// Remove the next undecoded user procedure from the decode worklist.
+    /// \returns the procedure, or nullptr if all procedures have been decoded.
+    UserProc *takeNextUndecodedProc();
+
+    /// \returns the number of entries in the decode worklist.
+    /// This is an upper bound of the number of procedures that still have to be decoded.
+    int getDecodeWorklistSize() const { return static_cast<int>(m_decodeWorklist.size()); }
+
     /// \param userOnly If true, only count user functions, not lbrary functions.
     /// \returns the number of functions in this program.
     int getNumFunctions(bool userOnly = true) const;
@@ -152,6 +207,10 @@ public:
     Machine getMachine() const;
 
     void readDefaultLibraryCatalogues();
+
+    /// \returns the path of the machine specific library signature catalog,
+    /// relative to the data directory, or an empty string if there is none.
+    static QString getLibraryCatalogName(Machine machine);
     bool addSymbolsFromSymbolFile(const QString &fname);
     std::shared_ptr<Signature> getLibSignature(const QString &name);
 
@@ -255,9 +314,31 @@ private:
     Module *m_rootModule     = nullptr; ///< Root of the module tree
     ModuleList m_moduleList;            ///< The Modules that make up this program
 
+    /// Program-wide function index over all modules. Lookups by address or name
+    /// therefore do not depend on the number of modules.
+    std::map<Address, Function *> m_functionsByAddr;
+    std::multimap<QString, Function *> m_functionsByName;
+
+    /// Decoded code of all user procedures, for looking up the procedure containing an address.
+    /// Maps the lower bound of each range of code to its (exclusive) upper bound and to the
+    /// procedure that decoded it. Ranges do not overlap; adjacent code of the same procedure
+    /// is merged into a single range.
+    struct CodeRange
+    {
+        Address upper;
+        UserProc *proc;
+    };
+
+    std::map<Address, CodeRange> m_codeIndex;
+
     /// list of UserProcs for entry point(s)
     std::list<UserProc *> m_entryProcs;
 
+    /// Entry addresses of user procedures that might not have been decoded yet, in order
+    /// of discovery. Procedures are looked up again when they are taken from the worklist,
+    /// since they might have been removed or decoded in the meantime.
+    std::deque<Address> m_decodeWorklist;
+
     // FIXME: is a set of Globals the most appropriate data structure? Surely not.
     GlobalSet m_globals;         ///< globals to print at code generation time
     DataIntervalMap m_globalMap; ///< Map from address to DataInterval (has size, name, type)
@@ -77,7 +77,7 @@ Address BinaryFile::getMainEntryPoint() const
 
 bool BinaryFile::isRelocationAt(Address addr) const
 {
-    return m_loader ? m_loader->isRelocationAt(addr) : false;
+    return m_image->isRelocationAt(addr);
 }
 
 
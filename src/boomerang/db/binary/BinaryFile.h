@@ -88,7 +88,8 @@ public:
     /// \returns the address of main()/WinMain(), if found, else Address::INVALID
     Address getMainEntryPoint() const;
 
-    /// \returns true if \p addr is the destination of a relocated symbol.
+    /// \returns true if \p addr is the destination of a relocation.
+    /// \sa BinaryImage::isRelocationAt
     bool isRelocationAt(Address addr) const;
 
     /// \returns the destination of a jump at address \p addr, taking relocation into account
@@ -15,11 +15,81 @@
 #include "boomerang/util/log/Log.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
+
+
+namespace
+{
+/**
+ * The section index entry of the last successful section lookup of this thread.
+ * Consecutive reads almost always hit the same section as the previous read,
+ * so this avoids the binary search over the section index in the common case.
+ * The cache is only valid if \ref generation matches the generation of the image
+ * that is being read from; generations are unique across all images.
+ */
+struct SectionLookupCache
+{
+    uint64 generation    = 0;
+    std::size_t entryIdx = 0;
+};
+
+thread_local SectionLookupCache g_lastSectionHit;
+
+std::atomic<uint64> g_nextIndexGeneration(1);
+
+
+template<typename T>
+T normEndianT(T value, Endian srcEndian)
+{
+    return Util::normEndian(value, srcEndian);
+}
+
+
+template<>
+Byte normEndianT<Byte>(Byte value, Endian)
+{
+    return value;
+}
+
+
+/// Read up to \p count values of type \p T from \p section, starting at \p addr.
+/// \returns the number of values read.
+template<typename T>
+std::size_t readNativeArray(const BinarySection *section, Address addr, T *values,
+                            std::size_t count)
+{
+    if (section == nullptr || section->getHostAddr() == HostAddress::INVALID) {
+        LOG_WARN("Invalid read at address %1: Address is not mapped to a section", addr);
+        return 0;
+    }
+
+    const Address sectionEnd   = section->getSourceAddr() + section->getSize();
+    const std::size_t maxCount = (sectionEnd - addr).value() / sizeof(T);
+
+    if (count > maxCount) {
+        LOG_WARN("Invalid read at address %1: Read extends past section boundary", addr);
+        count = maxCount;
+    }
+
+    const HostAddress host = section->getHostAddr() - section->getSourceAddr() + addr;
+    std::memcpy(values, reinterpret_cast<const void *>(host.value()), count * sizeof(T));
+
+    if (section->getEndian() != static_cast<Endian>(BOOMERANG_BIG_ENDIAN)) {
+        for (std::size_t i = 0; i < count; i++) {
+            values[i] = normEndianT<T>(values[i], section->getEndian());
+        }
+    }
+
+    return count;
+}
+}
 
 
 BinaryImage::BinaryImage(const QByteArray &rawData)
     : m_rawData(rawData)
 {
+    invalidateSectionCache();
 }
 
 
@@ -31,8 +101,10 @@ BinaryImage::~BinaryImage()
 
 void BinaryImage::reset()
 {
-    m_sectionMap.clear();
     m_sections.clear();
+    m_sectionIndex.clear();
+    m_relocations.clear();
+    invalidateSectionCache();
 }
 
 
@@ -104,6 +176,130 @@ QWord BinaryImage::readNative8(Address addr) const
 }
 
 
+std::size_t BinaryImage::readNative1(Address addr, Byte *values, std::size_t count) const
+{
+    return readNativeArray(getSectionByAddr(addr), addr, values, count);
+}
+
+
+std::size_t BinaryImage::readNative2(Address addr, SWord *values, std::size_t count) const
+{
+    return readNativeArray(getSectionByAddr(addr), addr, values, count);
+}
+
+
+std::size_t BinaryImage::readNative4(Address addr, DWord *values, std::size_t count) const
+{
+    return readNativeArray(getSectionByAddr(addr), addr, values, count);
+}
+
+
+std::size_t BinaryImage::readNative8(Address addr, QWord *values, std::size_t count) const
+{
+    return readNativeArray(getSectionByAddr(addr), addr, values, count);
+}
+
+
+std::size_t BinaryImage::countPointersInRange(Address tableAddr, std::size_t maxCount,
+                                              int pointerSize, Address targetLow,
+                                              Address targetHigh) const
+{
+    // read the table in blocks to avoid allocating memory for huge tables
+    constexpr std::size_t BLOCK_SIZE = 64;
+    QWord block[BLOCK_SIZE];
+    std::size_t numValid = 0;
+
+    while (numValid < maxCount) {
+        const Address blockAddr = tableAddr + numValid * pointerSize;
+        const std::size_t toRead = std::min(BLOCK_SIZE, maxCount - numValid);
+        std::size_t numRead     = 0;
+
+        if (pointerSize == 4) {
+            DWord block4[BLOCK_SIZE];
+            numRead = readNative4(blockAddr, block4, toRead);
+            std::copy_n(block4, numRead, block);
+        }
+        else if (pointerSize == 8) {
+            numRead = readNative8(blockAddr, block, toRead);
+        }
+        else {
+            LOG_ERROR("Cannot read pointers of size %1", pointerSize);
+            return 0;
+        }
+
+        for (std::size_t i = 0; i < numRead; i++) {
+            if (!Util::inRange(Address(block[i]), targetLow, targetHigh)) {
+                return numValid + i;
+            }
+        }
+
+        numValid += numRead;
+
+        if (numRead < toRead) {
+            break; // reached end of section
+        }
+    }
+
+    return numValid;
+}
+
+
+std::vector<Address> BinaryImage::findPointersInRange(Address from, Address to, int pointerSize,
+                                                      Address targetLow, Address targetHigh) const
+{
+    std::vector<Address> result;
+
+    if (pointerSize != 4 && pointerSize != 8) {
+        LOG_ERROR("Cannot read pointers of size %1", pointerSize);
+        return result;
+    }
+
+    // align to pointer size
+    Address addr = Address((from.value() + pointerSize - 1) & ~Address::value_type(pointerSize - 1));
+
+    while (addr + pointerSize <= to) {
+        const BinarySection *section = getSectionByAddr(addr);
+        if (section == nullptr || section->getHostAddr() == HostAddress::INVALID) {
+            // skip to the next section, if any
+            const auto it = std::upper_bound(
+                m_sectionIndex.begin(), m_sectionIndex.end(), addr,
+                [](Address a, const SectionIndexEntry &entry) { return a < entry.extent.lower(); });
+
+            if (it == m_sectionIndex.end()) {
+                break;
+            }
+
+            addr = Address((it->extent.lower().value() + pointerSize - 1) &
+                           ~Address::value_type(pointerSize - 1));
+            continue;
+        }
+
+        const Address sectionEnd = std::min(to, section->getSourceAddr() + section->getSize());
+        const std::size_t count  = (sectionEnd - addr).value() / pointerSize;
+        const HostAddress host   = section->getHostAddr() - section->getSourceAddr() + addr;
+        const Byte *data         = reinterpret_cast<const Byte *>(host.value());
+
+        for (std::size_t i = 0; i < count; i++) {
+            const Address value = (pointerSize == 4)
+                                      ? Address(Util::readDWord(data + 4 * i, section->getEndian()))
+                                      : Address(Util::readQWord(data + 8 * i, section->getEndian()));
+
+            if (Util::inRange(value, targetLow, targetHigh)) {
+                result.push_back(addr + i * pointerSize);
+            }
+        }
+
+        if (count == 0) {
+            break; // section too small to contain another pointer
+        }
+
+        addr += count * pointerSize;
+    }
+
+    return result;
+}
+
+
 bool BinaryImage::readNativeFloat4(Address addr, float &value) const
 {
     const BinarySection *sect = getSectionByAddr(addr);
@@ -221,6 +417,34 @@ bool BinaryImage::isReadOnly(Address addr) const
 }
 
 
+void BinaryImage::addRelocations(std::vector<Address> relocations)
+{
+    if (m_relocations.empty()) {
+        m_relocations = std::move(relocations);
+    }
+    else {
+        m_relocations.insert(m_relocations.end(), relocations.begin(), relocations.end());
+    }
+
+    std::sort(m_relocations.begin(), m_relocations.end());
+    m_relocations.erase(std::unique(m_relocations.begin(), m_relocations.end()),
+                        m_relocations.end());
+}
+
+
+bool BinaryImage::isRelocationAt(Address addr) const
+{
+    return std::binary_search(m_relocations.begin(), m_relocations.end(), addr);
+}
+
+
+Address BinaryImage::findRelocation(Address from, Address to) const
+{
+    auto it = std::lower_bound(m_relocations.begin(), m_relocations.end(), from);
+    return (it != m_relocations.end() && *it < to) ? *it : Address::INVALID;
+}
+
+
 Address BinaryImage::getLimitTextLow() const
 {
     return m_limitTextLow;
@@ -256,33 +480,38 @@ BinarySection *BinaryImage::createSection(const QString &name, Address from, Add
     // section. It can therefore overlap other sections containing data. This is a quirk of ELF
     // programs linked statically with glibc
     if (name != ".tbss") {
-        IntervalMap<Address, std::unique_ptr<BinarySection>>::iterator itFrom, itTo;
-        std::tie(itFrom, itTo) = m_sectionMap.equalRange(from, to);
-
-        for (auto clash_with = itFrom; clash_with != itTo; ++clash_with) {
-            if ((*clash_with->second).getName() != ".tbss") {
+        for (const SectionIndexEntry &clashWith : m_sectionIndex) {
+            if (clashWith.extent.lower() < to && clashWith.extent.upper() > from &&
+                clashWith.section->getName() != ".tbss") {
                 LOG_WARN("Segment %1 would intersect existing segment %2", name,
-                         (*clash_with->second).getName());
+                         clashWith.section->getName());
                 return nullptr;
             }
         }
     }
 #endif
 
-    BinarySection *sect = new BinarySection(from, (to - from).value(), name);
+    auto insertPos = std::lower_bound(
+        m_sectionIndex.begin(), m_sectionIndex.end(), from,
+        [](const SectionIndexEntry &entry, Address a) { return entry.extent.lower() < a; });
 
-    if (m_sectionMap.insert(from, to, std::unique_ptr<BinarySection>(sect)) == m_sectionMap.end()) {
+    if (insertPos != m_sectionIndex.end() && insertPos->extent.lower() == from) {
         // section already existed
-        BinarySection *existing = getSectionByAddr(from);
         LOG_ERROR("Could not create section '%1' from address %2 to %3: Section extent matches "
                   "existing section '%4",
-                  name, from, to, existing->getName());
+                  name, from, to, insertPos->section->getName());
         return nullptr;
     }
-    else {
-        m_sections.push_back(sect);
-        return sect;
-    }
+
+    BinarySection *sect = new BinarySection(from, (to - from).value(), name);
+
+    m_sectionIndex.insert(insertPos, SectionIndexEntry{ Interval<Address>(from, to), to,
+                                                        std::unique_ptr<BinarySection>(sect) });
+    m_sections.push_back(sect);
+
+    updateSectionIndex();
+    invalidateSectionCache();
+    return sect;
 }
 
 
@@ -330,13 +559,76 @@ const BinarySection *BinaryImage::getSectionByName(const QString &sectionName) c
 
 BinarySection *BinaryImage::getSectionByAddr(Address addr)
 {
-    auto iter = m_sectionMap.find(addr);
-    return (iter != m_sectionMap.end()) ? iter->second.get() : nullptr;
+    const SectionIndexEntry *entry = findSectionEntry(addr);
+    return entry ? entry->section.get() : nullptr;
 }
 
 
 const BinarySection *BinaryImage::getSectionByAddr(Address addr) const
 {
-    auto iter = m_sectionMap.find(addr);
-    return (iter != m_sectionMap.end()) ? iter->second.get() : nullptr;
+    const SectionIndexEntry *entry = findSectionEntry(addr);
+    return entry ? entry->section.get() : nullptr;
+}
+
+
+const BinaryImage::SectionIndexEntry *BinaryImage::findSectionEntry(Address addr) const
+{
+    SectionLookupCache &cache = g_lastSectionHit;
+
+    if (cache.generation == m_indexGeneration) {
+        const SectionIndexEntry &entry = m_sectionIndex[cache.entryIdx];
+        if (entry.extent.isContained(addr)) {
+            return &entry;
+        }
+    }
+
+    // first section starting after addr
+    auto it = std::upper_bound(
+        m_sectionIndex.begin(), m_sectionIndex.end(), addr,
+        [](Address a, const SectionIndexEntry &entry) { return a < entry.extent.lower(); });
+
+    // Sections may overlap. If multiple sections contain addr,
+    // the section with the lowest start address is retrieved.
+    const SectionIndexEntry *found = nullptr;
+
+    while (it != m_sectionIndex.begin()) {
+        --it;
+
+        if (it->maxUpper <= addr) {
+            break; // no section up to and including this one reaches addr
+        }
+        else if (it->extent.isContained(addr)) {
+            found = &(*it);
+        }
+    }
+
+    if (found != nullptr) {
+        const std::size_t idx = found - m_sectionIndex.data();
+
+        // Only cache sections not overlapped by other sections
+        // to keep the semantics of the lookup above
+        if (idx == 0 || m_sectionIndex[idx - 1].maxUpper <= found->extent.lower()) {
+            cache.generation = m_indexGeneration;
+            cache.entryIdx   = idx;
+        }
+    }
+
+    return found;
+}
+
+
+void BinaryImage::invalidateSectionCache()
+{
+    m_indexGeneration = g_nextIndexGeneration++;
+}
+
+
+void BinaryImage::updateSectionIndex()
+{
+    Address maxUpper = Address::ZERO;
+
+    for (SectionIndexEntry &entry : m_sectionIndex) {
+        maxUpper       = std::max(maxUpper, entry.extent.upper());
+        entry.maxUpper = maxUpper;
+    }
 }
@@ -11,7 +11,8 @@
 
 
 #include "boomerang/util/Address.h"
-#include "boomerang/util/IntervalMap.h"
+#include "boomerang/util/Interval.h"
+#include "boomerang/util/Types.h"
 
 #include <QByteArray>
 
@@ -108,6 +109,35 @@ public:
     DWord readNative4(Address addr) const;
     QWord readNative8(Address addr) const;
 
+    /**
+     * Read \p count consecutive values starting at \p addr into \p values.
+     * The section containing \p addr is only looked up once, so prefer these
+     * over repeated single reads when walking tables.
+     * \returns the number of values read. This is less than \p count
+     * if the read would extend past the end of the section.
+     */
+    std::size_t readNative1(Address addr, Byte *values, std::size_t count) const;
+    std::size_t readNative2(Address addr, SWord *values, std::size_t count) const;
+    std::size_t readNative4(Address addr, DWord *values, std::size_t count) const;
+    std::size_t readNative8(Address addr, QWord *values, std::size_t count) const;
+
+    /**
+     * Read pointers of size \p pointerSize (4 or 8 bytes) stored consecutively at \p tableAddr
+     * until a pointer does not point into [\p targetLow, \p targetHigh), or until
+     * \p maxCount pointers have been read.
+     * \returns the number of consecutive valid pointers at \p tableAddr.
+     */
+    std::size_t countPointersInRange(Address tableAddr, std::size_t maxCount, int pointerSize,
+                                     Address targetLow, Address targetHigh) const;
+
+    /**
+     * Scan the pointer-aligned values in [\p from, \p to) and collect
+     * the addresses of all values that point into [\p targetLow, \p targetHigh).
+     * \param pointerSize size of a pointer in bytes (4 or 8)
+     */
+    std::vector<Address> findPointersInRange(Address from, Address to, int pointerSize,
+                                             Address targetLow, Address targetHigh) const;
+
     bool readNativeFloat4(Address addr, float &value) const;
     bool readNativeFloat8(Address addr, double &value) const;
 
@@ -116,12 +146,53 @@ public:
     /// \returns true if \p addr is in a read-only section
     bool isReadOnly(Address addr) const;
 
+    /**
+     * Add the destinations of relocations (i.e. the addresses of the relocated words)
+     * to the relocation index of this image. This is called by loaders after applying
+     * the relocations of the file. Loaders also add the destinations of relocations
+     * they cannot apply, since the relocated words are not plain data either way.
+     */
+    void addRelocations(std::vector<Address> relocations);
+
+    /// \returns true if the word at \p addr is the destination of a relocation.
+    bool isRelocationAt(Address addr) const;
+
+    /// \returns the lowest relocation destination in [\p from, \p to),
+    /// or Address::INVALID if there is no relocation in this range.
+    Address findRelocation(Address from, Address to) const;
+
+    /// \returns the number of relocations in the relocation index.
+    std::size_t getNumRelocations() const { return m_relocations.size(); }
+
+private:
+    /// Entry of the section index, sorted by start address.
+    struct SectionIndexEntry
+    {
+        Interval<Address> extent;
+        Address maxUpper; ///< highest upper bound of all entries up to and including this one
+        std::unique_ptr<BinarySection> section;
+    };
+
+    /// \returns the index entry of the section containing \p addr,
+    /// or nullptr if no such section exists.
+    const SectionIndexEntry *findSectionEntry(Address addr) const;
+
+    /// Invalidates the per-thread section lookup cache of this image.
+    void invalidateSectionCache();
+
+    /// Recomputes \ref SectionIndexEntry::maxUpper for all entries.
+    void updateSectionIndex();
+
 private:
     QByteArray m_rawData;
     Address m_limitTextLow  = Address::INVALID;
     Address m_limitTextHigh = Address::INVALID;
     ptrdiff_t m_textDelta   = 0;
 
-    SectionList m_sections; ///< The section info
-    IntervalMap<Address, std::unique_ptr<BinarySection>> m_sectionMap;
+    SectionList m_sections; ///< The section info, in creation order
+    std::vector<SectionIndexEntry> m_sectionIndex; ///< Owns the sections; sorted by start address
+    uint64 m_indexGeneration = 0; ///< Changes whenever the section index is modified
+
+    std::vector<Address> m_relocations; ///< Sorted destinations of all relocations
+
 };
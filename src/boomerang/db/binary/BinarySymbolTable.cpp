@@ -12,81 +12,183 @@
 #include "boomerang/db/binary/BinarySymbol.h"
 #include "boomerang/util/log/Log.h"
 
+#include <QHash>
+
+#include <algorithm>
 #include <cassert>
 
 
+namespace
+{
+uint32 hashAddress(Address addr)
+{
+    // Fibonacci hashing; the upper bits are well distributed even for aligned addresses
+    const uint64 h = static_cast<uint64>(addr.value()) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<uint32>(h >> 32);
+}
+
+
+uint32 hashName(const QString &name)
+{
+    return qHash(name);
+}
+}
+
+
 BinarySymbolTable::BinarySymbolTable()
 {
 }
 
 
+BinarySymbolTable::BinarySymbolTable(BinarySymbolTable &&other)
+{
+    *this = std::move(other);
+}
+
+
 BinarySymbolTable::~BinarySymbolTable()
 {
     clear();
 }
 
 
+BinarySymbolTable &BinarySymbolTable::operator=(BinarySymbolTable &&other)
+{
+    // the mutex is not moved; each table keeps its own
+    m_symbols       = std::move(other.m_symbols);
+    m_addrEntries   = std::move(other.m_addrEntries);
+    m_addrIndex     = std::move(other.m_addrIndex);
+    m_nameIndex     = std::move(other.m_nameIndex);
+    m_sortedSymbols = std::move(other.m_sortedSymbols);
+    m_symbolList    = std::move(other.m_symbolList);
+    return *this;
+}
+
+
 void BinarySymbolTable::clear()
 {
     m_addrIndex.clear();
-    m_symbolList.clear();
+    m_addrEntries.clear();
     m_nameIndex.clear();
+    m_sortedSymbols.clear();
+    m_symbolList.clear();
+    m_symbols.clear();
+}
+
+
+void BinarySymbolTable::reserve(int numSymbols)
+{
+    if (numSymbols <= 0) {
+        return;
+    }
+
+    m_symbols.reserve(numSymbols);
+    m_symbolList.reserve(numSymbols);
+    m_addrEntries.reserve(numSymbols);
+    m_addrIndex.reserve(numSymbols);
+    m_nameIndex.reserve(numSymbols);
 }
 
 
 BinarySymbol *BinarySymbolTable::createSymbol(Address addr, const QString &name, bool local)
 {
-    if (m_addrIndex.find(addr) != m_addrIndex.end()) {
+    if (findAddrIndex(addr) != HashIndex::NOT_FOUND) {
         return nullptr; // symbol already exists
     }
 
     // If the symbol already exists, redirect the new symbol to the old one.
-    std::map<QString, std::shared_ptr<BinarySymbol>>::iterator it = m_nameIndex.find(name);
+    const int existingIdx = findNameIndex(name);
 
-    if (it != m_nameIndex.end()) {
+    if (existingIdx != HashIndex::NOT_FOUND) {
         LOG_WARN("Symbol '%1' already exists in the global symbol table!", name);
-        std::shared_ptr<BinarySymbol> existingSymbol = it->second;
-        m_addrIndex[addr]                            = existingSymbol;
-        return existingSymbol.get();
+        m_addrEntries.emplace_back(addr, existingIdx);
+        m_addrIndex.insert(hashAddress(addr), m_addrEntries.size() - 1);
+        return m_symbols[existingIdx].get();
     }
 
-    std::shared_ptr<BinarySymbol> sym = std::make_shared<BinarySymbol>(addr, name);
-    m_addrIndex[addr]                 = sym;
+    const int symbolIdx = m_symbols.size();
+    m_symbols.emplace_back(new BinarySymbol(addr, name));
+    BinarySymbol *sym = m_symbols.back().get();
+
+    m_addrEntries.emplace_back(addr, symbolIdx);
+    m_addrIndex.insert(hashAddress(addr), m_addrEntries.size() - 1);
 
     if (!local) {
-        m_nameIndex[name] = sym;
+        m_nameIndex.insert(hashName(name), symbolIdx);
     }
 
-    m_symbolList.push_back(sym.get());
-    return sym.get();
+    m_symbolList.push_back(sym);
+    return sym;
+}
+
+
+int BinarySymbolTable::createSymbols(const std::vector<std::pair<Address, QString>> &symbols,
+                                     bool local)
+{
+    reserve(m_symbols.size() + symbols.size());
+
+    const int oldNumSymbols = m_symbols.size();
+
+    for (const auto &[addr, name] : symbols) {
+        createSymbol(addr, name, local);
+    }
+
+    return m_symbols.size() - oldNumSymbols;
 }
 
 
 BinarySymbol *BinarySymbolTable::findSymbolByAddress(Address addr)
 {
-    auto ff = m_addrIndex.find(addr);
-    return (ff != m_addrIndex.end()) ? ff->second.get() : nullptr;
+    const int idx = findAddrIndex(addr);
+    return (idx != HashIndex::NOT_FOUND) ? m_symbols[m_addrEntries[idx].second].get() : nullptr;
 }
 
 
 const BinarySymbol *BinarySymbolTable::findSymbolByAddress(Address addr) const
 {
-    auto ff = m_addrIndex.find(addr);
-    return (ff != m_addrIndex.end()) ? ff->second.get() : nullptr;
+    const int idx = findAddrIndex(addr);
+    return (idx != HashIndex::NOT_FOUND) ? m_symbols[m_addrEntries[idx].second].get() : nullptr;
 }
 
 
 BinarySymbol *BinarySymbolTable::findSymbolByName(const QString &name)
 {
-    auto ff = m_nameIndex.find(name);
-    return (ff != m_nameIndex.end()) ? ff->second.get() : nullptr;
+    const int idx = findNameIndex(name);
+    return (idx != HashIndex::NOT_FOUND) ? m_symbols[idx].get() : nullptr;
 }
 
 
 const BinarySymbol *BinarySymbolTable::findSymbolByName(const QString &name) const
 {
-    auto ff = m_nameIndex.find(name);
-    return (ff != m_nameIndex.end()) ? ff->second.get() : nullptr;
+    const int idx = findNameIndex(name);
+    return (idx != HashIndex::NOT_FOUND) ? m_symbols[idx].get() : nullptr;
+}
+
+
+const BinarySymbol *BinarySymbolTable::findSymbolContaining(Address addr) const
+{
+    updateSortedSymbols();
+
+    // first symbol with address > addr
+    auto it = std::upper_bound(m_sortedSymbols.begin(), m_sortedSymbols.end(), addr,
+                               [this](Address a, int symbolIdx) {
+                                   return a < m_symbols[symbolIdx]->getLocation();
+                               });
+
+    if (it == m_sortedSymbols.begin()) {
+        return nullptr;
+    }
+
+    const BinarySymbol *sym = m_symbols[*std::prev(it)].get();
+
+    if (sym->getLocation() == addr) {
+        return sym;
+    }
+    else if (sym->getSize() > 0 && addr < sym->getLocation() + sym->getSize()) {
+        return sym;
+    }
+
+    return nullptr;
 }
 
 
@@ -96,24 +198,62 @@ bool BinarySymbolTable::renameSymbol(const QString &oldName, const QString &newN
         return true;
     }
 
-    auto oldIt = m_nameIndex.find(oldName);
-    auto newIt = m_nameIndex.find(newName);
+    const int oldIdx = findNameIndex(oldName);
+    const int newIdx = findNameIndex(newName);
 
-    if (oldIt == m_nameIndex.end()) { // symbol not found
+    if (oldIdx == HashIndex::NOT_FOUND) { // symbol not found
         LOG_ERROR("Could not rename symbol '%1' to '%2': A symbol with name '%1' was not found.",
                   oldName, newName);
         return false;
     }
-    else if (newIt != m_nameIndex.end()) { // symbol name clash
+    else if (newIdx != HashIndex::NOT_FOUND) { // symbol name clash
         LOG_ERROR("Could not rename symbol '%1' to '%2': A symbol with name '%2' already exists",
                   oldName, newName);
         return false;
     }
 
-    std::shared_ptr<BinarySymbol> oldSymbol = oldIt->second;
-    m_nameIndex.erase(oldIt);
-    oldSymbol->m_name    = newName;
-    m_nameIndex[newName] = oldSymbol;
+    m_nameIndex.remove(hashName(oldName), [oldIdx](int idx) { return idx == oldIdx; });
+    m_symbols[oldIdx]->m_name = newName;
+    m_nameIndex.insert(hashName(newName), oldIdx);
 
     return true;
 }
+
+
+int BinarySymbolTable::findAddrIndex(Address addr) const
+{
+    return m_addrIndex.find(hashAddress(addr),
+                            [this, addr](int idx) { return m_addrEntries[idx].first == addr; });
+}
+
+
+int BinarySymbolTable::findNameIndex(const QString &name) const
+{
+    return m_nameIndex.find(hashName(name),
+                            [this, &name](int idx) { return m_symbols[idx]->getName() == name; });
+}
+
+
+void BinarySymbolTable::updateSortedSymbols() const
+{
+    std::lock_guard<std::mutex> lock(m_sortedSymbolsMutex);
+
+    if (m_sortedSymbols.size() == m_symbols.size()) {
+        return; // up to date
+    }
+
+    const std::size_t oldSize = m_sortedSymbols.size();
+    m_sortedSymbols.reserve(m_symbols.size());
+
+    for (std::size_t i = oldSize; i < m_symbols.size(); i++) {
+        m_sortedSymbols.push_back(i);
+    }
+
+    auto byAddress = [this](int a, int b) {
+        return m_symbols[a]->getLocation() < m_symbols[b]->getLocation();
+    };
+
+    std::sort(m_sortedSymbols.begin() + oldSize, m_sortedSymbols.end(), byAddress);
+    std::inplace_merge(m_sortedSymbols.begin(), m_sortedSymbols.begin() + oldSize,
+                       m_sortedSymbols.end(), byAddress);
+}
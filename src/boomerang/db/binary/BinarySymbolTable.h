@@ -11,9 +11,11 @@
 
 
 #include "boomerang/util/Address.h"
+#include "boomerang/util/HashIndex.h"
 
-#include <map>
 #include <memory>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 
@@ -21,13 +23,15 @@ class BinarySymbol;
 
 
 /**
- * A simple class to implement a symbol table than can be looked up by address or by name.
+ * A symbol table than can be looked up by address or by name.
  *
- * \note Can't readily use operator[] overloaded for address and string parameters.
- * The main problem is that when you do symtab[0x100] = "main", the string map
- * doesn't see the string. If you have one of the maps be a pointer to the other string
- * and use a special comparison operator, then if the strings are ever changed,
- * then the map's internal rb-tree becomes invalid.
+ * Symbols are owned by the table and stored in creation order. Lookups by name and by
+ * address go through open addressing hash indices that only store symbol indices,
+ * so each symbol name is only stored once (in the symbol itself).
+ * For ordered queries, a list of symbols sorted by address is built lazily
+ * on first use after symbols have been added (i.e. usually once after loading).
+ * Building the list is synchronized, so const lookups may be done by multiple threads
+ * as long as no symbols are added or changed at the same time.
  */
 class BOOMERANG_API BinarySymbolTable
 {
@@ -41,12 +45,12 @@ class BOOMERANG_API BinarySymbolTable
 public:
     BinarySymbolTable();
     BinarySymbolTable(const BinarySymbolTable &other) = delete;
-    BinarySymbolTable(BinarySymbolTable &&other)      = default;
+    BinarySymbolTable(BinarySymbolTable &&other);
 
     ~BinarySymbolTable();
 
     BinarySymbolTable &operator=(const BinarySymbolTable &other) = delete;
-    BinarySymbolTable &operator=(BinarySymbolTable &&other) = default;
+    BinarySymbolTable &operator=(BinarySymbolTable &&other);
 
 public:
     iterator begin() { return m_symbolList.begin(); }
@@ -64,24 +68,60 @@ public:
     bool empty() const { return m_symbolList.empty(); }
     void clear();
 
+    /// Make sure \p numSymbols symbols can be stored without reallocation.
+    /// Loaders should call this before creating a large number of symbols.
+    void reserve(int numSymbols);
+
     /// Creates a symbol if it does not exist.
     BinarySymbol *createSymbol(Address addr, const QString &name, bool local = false);
 
+    /// Creates symbols for all (address, name) pairs of \p symbols.
+    /// \returns the number of symbols created.
+    int createSymbols(const std::vector<std::pair<Address, QString>> &symbols, bool local = false);
+
     BinarySymbol *findSymbolByAddress(Address addr);
     const BinarySymbol *findSymbolByAddress(Address addr) const;
 
     BinarySymbol *findSymbolByName(const QString &name);
     const BinarySymbol *findSymbolByName(const QString &name) const;
 
+    /**
+     * \returns the symbol with the highest address <= \p addr
+     * that contains \p addr, or nullptr if no such symbol exists.
+     * Symbols of size 0 only contain their own address.
+     */
+    const BinarySymbol *findSymbolContaining(Address addr) const;
+
     /// \returns true iff the rename was successful
     bool renameSymbol(const QString &oldName, const QString &newName);
 
 private:
-    /// The map indexed by address.
-    std::map<Address, std::shared_ptr<BinarySymbol>> m_addrIndex;
+    /// \returns the index of the symbol at address \p addr, or HashIndex::NOT_FOUND
+    int findAddrIndex(Address addr) const;
+
+    /// \returns the index of the non-local symbol with name \p name, or HashIndex::NOT_FOUND
+    int findNameIndex(const QString &name) const;
+
+    /// Sorts \ref m_sortedSymbols if symbols were added since the last sort.
+    void updateSortedSymbols() const;
+
+private:
+    /// All symbols, in creation order. Indices into this list are used by the indices below.
+    std::vector<std::unique_ptr<BinarySymbol>> m_symbols;
+
+    /// Addresses of the entries of \ref m_addrIndex.
+    /// Multiple addresses may map to the same symbol.
+    std::vector<std::pair<Address, int>> m_addrEntries;
+
+    /// Maps address hashes to indices into \ref m_addrEntries
+    HashIndex m_addrIndex;
+
+    /// Maps name hashes to indices into \ref m_symbols (non-local symbols only)
+    HashIndex m_nameIndex;
 
-    /// The map indexed by string. Note that the strings are stored twice.
-    std::map<QString, std::shared_ptr<BinarySymbol>> m_nameIndex;
+    /// Symbol indices sorted by symbol address; built on demand.
+    mutable std::vector<int> m_sortedSymbols;
+    mutable std::mutex m_sortedSymbolsMutex; ///< Guards updates of \ref m_sortedSymbols
 
     SymbolList m_symbolList;
 };
@@ -0,0 +1,247 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "BytePatternScanner.h"
+
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySection.h"
+
+#include <QStringList>
+
+#include <algorithm>
+#include <cstring>
+#include <queue>
+
+
+BytePatternScanner::BytePatternScanner()
+{
+}
+
+
+int BytePatternScanner::addPattern(const QString &pattern)
+{
+    std::vector<Byte> bytes, mask;
+
+    for (const QString &token : pattern.split(' ', QString::SkipEmptyParts)) {
+        if (token == "??") {
+            bytes.push_back(0x00);
+            mask.push_back(0x00);
+            continue;
+        }
+
+        bool ok;
+        const uint value = token.toUInt(&ok, 16);
+        if (!ok || token.length() != 2) {
+            return -1;
+        }
+
+        bytes.push_back(static_cast<Byte>(value));
+        mask.push_back(0xFF);
+    }
+
+    return addPattern(bytes, mask);
+}
+
+
+int BytePatternScanner::addPattern(const std::vector<Byte> &bytes, const std::vector<Byte> &mask)
+{
+    if (bytes.empty() || bytes.size() != mask.size()) {
+        return -1;
+    }
+
+    Pattern pattern;
+    pattern.mask = mask;
+    pattern.bytes.resize(bytes.size());
+
+    for (std::size_t i = 0; i < bytes.size(); i++) {
+        pattern.bytes[i] = bytes[i] & mask[i];
+    }
+
+    // find the longest run of fully specified bytes
+    int runStart = 0;
+    for (int i = 0; i <= static_cast<int>(mask.size()); i++) {
+        if (i < static_cast<int>(mask.size()) && mask[i] == 0xFF) {
+            continue;
+        }
+
+        if (i - runStart > pattern.anchorLength) {
+            pattern.anchorOffset = runStart;
+            pattern.anchorLength = i - runStart;
+        }
+
+        runStart = i + 1;
+    }
+
+    if (pattern.anchorLength == 0) {
+        return -1;
+    }
+
+    pattern.anchorLength = std::min(pattern.anchorLength, MAX_ANCHOR_LENGTH);
+
+    m_patterns.push_back(std::move(pattern));
+    m_dirty = true;
+    return getNumPatterns() - 1;
+}
+
+
+int BytePatternScanner::getPatternLength(int patternID) const
+{
+    return static_cast<int>(m_patterns[patternID].bytes.size());
+}
+
+
+void BytePatternScanner::build()
+{
+    m_next.assign(256, -1);
+    m_output.assign(1, {});
+
+    // Build the trie of all anchors
+    for (int id = 0; id < getNumPatterns(); id++) {
+        const Pattern &pattern = m_patterns[id];
+        int state              = 0;
+
+        for (int i = 0; i < pattern.anchorLength; i++) {
+            const Byte b = pattern.bytes[pattern.anchorOffset + i];
+
+            if (m_next[state * 256 + b] == -1) {
+                m_next[state * 256 + b] = static_cast<int>(m_output.size());
+                m_next.resize(m_next.size() + 256, -1);
+                m_output.emplace_back();
+            }
+
+            state = m_next[state * 256 + b];
+        }
+
+        m_output[state].push_back(id);
+    }
+
+    // Turn the trie into a DFA by following the failure links (breadth first)
+    std::vector<int> fail(m_output.size(), 0);
+    std::queue<int> queue;
+
+    for (int b = 0; b < 256; b++) {
+        int &next = m_next[b];
+        if (next == -1) {
+            next = 0;
+        }
+        else {
+            queue.push(next);
+        }
+    }
+
+    while (!queue.empty()) {
+        const int state = queue.front();
+        queue.pop();
+
+        const std::vector<int> &failOutput = m_output[fail[state]];
+        m_output[state].insert(m_output[state].end(), failOutput.begin(), failOutput.end());
+
+        for (int b = 0; b < 256; b++) {
+            int &next = m_next[state * 256 + b];
+
+            if (next == -1) {
+                next = m_next[fail[state] * 256 + b];
+            }
+            else {
+                fail[next] = m_next[fail[state] * 256 + b];
+                queue.push(next);
+            }
+        }
+    }
+
+    m_firstByte = -1;
+    for (int b = 0; b < 256; b++) {
+        if (m_next[b] != 0) {
+            if (m_firstByte != -1) {
+                m_firstByte = -1;
+                break;
+            }
+
+            m_firstByte = b;
+        }
+    }
+
+    m_dirty = false;
+}
+
+
+bool BytePatternScanner::matchesAt(const Pattern &pattern, const Byte *data) const
+{
+    for (std::size_t i = 0; i < pattern.bytes.size(); i++) {
+        if ((data[i] & pattern.mask[i]) != pattern.bytes[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+void BytePatternScanner::scan(const Byte *data, std::size_t size, Address base,
+                              std::vector<Match> &matches)
+{
+    if (m_patterns.empty() || data == nullptr) {
+        return;
+    }
+    else if (m_dirty) {
+        build();
+    }
+
+    int state = 0;
+
+    for (std::size_t pos = 0; pos < size; pos++) {
+        if (state == 0 && m_firstByte != -1) {
+            // Nothing matched so far; skip to the next possible start of an anchor
+            const void *next = std::memchr(data + pos, m_firstByte, size - pos);
+            if (!next) {
+                break;
+            }
+
+            pos = static_cast<const Byte *>(next) - data;
+        }
+
+        state = m_next[state * 256 + data[pos]];
+
+        for (int id : m_output[state]) {
+            const Pattern &pattern         = m_patterns[id];
+            const std::size_t anchorEnd    = pos + 1;
+            const std::size_t prefixLength = pattern.anchorOffset + pattern.anchorLength;
+
+            if (anchorEnd < prefixLength) {
+                continue; // pattern would start before the data
+            }
+
+            const std::size_t start = anchorEnd - prefixLength;
+            if (start + pattern.bytes.size() <= size && matchesAt(pattern, data + start)) {
+                matches.push_back({ id, base + start });
+            }
+        }
+    }
+}
+
+
+std::vector<BytePatternScanner::Match> BytePatternScanner::scanCode(const BinaryImage *image)
+{
+    std::vector<Match> matches;
+
+    for (const BinarySection *section : *image) {
+        if (!section->isCode() || section->getHostAddr() == HostAddress::INVALID) {
+            continue;
+        }
+
+        scan(reinterpret_cast<const Byte *>(section->getHostAddr().value()), section->getSize(),
+             section->getSourceAddr(), matches);
+    }
+
+    std::sort(matches.begin(), matches.end(), [](const Match &a, const Match &b) {
+        return a.addr < b.addr || (a.addr == b.addr && a.patternID < b.patternID);
+    });
+
+    return matches;
+}
@@ -0,0 +1,102 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/util/Address.h"
+#include "boomerang/util/Types.h"
+
+#include <QString>
+
+#include <vector>
+
+
+class BinaryImage;
+
+
+/**
+ * Finds all occurrences of a set of byte patterns with wildcards in a single pass over the data.
+ *
+ * For each pattern, the longest run of non-wildcard bytes (up to \ref MAX_ANCHOR_LENGTH bytes)
+ * is used as the anchor of the pattern. The anchors of all patterns are matched simultaneously
+ * by an Aho-Corasick automaton; the full pattern is only compared at candidate positions.
+ * Bytes that cannot start an anchor are skipped with memchr if possible.
+ */
+class BOOMERANG_API BytePatternScanner
+{
+public:
+    /// Maximum length of the anchor of a pattern in bytes
+    static constexpr int MAX_ANCHOR_LENGTH = 8;
+
+    struct Match
+    {
+        int patternID;
+        Address addr;
+    };
+
+public:
+    BytePatternScanner();
+
+public:
+    /**
+     * Add a pattern given in textual form, e.g. "FF 25 ?? ?? ?? ??".
+     * Each byte is given by 2 hexadecimal digits, "??" matches any byte.
+     * \returns the ID of the new pattern, or -1 if the pattern is invalid
+     * or does not contain any non-wildcard byte.
+     */
+    int addPattern(const QString &pattern);
+
+    /**
+     * Add a pattern matching all byte sequences s where (s[i] & mask[i]) == (bytes[i] & mask[i]).
+     * \returns the ID of the new pattern, or -1 if the pattern is invalid
+     * or does not contain any non-wildcard byte.
+     */
+    int addPattern(const std::vector<Byte> &bytes, const std::vector<Byte> &mask);
+
+    /// \returns the number of patterns added to this scanner.
+    int getNumPatterns() const { return static_cast<int>(m_patterns.size()); }
+
+    /// \returns the length of the pattern with ID \p patternID in bytes.
+    int getPatternLength(int patternID) const;
+
+    /**
+     * Find all matches of all patterns in the \p size bytes at \p data.
+     * \param base the address of the first byte
+     * \param matches receives the matches in the order of their end positions
+     */
+    void scan(const Byte *data, std::size_t size, Address base, std::vector<Match> &matches);
+
+    /// Find all matches of all patterns in the code sections of \p image.
+    /// \returns the matches, sorted by address.
+    std::vector<Match> scanCode(const BinaryImage *image);
+
+private:
+    struct Pattern
+    {
+        std::vector<Byte> bytes; ///< pattern bytes, with wildcard bits cleared
+        std::vector<Byte> mask;
+        int anchorOffset = 0;
+        int anchorLength = 0;
+    };
+
+    /// Build the automaton from all anchors.
+    void build();
+
+    /// \returns true if \p pattern matches at \p data.
+    bool matchesAt(const Pattern &pattern, const Byte *data) const;
+
+private:
+    std::vector<Pattern> m_patterns;
+
+    bool m_dirty = true; ///< true if patterns were added since the automaton was built
+    std::vector<int> m_next;                ///< transitions, indexed by state * 256 + byte
+    std::vector<std::vector<int>> m_output; ///< patterns whose anchor ends in the state
+    int m_firstByte = -1; ///< the only byte that can start an anchor, or -1 if there are more
+};
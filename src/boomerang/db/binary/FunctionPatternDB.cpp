@@ -0,0 +1,306 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "FunctionPatternDB.h"
+
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySection.h"
+#include "boomerang/db/binary/BinarySymbol.h"
+#include "boomerang/db/binary/BinarySymbolTable.h"
+#include "boomerang/util/OStream.h"
+#include "boomerang/util/log/Log.h"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QStringList>
+#include <QTextStream>
+
+#include <algorithm>
+#include <map>
+
+
+FunctionPatternDB::FunctionPatternDB()
+{
+}
+
+
+bool FunctionPatternDB::readPatternFile(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly | QFile::Text)) {
+        LOG_ERROR("Cannot open pattern file '%1'", fileName);
+        return false;
+    }
+
+    QTextStream ist(&file);
+    int lineNum = 0;
+
+    while (!ist.atEnd()) {
+        const QString line = ist.readLine().trimmed();
+        lineNum++;
+
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+
+        const QStringList fields = line.split(' ', QString::SkipEmptyParts);
+        bool sizeOk = false, crcLengthOk = false, crcOk = false;
+
+        if (fields.size() == 5) {
+            const int size      = fields[1].toInt(&sizeOk, 16);
+            const int crcLength = fields[2].toInt(&crcLengthOk, 16);
+            const uint crc      = fields[3].toUInt(&crcOk, 16);
+
+            if (sizeOk && crcLengthOk && crcOk && crc <= 0xFFFF &&
+                addPattern(fields[0], size, crcLength, static_cast<SWord>(crc), fields[4])) {
+                continue;
+            }
+        }
+
+        LOG_ERROR("Invalid pattern in pattern file '%1', line %2", fileName, lineNum);
+        return false;
+    }
+
+    return true;
+}
+
+
+bool FunctionPatternDB::addPattern(const QString &hexPattern, int size, int crcLength, SWord crc,
+                                   const QString &name)
+{
+    if (name.isEmpty() || hexPattern.isEmpty() || hexPattern.length() % 2 != 0 ||
+        hexPattern.length() > 2 * PATTERN_LENGTH) {
+        return false;
+    }
+
+    const int patternLength = hexPattern.length() / 2;
+    if (crcLength < 0 || crcLength > MAX_CRC_LENGTH || size < patternLength + crcLength) {
+        return false;
+    }
+
+    std::vector<Byte> bytes, mask;
+    int numFixed = 0;
+
+    for (int i = 0; i < hexPattern.length(); i += 2) {
+        const QString token = hexPattern.mid(i, 2);
+
+        if (token == "..") {
+            bytes.push_back(0x00);
+            mask.push_back(0x00);
+            continue;
+        }
+
+        bool ok;
+        const uint value = token.toUInt(&ok, 16);
+        if (!ok) {
+            return false;
+        }
+
+        bytes.push_back(static_cast<Byte>(value));
+        mask.push_back(0xFF);
+        numFixed++;
+    }
+
+    if (numFixed < MIN_FIXED_BYTES || m_scanner.addPattern(bytes, mask) == -1) {
+        return false;
+    }
+
+    m_functions.push_back({ name, patternLength, size, crcLength, crc });
+    return true;
+}
+
+
+int FunctionPatternDB::identifyFunctions(const BinaryImage *image, BinarySymbolTable *symbols,
+                                         const std::set<Address> &functionStarts)
+{
+    if (m_functions.empty() || functionStarts.empty()) {
+        return 0;
+    }
+
+    // The function identified at each address, or nullptr if ambiguous
+    std::map<Address, const LibraryFunction *> functions;
+    std::map<QString, int> numMatches;
+
+    for (const BytePatternScanner::Match &match : m_scanner.scanCode(image)) {
+        const LibraryFunction &func = m_functions[match.patternID];
+
+        // The pattern only covers the start of the function; matches in the middle
+        // of other code or in data embedded in code sections are not functions.
+        if (functionStarts.find(match.addr) == functionStarts.end() ||
+            !matchesCRC(image, match.addr, func)) {
+            continue;
+        }
+
+        auto it = functions.find(match.addr);
+
+        if (it == functions.end()) {
+            functions[match.addr] = &func;
+            numMatches[func.name]++;
+        }
+        else if (it->second && it->second->name != func.name) {
+            numMatches[it->second->name]--;
+            it->second = nullptr;
+        }
+    }
+
+    int numIdentified = 0;
+
+    for (const auto &[addr, func] : functions) {
+        if (!func || numMatches[func->name] != 1 || symbols->findSymbolByAddress(addr) ||
+            symbols->findSymbolByName(func->name)) {
+            continue;
+        }
+
+        BinarySymbol *sym = symbols->createSymbol(addr, func->name);
+        sym->setSize(func->size);
+        sym->setAttribute("Function", true);
+        sym->setAttribute("StaticFunction", true);
+
+        LOG_VERBOSE("Identified library function '%1' at address %2", func->name, addr);
+        numIdentified++;
+    }
+
+    return numIdentified;
+}
+
+
+int FunctionPatternDB::writePatternFile(const BinaryImage *image,
+                                        const BinarySymbolTable *symbols,
+                                        const QString &fileName)
+{
+    QSaveFile file(fileName);
+    if (!file.open(QFile::WriteOnly | QFile::Text)) {
+        LOG_ERROR("Cannot write pattern file '%1'", fileName);
+        return -1;
+    }
+
+    OStream ost(&file);
+    ost << "# Boomerang library function patterns\n";
+
+    int numPatterns = 0;
+
+    for (const BinarySymbol *sym : *symbols) {
+        const Address addr           = sym->getLocation();
+        const BinarySection *section = image->getSectionByAddr(addr);
+
+        if (!sym->isFunction() || sym->isImportedFunction() || sym->getName().isEmpty() ||
+            sym->getName().contains(' ') || !section || !section->isCode() ||
+            section->getHostAddr() == HostAddress::INVALID) {
+            continue;
+        }
+
+        // Without the size, the CRC might include bytes of the next function
+        const Address sectionEnd = section->getSourceAddr() + section->getSize();
+        const int size           = sym->getSize();
+
+        if (size <= 0 || addr + size > sectionEnd) {
+            continue;
+        }
+
+        std::vector<Byte> bytes(size);
+        if (image->readNative1(addr, bytes.data(), size) != static_cast<std::size_t>(size)) {
+            continue;
+        }
+
+        const int length = std::min(size, PATTERN_LENGTH);
+
+        QString pattern;
+        int numFixed = 0;
+
+        for (int i = 0; i < length; i++) {
+            if (image->isRelocationAt(addr + i)) {
+                const int relocLength = std::min(4, length - i);
+                pattern += QString("..").repeated(relocLength);
+                i += relocLength - 1;
+                continue;
+            }
+
+            pattern += QString("%1").arg(bytes[i], 2, 16, QChar('0')).toUpper();
+            numFixed++;
+        }
+
+        if (numFixed < MIN_FIXED_BYTES) {
+            continue;
+        }
+
+        // The CRC ends before the first relocated byte after the pattern,
+        // including relocations that start at the end of the pattern.
+        int crcLength = 0;
+        while (length + crcLength < size && crcLength < MAX_CRC_LENGTH) {
+            const int offset = length + crcLength;
+            bool isRelocated = false;
+
+            for (int i = std::max(0, offset - 3); i <= offset; i++) {
+                isRelocated |= image->isRelocationAt(addr + i);
+            }
+
+            if (isRelocated) {
+                break;
+            }
+
+            crcLength++;
+        }
+
+        const SWord crc = crc16(bytes.data() + length, crcLength);
+
+        ost << pattern << " " << QString("%1").arg(size, 4, 16, QChar('0')).toUpper() << " "
+            << QString("%1").arg(crcLength, 2, 16, QChar('0')).toUpper() << " "
+            << QString("%1").arg(crc, 4, 16, QChar('0')).toUpper() << " " << sym->getName()
+            << "\n";
+        numPatterns++;
+    }
+
+    ost.flush();
+    if (!file.commit()) {
+        LOG_ERROR("Cannot write pattern file '%1'", fileName);
+        return -1;
+    }
+
+    return numPatterns;
+}
+
+
+SWord FunctionPatternDB::crc16(const Byte *data, std::size_t count)
+{
+    SWord crc = 0xFFFF;
+
+    for (std::size_t i = 0; i < count; i++) {
+        Byte value = data[i];
+
+        for (int bit = 0; bit < 8; bit++, value >>= 1) {
+            const bool carry = ((crc ^ value) & 1) != 0;
+            crc >>= 1;
+
+            if (carry) {
+                crc ^= 0x8408;
+            }
+        }
+    }
+
+    crc = ~crc;
+    return static_cast<SWord>((crc << 8) | (crc >> 8));
+}
+
+
+bool FunctionPatternDB::matchesCRC(const BinaryImage *image, Address addr,
+                                   const LibraryFunction &func)
+{
+    // The whole function must be inside the section of its start
+    const BinarySection *section = image->getSectionByAddr(addr);
+    if (!section || addr + func.size > section->getSourceAddr() + section->getSize()) {
+        return false;
+    }
+
+    Byte bytes[MAX_CRC_LENGTH];
+    const std::size_t numRead = image->readNative1(addr + func.patternLength, bytes,
+                                                   func.crcLength);
+
+    return numRead == static_cast<std::size_t>(func.crcLength) &&
+           crc16(bytes, func.crcLength) == func.crc;
+}
@@ -0,0 +1,119 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/db/binary/BytePatternScanner.h"
+
+#include <QString>
+
+#include <set>
+#include <vector>
+
+
+class BinaryImage;
+class BinarySymbolTable;
+
+
+/**
+ * A database of the byte patterns of the first bytes of library functions,
+ * used to identify statically linked library functions (similar to FLIRT).
+ *
+ * Pattern files contain one pattern per line: The first \ref PATTERN_LENGTH bytes
+ * of the function as hexadecimal digits, with ".." for bytes that are relocated
+ * or otherwise variable, followed by the size of the function, the number of bytes
+ * after the pattern that are covered by the CRC, the CRC-16 of these bytes
+ * (all in hexadecimal) and the name of the function, e.g.
+ *   5589E583EC08C70424........E8........C9C3 0014 00 0000 exit
+ * The CRC covers the bytes after the pattern up to the end of the function
+ * or the first relocated byte, but at most \ref MAX_CRC_LENGTH bytes.
+ * Lines starting with '#' are comments.
+ *
+ * Pattern files can be created from a binary with symbols
+ * (see boomerang-cli --create-patterns).
+ */
+class BOOMERANG_API FunctionPatternDB
+{
+public:
+    /// Maximum length of a pattern in bytes
+    static constexpr int PATTERN_LENGTH = 32;
+
+    /// Patterns with fewer non-wildcard bytes are too likely to match
+    /// non-library code and are rejected.
+    static constexpr int MIN_FIXED_BYTES = 8;
+
+    /// Maximum number of bytes after the pattern covered by the CRC
+    static constexpr int MAX_CRC_LENGTH = 0xFF;
+
+public:
+    FunctionPatternDB();
+
+public:
+    /// Read all patterns from the pattern file \p fileName.
+    /// \returns false if the file cannot be read or contains an invalid pattern.
+    bool readPatternFile(const QString &fileName);
+
+    /**
+     * Add the pattern for the library function \p name.
+     * \param hexPattern the pattern bytes in the format of pattern files
+     * \param size       size of the whole function in bytes
+     * \param crcLength  number of bytes after the pattern covered by \p crc
+     * \param crc        CRC-16 of the \p crcLength bytes after the pattern
+     * \returns false if the pattern is invalid or not specific enough.
+     */
+    bool addPattern(const QString &hexPattern, int size, int crcLength, SWord crc,
+                    const QString &name);
+
+    /// \returns the number of patterns in the database.
+    int getNumPatterns() const { return static_cast<int>(m_functions.size()); }
+
+    /**
+     * Search the code sections of \p image for the patterns of the database
+     * and create a static function symbol for each identified library function.
+     * A function is only identified if the pattern matches at one of \p functionStarts
+     * (e.g. entry points and call targets), the CRC of the bytes after the pattern matches
+     * and the whole function fits into the section.
+     * Matches at addresses that already have a symbol, ambiguous matches
+     * (different functions at the same address) and functions matching
+     * at more than one address are ignored.
+     *
+     * \returns the number of identified library functions.
+     */
+    int identifyFunctions(const BinaryImage *image, BinarySymbolTable *symbols,
+                          const std::set<Address> &functionStarts);
+
+    /**
+     * Write the patterns of all functions in \p symbols to the pattern file \p fileName.
+     * Relocated bytes are replaced by wildcards. Functions of unknown size are skipped.
+     * \returns the number of patterns written, or -1 if the file cannot be written.
+     */
+    static int writePatternFile(const BinaryImage *image, const BinarySymbolTable *symbols,
+                                const QString &fileName);
+
+    /// \returns the CRC-16 (CCITT, as used by FLIRT) of \p count bytes at \p data
+    static SWord crc16(const Byte *data, std::size_t count);
+
+private:
+    struct LibraryFunction
+    {
+        QString name;
+        int patternLength;
+        int size;
+        int crcLength;
+        SWord crc;
+    };
+
+    /// \returns true if the bytes after the pattern of \p func at \p addr match its CRC.
+    static bool matchesCRC(const BinaryImage *image, Address addr, const LibraryFunction &func);
+
+private:
+    BytePatternScanner m_scanner;
+    std::vector<LibraryFunction> m_functions; ///< indexed by pattern ID
+};
@@ -44,7 +44,25 @@ QString Function::getName() const
 void Function::setName(const QString &name)
 {
     assert(m_signature);
+    const bool wasIndexed = m_prog && m_prog->removeFunctionFromIndex(this);
+
     m_signature->setName(name);
+
+    if (wasIndexed) {
+        m_prog->addFunctionToIndex(this);
+    }
+}
+
+
+void Function::setSignature(std::shared_ptr<Signature> sig)
+{
+    const bool wasIndexed = m_prog && m_signature && m_prog->removeFunctionFromIndex(this);
+
+    m_signature = sig;
+
+    if (wasIndexed) {
+        m_prog->addFunctionToIndex(this);
+    }
 }
 
 
@@ -56,12 +74,18 @@ Address Function::getEntryAddress() const
 
 void Function::setEntryAddress(Address entryAddr)
 {
+    const bool wasIndexed = m_prog && m_prog->removeFunctionFromIndex(this);
+
     if (m_module) {
         m_module->setLocationMap(m_entryAddress, nullptr);
         m_module->setLocationMap(entryAddr, this);
     }
 
     m_entryAddress = entryAddr;
+
+    if (wasIndexed) {
+        m_prog->addFunctionToIndex(this);
+    }
 }
 
 
@@ -91,6 +115,10 @@ void Function::setModule(Module *module)
     if (module) {
         module->getFunctionList().push_back(this);
         module->setLocationMap(m_entryAddress, this);
+
+        if (m_prog) {
+            m_prog->addFunctionToIndex(this);
+        }
     }
 }
 
@@ -100,6 +128,10 @@ void Function::removeFromModule()
     assert(m_module);
     m_module->getFunctionList().remove(this);
     m_module->setLocationMap(m_entryAddress, nullptr);
+
+    if (m_prog) {
+        m_prog->removeFunctionFromIndex(this);
+    }
 }
 
 
@@ -73,7 +73,7 @@ public:
     void removeFromModule();
 
     std::shared_ptr<Signature> getSignature() const { return m_signature; }
-    void setSignature(std::shared_ptr<Signature> sig) { m_signature = sig; }
+    void setSignature(std::shared_ptr<Signature> sig);
 
     /// \returns the call statements that call this function.
     const std::set<CallStatement *> &getCallers() const { return m_callers; }
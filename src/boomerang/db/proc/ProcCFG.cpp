@@ -19,6 +19,7 @@
 
 #include <QtAlgorithms>
 
+#include <algorithm>
 #include <cassert>
 
 
@@ -203,19 +204,7 @@ BasicBlock *ProcCFG::createIncompleteBB(Address lowAddr)
 bool ProcCFG::ensureBBExists(Address addr, BasicBlock *&currBB)
 {
     // check for overlapping incomplete or complete BBs.
-    BBStartMap::iterator itExistingBB = m_bbStartMap.lower_bound(addr);
-
-    BasicBlock *overlappingBB = nullptr;
-    if (itExistingBB != m_bbStartMap.end() && itExistingBB->second->getLowAddr() == addr) {
-        overlappingBB = itExistingBB->second;
-    }
-    else if (itExistingBB != m_bbStartMap.begin()) {
-        --itExistingBB;
-        if (itExistingBB->second->getLowAddr() <= addr &&
-            itExistingBB->second->getHiAddr() >= addr) {
-            overlappingBB = itExistingBB->second;
-        }
-    }
+    BasicBlock *overlappingBB = getBBContaining(addr);
 
     if (!overlappingBB) {
         // no BB at addr -> create a new incomplete BB
@@ -245,6 +234,32 @@ bool ProcCFG::ensureBBExists(Address addr, BasicBlock *&currBB)
 }
 
 
+BasicBlock *ProcCFG::getBBContaining(Address addr)
+{
+    return const_cast<BasicBlock *>(static_cast<const ProcCFG *>(this)->getBBContaining(addr));
+}
+
+
+const BasicBlock *ProcCFG::getBBContaining(Address addr) const
+{
+    // The only BB that can contain addr is the last one starting at or before addr.
+    BBStartMap::const_iterator it = m_bbStartMap.upper_bound(addr);
+    if (it == m_bbStartMap.begin()) {
+        return nullptr;
+    }
+
+    --it;
+    const BasicBlock *bb = it->second;
+
+    if (it->first == addr) {
+        return bb;
+    }
+
+    // Incomplete BBs do not contain any instructions yet
+    return (!bb->isIncomplete() && bb->getHiAddr() >= addr) ? bb : nullptr;
+}
+
+
 bool ProcCFG::isStartOfBB(Address addr) const
 {
     return getBBStartingAt(addr) != nullptr;
@@ -469,17 +484,30 @@ void ProcCFG::removeImplicitAssign(SharedExp x)
 
 BasicBlock *ProcCFG::splitBB(BasicBlock *bb, Address splitAddr, BasicBlock *_newBB /* = 0 */)
 {
-    RTLList::iterator splitIt;
+    RTLList *rtls             = bb->getRTLs();
+    RTLList::iterator splitIt = rtls->end();
 
     // First find which RTL has the split address; note that this could fail
-    // (e.g. jump into the middle of an instruction, or some weird delay slot effects)
-    for (splitIt = bb->getRTLs()->begin(); splitIt != bb->getRTLs()->end(); ++splitIt) {
-        if ((*splitIt)->getAddress() == splitAddr) {
-            break;
+    // (e.g. jump into the middle of an instruction, or some weird delay slot effects).
+    // The RTLs are sorted by address, so search from the nearer end of the BB.
+    if (splitAddr - bb->getLowAddr() <= bb->getHiAddr() - splitAddr) {
+        splitIt = std::find_if(rtls->begin(), rtls->end(),
+                               [splitAddr](const std::unique_ptr<RTL> &rtl) {
+                                   return rtl->getAddress() == splitAddr;
+                               });
+    }
+    else {
+        auto rit = std::find_if(rtls->rbegin(), rtls->rend(),
+                                [splitAddr](const std::unique_ptr<RTL> &rtl) {
+                                    return rtl->getAddress() == splitAddr;
+                                });
+
+        if (rit != rtls->rend()) {
+            splitIt = std::prev(rit.base());
         }
     }
 
-    if (splitIt == bb->getRTLs()->end()) {
+    if (splitIt == rtls->end()) {
         LOG_WARN("Cannot split BB at address %1 at split address %2", bb->getLowAddr(), splitAddr);
         return bb;
     }
@@ -487,9 +515,7 @@ BasicBlock *ProcCFG::splitBB(BasicBlock *bb, Address splitAddr, BasicBlock *_new
     if (_newBB && !_newBB->isIncomplete()) {
         // we already have a BB for the high part. Delete overlapping RTLs and adjust edges.
 
-        while (splitIt != bb->getRTLs()->end()) {
-            splitIt = bb->getRTLs()->erase(splitIt); // deletes RTLs
-        }
+        rtls->erase(splitIt, rtls->end()); // deletes RTLs
 
         bb->updateBBAddresses();
         _newBB->updateBBAddresses();
@@ -512,13 +538,10 @@ BasicBlock *ProcCFG::splitBB(BasicBlock *bb, Address splitAddr, BasicBlock *_new
     // Now we have an incomplete BB at splitAddr;
     // just complete it with the "high" RTLs from the original BB.
     // We don't want to "deep copy" the RTLs themselves,
-    // because we want to transfer ownership from the original BB to the "high" part
+    // because we want to transfer ownership from the original BB to the "high" part.
+    // Splicing moves the list nodes without touching the RTLs.
     std::unique_ptr<RTLList> highRTLs(new RTLList);
-    for (RTLList::iterator it = splitIt; it != bb->getRTLs()->end();) {
-        highRTLs->push_back(std::move(*it));
-        assert(*it == nullptr);
-        it = bb->getRTLs()->erase(it);
-    }
+    highRTLs->splice(highRTLs->end(), *rtls, splitIt, rtls->end());
 
     _newBB->setRTLs(std::move(highRTLs));
     bb->updateBBAddresses();
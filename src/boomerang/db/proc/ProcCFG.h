@@ -136,6 +136,16 @@ public:
         return (it != m_bbStartMap.end()) ? (*it).second : nullptr;
     }
 
+    /**
+     * Get the complete BasicBlock containing the instruction at \p addr,
+     * or the (complete or incomplete) BasicBlock starting at \p addr.
+     * If there is no such block, return nullptr.
+     * Since BBs do not overlap, the start map serves as an interval index,
+     * so this takes logarithmic time in the number of BBs.
+     */
+    BasicBlock *getBBContaining(Address addr);
+    const BasicBlock *getBBContaining(Address addr) const;
+
     inline const BasicBlock *getBBStartingAt(Address addr) const
     {
         BBStartMap::const_iterator it = m_bbStartMap.find(addr);
@@ -112,9 +112,10 @@ bool UserProc::isPreserved(SharedExp e)
 void UserProc::setStatus(ProcStatus s)
 {
     if (m_status != s) {
-        m_status = s;
+        const ProcStatus oldStatus = m_status;
+        m_status                   = s;
         if (m_prog) {
-            m_prog->getProject()->alertProcStatusChanged(this);
+            m_prog->getProject()->alertProcStatusChanged(this, oldStatus);
         }
     }
 }
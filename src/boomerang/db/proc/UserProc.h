@@ -114,6 +114,11 @@ public:
     /// Records that this procedure has been decoded.
     void setDecoded();
 
+    /// \returns true if this procedure exceeded its decompilation budget
+    /// and was decompiled with a cheaper pipeline.
+    bool isDegraded() const { return m_degraded; }
+    void setDegraded(bool degraded) { m_degraded = degraded; }
+
     bool isEarlyRecursive() const
     {
         return m_recursionGroup != nullptr && m_status <= PROC_INCYCLE;
@@ -383,6 +388,7 @@ private:
      * Status: undecoded .. final decompiled
      */
     ProcStatus m_status = PROC_UNDECODED;
+    bool m_degraded     = false; ///< True if the decompilation budget was exceeded
     int m_nextLocal     = 0; ///< Number of the next local. Can't use locals.size() because some get
                              ///< deleted
 
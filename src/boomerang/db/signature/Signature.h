@@ -37,6 +37,8 @@ class Exp;
  */
 class BOOMERANG_API Signature : public std::enable_shared_from_this<Signature>
 {
+    friend class SerialReader;
+
 public:
     Signature(const QString &name);
     Signature(const Signature &other) = default;
@@ -12,6 +12,8 @@
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
 #include "boomerang/db/Prog.h"
+#include "boomerang/db/binary/BinaryFile.h"
+#include "boomerang/db/binary/BinaryImage.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/ssl/RTL.h"
 #include "boomerang/ssl/exp/Binary.h"
@@ -347,27 +349,28 @@ bool IndirectJumpAnalyzer::decodeIndirectJmp(BasicBlock *bb, UserProc *proc)
                 // TMN: Added actual control of the array members, to possibly truncate what
                 // findNumCases() thinks is the number of cases, when finding the first array
                 // element not pointing to code.
-                if (switchType == SwitchType::A) {
-                    const Prog *prog = proc->getProg();
-
-                    for (int entryIdx = 0; entryIdx < swi->numTableEntries; ++entryIdx) {
-                        Address switchEntryAddr = Address(
-                            prog->readNative4(swi->tableAddr + entryIdx * 4));
-
-                        if (!Util::inRange(switchEntryAddr, prog->getLimitTextLow(),
-                                           prog->getLimitTextHigh())) {
-                            if (proc->getProg()->getProject()->getSettings()->debugSwitch) {
-                                LOG_MSG("Truncating type A indirect jump array to %1 entries "
-                                        "due to finding an array entry pointing outside valid "
-                                        "code; %2 isn't in %3..%4",
-                                        entryIdx, switchEntryAddr, prog->getLimitTextLow(),
-                                        prog->getLimitTextHigh());
-                            }
-
-                            // Found an array that isn't a pointer-to-code. Assume array has ended.
-                            swi->numTableEntries = entryIdx;
-                            break;
+                if (switchType == SwitchType::A && swi->numTableEntries > 0) {
+                    const Prog *prog         = proc->getProg();
+                    const BinaryImage *image = prog->getBinaryFile()->getImage();
+
+                    const int numValidEntries = static_cast<int>(image->countPointersInRange(
+                        swi->tableAddr, swi->numTableEntries, 4, prog->getLimitTextLow(),
+                        prog->getLimitTextHigh()));
+
+                    if (numValidEntries < swi->numTableEntries) {
+                        if (proc->getProg()->getProject()->getSettings()->debugSwitch) {
+                            const Address switchEntryAddr = Address(
+                                prog->readNative4(swi->tableAddr + numValidEntries * 4));
+
+                            LOG_MSG("Truncating type A indirect jump array to %1 entries "
+                                    "due to finding an array entry pointing outside valid "
+                                    "code; %2 isn't in %3..%4",
+                                    numValidEntries, switchEntryAddr, prog->getLimitTextLow(),
+                                    prog->getLimitTextHigh());
                         }
+
+                        // Found an array that isn't a pointer-to-code. Assume array has ended.
+                        swi->numTableEntries = numValidEntries;
                     }
                 }
 
@@ -735,6 +738,16 @@ void IndirectJumpAnalyzer::processSwitch(BasicBlock *bb, UserProc *proc)
     // be a goto to the code for case 3, but a smarter back end could group them
     std::list<Address> dests;
 
+    // Read plain and offset tables in one go instead of entry by entry.
+    // Entries that cannot be read are 0, like with Prog::readNative4.
+    std::vector<DWord> tableEntries;
+
+    if (si->switchType != SwitchType::H && si->switchType != SwitchType::F && numCases > 0) {
+        tableEntries.resize(numCases, 0);
+        prog->getBinaryFile()->getImage()->readNative4(si->tableAddr, tableEntries.data(),
+                                                       tableEntries.size());
+    }
+
     for (int i = 0; i < numCases; i++) {
         // Get the destination address from the switch table.
         if (si->switchType == SwitchType::H) {
@@ -751,8 +764,14 @@ void IndirectJumpAnalyzer::processSwitch(BasicBlock *bb, UserProc *proc)
                 si->tableAddr.value());
             switchDestination = Address(entry[i]);
         }
+        else if ((si->switchType == SwitchType::O) || (si->switchType == SwitchType::R) ||
+                 (si->switchType == SwitchType::r)) {
+            // sign extend, table entries are offsets that may be negative
+            switchDestination = Address(static_cast<sint32>(tableEntries[i]));
+        }
         else {
-            switchDestination = Address(prog->readNative4(si->tableAddr + i * 4));
+            // absolute address
+            switchDestination = Address(tableEntries[i]);
         }
 
         if ((si->switchType == SwitchType::O) || (si->switchType == SwitchType::R) ||
@@ -21,6 +21,7 @@
 #include "boomerang/ssl/statements/ReturnStatement.h"
 #include "boomerang/util/log/Log.h"
 #include "boomerang/util/log/SeparateLogger.h"
+#include "boomerang/util/log/Trace.h"
 
 
 ProcDecompiler::ProcDecompiler()
@@ -328,6 +329,9 @@ void ProcDecompiler::addToRecursionGroup(UserProc *proc,
 
 void ProcDecompiler::earlyDecompile(UserProc *proc)
 {
+    TRACE_SPAN("Early decompile", proc);
+    ProcTimeScope timeScope(this, proc);
+
     Project *project = proc->getProg()->getProject();
 
     project->alertStartDecompile(proc);
@@ -369,6 +373,9 @@ void ProcDecompiler::earlyDecompile(UserProc *proc)
 
 void ProcDecompiler::middleDecompile(UserProc *proc)
 {
+    TRACE_SPAN("Middle decompile", proc);
+    ProcTimeScope timeScope(this, proc);
+
     assert(m_callStack.back() == proc);
     Project *project = proc->getProg()->getProject();
 
@@ -394,7 +401,9 @@ void ProcDecompiler::middleDecompile(UserProc *proc)
     // naming of locals so you are alias conservative. But of course some locals are ebp (etc)
     // based, and so these will never be correct until all the registers have preservation analysis
     // done. So I may as well do them all together here.
-    PassManager::get()->executePass(PassID::PreservationAnalysis, proc);
+    if (!isOverBudget(proc)) {
+        PassManager::get()->executePass(PassID::PreservationAnalysis, proc);
+    }
     PassManager::get()->executePass(PassID::CallAndPhiFix, proc); // Propagate and bypass sp
 
     proc->debugPrintAll("After preservation, bypass and propagation");
@@ -433,7 +442,8 @@ void ProcDecompiler::middleDecompile(UserProc *proc)
     PassManager::get()->executePass(PassID::StrengthReductionReversal, proc);
 
     // Repeat until no change
-    int pass = 3;
+    int pass      = 3;
+    int numPasses = 0;
 
     do {
         // Redo the renaming process to take into account the arguments
@@ -464,7 +474,7 @@ void ProcDecompiler::middleDecompile(UserProc *proc)
         // (* Was: mapping expressions to Parameters as we go *)
 
         // FIXME: Check if this is needed any more. At least fib seems to need it at present.
-        if (project->getSettings()->changeSignatures) {
+        if (project->getSettings()->changeSignatures && !proc->isDegraded()) {
             // addNewReturns(depth);
             for (int i = 0; i < 3; i++) { // FIXME: should be iterate until no change
                 LOG_VERBOSE("### update returns loop iteration %1 ###", i);
@@ -501,7 +511,7 @@ void ProcDecompiler::middleDecompile(UserProc *proc)
 
         // this is just to make it readable, do NOT rely on these statements being removed
         PassManager::get()->executePass(PassID::AssignRemoval, proc);
-    } while (change && ++pass < 12);
+    } while (change && ++pass < 12 && !isOverBudget(proc, ++numPasses));
 
     // At this point, there will be some memofs that have still not been renamed. They have been
     // prevented from getting renamed so that they didn't get renamed incorrectly (usually as {-}),
@@ -530,12 +540,15 @@ void ProcDecompiler::middleDecompile(UserProc *proc)
         // mapExpressionsToParameters();
     }
 
-    // Check for indirect jumps or calls not already removed by propagation of constants
+    // Check for indirect jumps or calls not already removed by propagation of constants.
+    // Degraded procedures are not restarted, since this would likely exceed the budget again.
     bool changed = false;
     IndirectJumpAnalyzer analyzer;
 
-    for (BasicBlock *bb : *proc->getCFG()) {
-        changed |= analyzer.decodeIndirectJmp(bb, proc);
+    if (!isOverBudget(proc)) {
+        for (BasicBlock *bb : *proc->getCFG()) {
+            changed |= analyzer.decodeIndirectJmp(bb, proc);
+        }
     }
 
     if (changed) {
@@ -574,7 +587,9 @@ void ProcDecompiler::middleDecompile(UserProc *proc)
         return;
     }
 
-    PassManager::get()->executePass(PassID::PreservationAnalysis, proc);
+    if (!proc->isDegraded()) {
+        PassManager::get()->executePass(PassID::PreservationAnalysis, proc);
+    }
 
     // Used to be later...
     if (project->getSettings()->nameParameters) {
@@ -632,6 +647,7 @@ bool ProcDecompiler::decompileProcInRecursionGroup(UserProc *proc, ProcSet &visi
 
     // Need to propagate into the initial arguments, since arguments are uses,
     // and we are about to remove unused statements.
+    ProcTimeScope timeScope(this, proc);
     changed |= PassManager::get()->executePass(PassID::LocalAndParamMap, proc);
     changed |= PassManager::get()->executePass(PassID::CallArgumentUpdate, proc);
     changed |= PassManager::get()->executePass(PassID::Dominators, proc);
@@ -646,6 +662,8 @@ bool ProcDecompiler::decompileProcInRecursionGroup(UserProc *proc, ProcSet &visi
 
 void ProcDecompiler::recursionGroupAnalysis(const std::shared_ptr<ProcSet> &group)
 {
+    TRACE_SPAN("Recursion group analysis", m_callStack.empty() ? nullptr : m_callStack.back());
+
     /* Overall algorithm:
      *  for each proc in the group
      *          initialise
@@ -694,6 +712,9 @@ void ProcDecompiler::recursionGroupAnalysis(const std::shared_ptr<ProcSet> &grou
 
 void ProcDecompiler::lateDecompile(UserProc *proc)
 {
+    TRACE_SPAN("Late decompile", proc);
+    ProcTimeScope timeScope(this, proc);
+
     Project *project = proc->getProg()->getProject();
     project->alertDecompiling(proc);
     project->alertDecompileDebugPoint(proc, "Before Final");
@@ -739,6 +760,87 @@ void ProcDecompiler::lateDecompile(UserProc *proc)
 }
 
 
+bool ProcDecompiler::isOverBudget(UserProc *proc, int numPasses)
+{
+    if (proc->isDegraded()) {
+        return true;
+    }
+
+    const Settings *settings = proc->getProg()->getProject()->getSettings();
+    QString reason;
+
+    if (settings->procPassBudget > 0 && numPasses >= settings->procPassBudget) {
+        reason = QString("%1 propagation passes").arg(numPasses);
+    }
+
+    if (reason.isEmpty() && settings->procTimeBudget > 0) {
+        const double seconds = getProcTime(proc) / 1e9;
+
+        if (seconds >= settings->procTimeBudget) {
+            reason = QString("%1 seconds").arg(seconds, 0, 'f', 3);
+        }
+    }
+
+    if (reason.isEmpty() && settings->procStmtBudget > 0) {
+        StatementList stmts;
+        proc->getStatements(stmts);
+
+        if (static_cast<int>(stmts.size()) > settings->procStmtBudget) {
+            reason = QString("%1 statements").arg(stmts.size());
+        }
+    }
+
+    if (reason.isEmpty()) {
+        return false;
+    }
+
+    LOG_WARN("Procedure '%1' exceeded its decompilation budget (%2), "
+             "skipping expensive analyses",
+             proc->getName(), reason);
+
+    proc->setDegraded(true);
+    return true;
+}
+
+
+qint64 ProcDecompiler::getProcTime(UserProc *proc) const
+{
+    auto it         = m_procTimes.find(proc);
+    qint64 procTime = (it != m_procTimes.end()) ? it->second : 0;
+
+    if (!m_timedProcs.empty() && m_timedProcs.back() == proc) {
+        procTime += m_procTimer.nsecsElapsed();
+    }
+
+    return procTime;
+}
+
+
+ProcDecompiler::ProcTimeScope::ProcTimeScope(ProcDecompiler *decompiler, UserProc *proc)
+    : m_decompiler(decompiler)
+{
+    // pause the procedure of the enclosing scope
+    if (!m_decompiler->m_timedProcs.empty()) {
+        UserProc *outerProc = m_decompiler->m_timedProcs.back();
+        m_decompiler->m_procTimes[outerProc] += m_decompiler->m_procTimer.nsecsElapsed();
+    }
+
+    m_decompiler->m_timedProcs.push_back(proc);
+    m_decompiler->m_procTimer.start();
+}
+
+
+ProcDecompiler::ProcTimeScope::~ProcTimeScope()
+{
+    UserProc *proc = m_decompiler->m_timedProcs.back();
+    m_decompiler->m_procTimes[proc] += m_decompiler->m_procTimer.nsecsElapsed();
+    m_decompiler->m_timedProcs.pop_back();
+
+    // resume the procedure of the enclosing scope
+    m_decompiler->m_procTimer.start();
+}
+
+
 void ProcDecompiler::printCallStack()
 {
     LOG_MSG("Call stack (most recent procedure last):");
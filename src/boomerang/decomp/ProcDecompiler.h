@@ -12,7 +12,10 @@
 
 #include "boomerang/db/proc/UserProc.h"
 
+#include <QElapsedTimer>
+
 #include <unordered_map>
+#include <vector>
 
 
 class ProcDecompiler
@@ -62,6 +65,35 @@ private:
      */
     void saveDecodedICTs(UserProc *proc);
 
+    /**
+     * Check whether \p proc has exceeded its decompilation budget (see Settings).
+     * If so, the procedure is marked as degraded, and the remaining expensive analyses
+     * (preservation analysis, further propagation passes, indirect jump analysis)
+     * are skipped for it.
+     * \param numPasses number of propagation passes done so far in middleDecompile
+     * \returns true if the procedure is degraded.
+     */
+    bool isOverBudget(UserProc *proc, int numPasses = 0);
+
+    /// \returns the time spent in the passes of \p proc so far, in nanoseconds.
+    qint64 getProcTime(UserProc *proc) const;
+
+private:
+    /**
+     * Charges the time until the end of the scope to a procedure.
+     * Scopes can be nested (e.g. when a callee is decompiled while decompiling its caller);
+     * the time of the outer procedure is paused until the inner scope ends.
+     */
+    class ProcTimeScope
+    {
+    public:
+        ProcTimeScope(ProcDecompiler *decompiler, UserProc *proc);
+        ~ProcTimeScope();
+
+    private:
+        ProcDecompiler *m_decompiler;
+    };
+
 private:
     ProcList m_callStack;
 
@@ -74,4 +106,9 @@ private:
      * each procedure is part of at most 1 recursion group.
      */
     std::unordered_map<UserProc *, std::shared_ptr<ProcSet>> m_recursionGroups;
+
+    /// Time spent in the passes of each procedure (in ns), including restarts.
+    std::unordered_map<UserProc *, qint64> m_procTimes;
+    std::vector<UserProc *> m_timedProcs; ///< Stack of active ProcTimeScopes
+    QElapsedTimer m_procTimer;            ///< Time since the innermost scope was (re)entered
 };
@@ -20,6 +20,7 @@
 #include "boomerang/ssl/exp/Const.h"
 #include "boomerang/ssl/exp/Location.h"
 #include "boomerang/util/log/Log.h"
+#include "boomerang/util/log/Trace.h"
 
 
 ProgDecompiler::ProgDecompiler(Prog *prog)
@@ -89,6 +90,21 @@ void ProgDecompiler::decompile()
     // Now it is OK to transform out of SSA form
     fromSSAForm();
     removeUnusedGlobals();
+
+    int numDegraded = 0;
+    for (const auto &module : m_prog->getModuleList()) {
+        for (Function *func : *module) {
+            if (!func->isLib() && static_cast<UserProc *>(func)->isDegraded()) {
+                LOG_WARN("Procedure '%1' was decompiled with reduced precision", func->getName());
+                numDegraded++;
+            }
+        }
+    }
+
+    if (numDegraded > 0) {
+        LOG_WARN("%1 procedures exceeded their decompilation budget", numDegraded);
+    }
+
     LOG_MSG("Decompilation finished.");
 }
 
@@ -195,6 +211,9 @@ bool ProgDecompiler::removeUnusedParamsAndReturns()
 
 void ProgDecompiler::fromSSAForm()
 {
+    // The FromSSAForm pass of each proc has its own span
+    TRACE_SPAN("From SSA form (all procs)");
+
     LOG_MSG("Transforming from SSA form...");
 
     for (const auto &module : m_prog->getModuleList()) {
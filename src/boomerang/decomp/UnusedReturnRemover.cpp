@@ -20,6 +20,7 @@
 #include "boomerang/ssl/statements/PhiAssign.h"
 #include "boomerang/ssl/statements/ReturnStatement.h"
 #include "boomerang/util/log/Log.h"
+#include "boomerang/util/log/Trace.h"
 #include "boomerang/visitor/expmodifier/ImplicitConverter.h"
 
 
@@ -31,6 +32,8 @@ UnusedReturnRemover::UnusedReturnRemover(Prog *prog)
 
 bool UnusedReturnRemover::removeUnusedReturns()
 {
+    TRACE_SPAN("Remove unused returns");
+
     for (const auto &module : m_prog->getModuleList()) {
         for (Function *proc : *module) {
             if (proc && !proc->isLib() && static_cast<UserProc *>(proc)->isDecoded()) {
@@ -23,6 +23,7 @@
 #include "boomerang/db/signature/Signature.h"
 #include "boomerang/decomp/IndirectJumpAnalyzer.h"
 #include "boomerang/frontend/DecodeResult.h"
+#include "boomerang/frontend/FunctionStartFinder.h"
 #include "boomerang/ifc/IDecoder.h"
 #include "boomerang/ssl/RTL.h"
 #include "boomerang/ssl/exp/Const.h"
@@ -32,12 +33,15 @@
 #include "boomerang/ssl/type/FuncType.h"
 #include "boomerang/ssl/type/NamedType.h"
 #include "boomerang/util/log/Log.h"
+#include "boomerang/util/log/Trace.h"
 
 
 DefaultFrontEnd::DefaultFrontEnd(BinaryFile *binaryFile, Prog *prog)
     : m_binaryFile(binaryFile)
     , m_program(prog)
-    , m_targetQueue(prog->getProject()->getSettings()->traceDecoder)
+    , m_targetQueue(prog->getProject()->getSettings()->traceDecoder,
+                    prog->getProject()->getSettings()->decodeAddrOrder ? TargetOrder::AddressOrder
+                                                                       : TargetOrder::FallThroughFirst)
 {
 }
 
@@ -109,7 +113,7 @@ bool DefaultFrontEnd::decodeEntryPointsRecursive(bool decodeMain)
         }
         else {
             proc->setSignature(fty->getSignature()->clone());
-            proc->getSignature()->setName(name);
+            proc->setName(name);
             // proc->getSignature()->setFullSig(true); // Don't add or remove parameters
             proc->getSignature()->setForced(true); // Don't add or remove parameters
         }
@@ -152,46 +156,75 @@ bool DefaultFrontEnd::decodeRecursive(Address addr)
 
 bool DefaultFrontEnd::decodeUndecoded()
 {
-    bool change = true;
     LOG_MSG("Looking for undecoded procedures to decode...");
 
-    while (change) {
-        change = false;
+    // Procedures discovered while decoding (e.g. call targets found by processProc)
+    // are appended to the decode worklist of the program, so each undecoded procedure
+    // is visited exactly once.
+    const bool decodeChildren = m_program->getProject()->getSettings()->decodeChildren;
+    int numDecoded            = 0;
 
-        for (const auto &m : m_program->getModuleList()) {
-            for (Function *function : *m) {
-                if (function->isLib()) {
-                    continue;
-                }
+    while (UserProc *proc = m_program->takeNextUndecodedProc()) {
+        LOG_VERBOSE("Decoding undecoded proc '%1' (%2 decoded, up to %3 remaining)",
+                    proc->getName(), numDecoded, m_program->getDecodeWorklistSize());
 
-                UserProc *userProc = static_cast<UserProc *>(function);
+        if (!processProc(proc, proc->getEntryAddress())) {
+            return false;
+        }
 
-                if (userProc->isDecoded()) {
-                    continue;
-                }
+        proc->setDecoded();
+        numDecoded++;
 
-                // undecoded userproc.. decode it
-                change = true;
+        if (!decodeChildren) {
+            break;
+        }
+    }
 
-                if (!processProc(userProc, userProc->getEntryAddress())) {
-                    return false;
-                }
+    LOG_MSG("Decoded %1 undecoded procedures", numDecoded);
 
-                userProc->setDecoded();
+    const TargetQueue::Stats &stats = m_targetQueue.getStats();
+    LOG_VERBOSE("Decode targets: %1 queued, %2 duplicates avoided, %3 BB splits", stats.numQueued,
+                stats.numDuplicates, stats.numSplits);
+    return m_program->isWellFormed();
+}
 
-                // Break out of the loops if not decoding children
-                if (!m_program->getProject()->getSettings()->decodeChildren) {
-                    break;
-                }
-            }
-        }
 
-        if (!m_program->getProject()->getSettings()->decodeChildren) {
-            break;
+bool DefaultFrontEnd::decodeLinearSweep()
+{
+    const Settings *settings = m_program->getProject()->getSettings();
+    BinaryFile *binaryFile   = m_program->getBinaryFile();
+
+    FunctionStartFinder finder(binaryFile->getImage(), binaryFile->getMachine());
+    if (!finder.isSupported()) {
+        LOG_WARN("Linear sweep is not supported for this machine");
+        return true;
+    }
+
+    // Candidates and calls inside code that has been decoded already are discarded.
+    // The ranges end at the end of the last decoded instruction, so functions
+    // right after decoded code are still found.
+    for (const auto &[lower, upper] : m_program->getDecodedCode()) {
+        finder.addKnownCode(lower, upper);
+    }
+
+    int numCreated = 0;
+
+    for (const FunctionStartFinder::Candidate &candidate :
+         finder.findCandidates(settings->sweepMinConfidence, settings->numThreads)) {
+        if (m_program->getFunctionByAddr(candidate.addr) != nullptr) {
+            continue;
         }
+
+        LOG_VERBOSE("Found function candidate at address %1 (confidence %2)", candidate.addr,
+                    candidate.score);
+
+        // This adds the function to the decode worklist
+        m_program->getOrCreateFunction(candidate.addr);
+        numCreated++;
     }
 
-    return m_program->isWellFormed();
+    LOG_MSG("Linear sweep found %1 new functions", numCreated);
+    return numCreated == 0 || decodeUndecoded();
 }
 
 
@@ -207,6 +240,8 @@ bool DefaultFrontEnd::decodeFragment(UserProc *proc, Address a)
 
 bool DefaultFrontEnd::processProc(UserProc *proc, Address addr)
 {
+    TRACE_SPAN("Decode proc", proc);
+
     BasicBlock *currentBB;
 
     LOG_VERBOSE("### Decoding proc '%1' at address %2 ###", proc->getName(), addr);
@@ -282,6 +317,7 @@ bool DefaultFrontEnd::processProc(UserProc *proc, Address addr)
 
             // alert the watchers that we have decoded an instruction
             m_program->getProject()->alertInstructionDecoded(addr, inst.numBytes);
+            m_program->addDecodedCode(proc, addr, addr + inst.numBytes);
             numBytesDecoded += inst.numBytes;
 
             // Check if this is an already decoded jump instruction (from a previous pass with
@@ -64,6 +64,9 @@ public:
     /// \copydoc IFrontEnd::decodeUndecoded
     bool decodeUndecoded() override;
 
+    /// \copydoc IFrontEnd::decodeLinearSweep
+    bool decodeLinearSweep() override;
+
     /// \copydoc IFrontEnd::decodeFragment
     bool decodeFragment(UserProc *proc, Address addr) override;
 
@@ -0,0 +1,240 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "FunctionStartFinder.h"
+
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySection.h"
+#include "boomerang/util/ByteUtil.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <thread>
+
+
+FunctionStartFinder::FunctionStartFinder(const BinaryImage *image, Machine machine)
+    : m_image(image)
+    , m_machine(machine)
+{
+    if (m_machine == Machine::PENTIUM) {
+        m_prologueScanner.addPattern("55 89 E5");    // push ebp; mov ebp, esp (gcc)
+        m_prologueScanner.addPattern("55 8B EC");    // push ebp; mov ebp, esp (MSVC)
+        m_prologueScanner.addPattern("55 57 56 53"); // push ebp; push edi; push esi; push ebx
+    }
+}
+
+
+void FunctionStartFinder::addKnownCode(Address lower, Address upper)
+{
+    if (lower < upper) {
+        m_knownCode.push_back({ lower, upper });
+    }
+}
+
+
+std::vector<FunctionStartFinder::Candidate> FunctionStartFinder::findCandidates(int minScore,
+                                                                                int numThreads)
+{
+    if (!isSupported()) {
+        return {};
+    }
+
+    // Merge overlapping ranges of known code, so a single binary search is enough to find
+    // the range containing an address
+    std::sort(m_knownCode.begin(), m_knownCode.end());
+    std::vector<std::pair<Address, Address>> merged;
+
+    for (const auto &range : m_knownCode) {
+        if (!merged.empty() && range.first <= merged.back().second) {
+            merged.back().second = std::max(merged.back().second, range.second);
+        }
+        else {
+            merged.push_back(range);
+        }
+    }
+
+    m_knownCode = std::move(merged);
+
+    if (numThreads <= 0) {
+        numThreads = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    // Split the code sections into chunks
+    std::vector<Chunk> chunks;
+
+    for (const BinarySection *section : *m_image) {
+        if (!section->isCode() || section->getHostAddr() == HostAddress::INVALID ||
+            section->getSize() == 0) {
+            continue;
+        }
+
+        const int chunkSize = std::max(MIN_CHUNK_SIZE,
+                                       (section->getSize() + numThreads - 1) / numThreads);
+        const Address sectionEnd = section->getSourceAddr() + section->getSize();
+
+        for (Address lower = section->getSourceAddr(); lower < sectionEnd; lower += chunkSize) {
+            Chunk chunk;
+            chunk.section = section;
+            chunk.lower   = lower;
+            chunk.upper   = std::min(sectionEnd, lower + chunkSize);
+            chunks.push_back(std::move(chunk));
+        }
+    }
+
+    numThreads = static_cast<int>(std::min<size_t>(numThreads, chunks.size()));
+
+    if (numThreads > 1) {
+        std::atomic<size_t> nextChunk(0);
+
+        // Each worker has its own scanner since scanning modifies the state of the scanner.
+        auto worker = [&]() {
+            BytePatternScanner scanner = m_prologueScanner;
+
+            for (size_t i = nextChunk++; i < chunks.size(); i = nextChunk++) {
+                sweepChunk(chunks[i], scanner);
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (int i = 0; i < numThreads; i++) {
+            workers.emplace_back(worker);
+        }
+
+        for (std::thread &t : workers) {
+            t.join();
+        }
+    }
+    else {
+        for (Chunk &chunk : chunks) {
+            sweepChunk(chunk, m_prologueScanner);
+        }
+    }
+
+    // Combine the evidence of all chunks
+    std::map<Address, std::pair<bool, int>> evidence; ///< has prologue, number of calls
+
+    for (const Chunk &chunk : chunks) {
+        for (Address addr : chunk.prologues) {
+            evidence[addr].first = true;
+        }
+
+        for (Address addr : chunk.callTargets) {
+            evidence[addr].second++;
+        }
+    }
+
+    std::vector<Candidate> candidates;
+
+    for (const auto &[addr, ev] : evidence) {
+        const BinarySection *section = m_image->getSectionByAddr(addr);
+        if (!section || !section->isCode() || isKnownCode(addr)) {
+            continue;
+        }
+
+        int score = ev.first ? SCORE_PROLOGUE : 0;
+        score += std::min(ev.second * SCORE_CALL_TARGET, MAX_CALL_TARGET_SCORE);
+        score += getAlignmentScore(section, addr);
+
+        if (score >= minScore) {
+            candidates.push_back({ addr, score, ev.second });
+        }
+    }
+
+    return candidates;
+}
+
+
+void FunctionStartFinder::sweepChunk(Chunk &chunk, BytePatternScanner &prologueScanner) const
+{
+    const BinarySection *section = chunk.section;
+    const Byte *sectionData      = reinterpret_cast<const Byte *>(section->getHostAddr().value());
+    const Address sectionEnd     = section->getSourceAddr() + section->getSize();
+
+    const Byte *data = sectionData + (chunk.lower - section->getSourceAddr()).value();
+    const std::size_t size = (chunk.upper - chunk.lower).value();
+
+    // Prologues may extend into the next chunk
+    const std::size_t scanSize = std::min<std::size_t>(size + 16,
+                                                       (sectionEnd - chunk.lower).value());
+
+    std::vector<BytePatternScanner::Match> matches;
+    prologueScanner.scan(data, scanSize, chunk.lower, matches);
+
+    for (const BytePatternScanner::Match &match : matches) {
+        if (match.addr < chunk.upper) {
+            chunk.prologues.push_back(match.addr);
+        }
+    }
+
+    // Direct calls (call rel32)
+    const std::size_t sectionRemaining = (sectionEnd - chunk.lower).value();
+
+    for (std::size_t pos = 0; pos < size; pos++) {
+        const void *next = std::memchr(data + pos, 0xE8, size - pos);
+        if (!next) {
+            break;
+        }
+
+        pos = static_cast<const Byte *>(next) - data;
+        if (pos + 5 > sectionRemaining) {
+            break;
+        }
+
+        // Calls in decoded code have been followed already, and other E8 bytes
+        // inside decoded instructions are not calls at all.
+        if (isKnownCode(chunk.lower + pos)) {
+            continue;
+        }
+
+        const int disp       = static_cast<int>(Util::readDWord(data + pos + 1, Endian::Little));
+        const Address target = chunk.lower + pos + 5 + disp;
+
+        const BinarySection *targetSection = m_image->getSectionByAddr(target);
+        if (targetSection && targetSection->isCode()) {
+            chunk.callTargets.push_back(target);
+        }
+    }
+}
+
+
+int FunctionStartFinder::getAlignmentScore(const BinarySection *section, Address addr) const
+{
+    int score = 0;
+
+    if (addr.value() % FUNCTION_ALIGNMENT == 0) {
+        score += SCORE_ALIGNED;
+    }
+
+    const Byte *data = reinterpret_cast<const Byte *>(section->getHostAddr().value());
+    const std::size_t offset = (addr - section->getSourceAddr()).value();
+
+    if (offset >= 1) {
+        const Byte prev = data[offset - 1];
+
+        // nop, int3, ret, or ret imm16
+        if (prev == 0x90 || prev == 0xCC || prev == 0xC3 ||
+            (offset >= 3 && data[offset - 3] == 0xC2)) {
+            score += SCORE_AFTER_PADDING;
+        }
+    }
+
+    return score;
+}
+
+
+bool FunctionStartFinder::isKnownCode(Address addr) const
+{
+    auto it = std::upper_bound(
+        m_knownCode.begin(), m_knownCode.end(), addr,
+        [](Address a, const std::pair<Address, Address> &range) { return a < range.first; });
+
+    return it != m_knownCode.begin() && addr < std::prev(it)->second;
+}
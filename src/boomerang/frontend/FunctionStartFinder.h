@@ -0,0 +1,104 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/db/binary/BinaryFile.h"
+#include "boomerang/db/binary/BytePatternScanner.h"
+#include "boomerang/util/Address.h"
+
+#include <utility>
+#include <vector>
+
+
+class BinaryImage;
+class BinarySection;
+
+
+/**
+ * Finds likely function entry points in code that is not reachable
+ * by recursive traversal from the known entry points (e.g. functions that are only
+ * called indirectly), by a linear sweep over the code sections of the binary.
+ *
+ * Each candidate address gets a confidence score from several kinds of evidence:
+ * Known function prologues starting at the address, direct calls to the address,
+ * and alignment padding (or the end of the previous function) right before the address.
+ * Only addresses with a prologue or at least one call are considered at all;
+ * alignment only adds to the score.
+ *
+ * The sweep can be split into chunks that are scanned in parallel, since it does not
+ * modify the binary or the program.
+ */
+class BOOMERANG_API FunctionStartFinder
+{
+public:
+    static constexpr int SCORE_PROLOGUE        = 50; ///< starts with a known function prologue
+    static constexpr int SCORE_CALL_TARGET     = 30; ///< for each direct call to the address
+    static constexpr int MAX_CALL_TARGET_SCORE = 60;
+    static constexpr int SCORE_AFTER_PADDING   = 20; ///< preceded by padding or a return
+    static constexpr int SCORE_ALIGNED         = 10; ///< aligned to \ref FUNCTION_ALIGNMENT
+
+    static constexpr int FUNCTION_ALIGNMENT = 16;
+
+    /// Chunks of the sweep are not made smaller than this (in bytes)
+    static constexpr int MIN_CHUNK_SIZE = 0x10000;
+
+    struct Candidate
+    {
+        Address addr;
+        int score;
+        int numCalls; ///< number of direct calls to the address
+    };
+
+public:
+    FunctionStartFinder(const BinaryImage *image, Machine machine);
+
+public:
+    /// \returns true if there are heuristics for the machine of the binary.
+    bool isSupported() const { return m_machine == Machine::PENTIUM; }
+
+    /// Mark the code in [lower, upper) as already decoded.
+    /// Candidates and direct calls inside known code are discarded.
+    void addKnownCode(Address lower, Address upper);
+
+    /**
+     * Sweep all code sections and score all candidate function entry points.
+     * \param minScore   only return candidates with at least this score
+     * \param numThreads number of threads to sweep with (0 = one per CPU core)
+     * \returns the candidates, sorted by address.
+     */
+    std::vector<Candidate> findCandidates(int minScore, int numThreads = 1);
+
+private:
+    /// Part of a code section to be swept by a single thread.
+    struct Chunk
+    {
+        const BinarySection *section;
+        Address lower, upper;
+
+        std::vector<Address> prologues;
+        std::vector<Address> callTargets;
+    };
+
+    void sweepChunk(Chunk &chunk, BytePatternScanner &prologueScanner) const;
+
+    /// \returns the score for the bytes right before \p addr.
+    int getAlignmentScore(const BinarySection *section, Address addr) const;
+
+    bool isKnownCode(Address addr) const;
+
+private:
+    const BinaryImage *m_image;
+    Machine m_machine;
+    BytePatternScanner m_prologueScanner;
+
+    /// Right-open address ranges of decoded code, sorted and merged before the sweep
+    std::vector<std::pair<Address, Address>> m_knownCode;
+};
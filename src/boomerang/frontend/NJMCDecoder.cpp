@@ -40,10 +40,8 @@ NJMCDecoder::NJMCDecoder(Prog *prog, const QString &sslFilePath)
 std::unique_ptr<RTL> NJMCDecoder::instantiate(Address pc, const char *name,
                                               const std::initializer_list<SharedExp> &args)
 {
-    // Get the signature of the instruction and extract its parts
-    std::pair<QString, unsigned> sig = m_rtlDict.getSignature(name);
-    QString opcode                   = sig.first;
-    unsigned int numOperands         = sig.second;
+    const int instrID             = getInstructionID(name);
+    const std::size_t numOperands = (instrID != -1) ? m_rtlDict.getNumParams(instrID) : 0;
 
     if (numOperands != args.size()) {
         QString msg = QString("Disassembled instruction '%1' has %2 arguments, "
@@ -53,35 +51,69 @@ std::unique_ptr<RTL> NJMCDecoder::instantiate(Address pc, const char *name,
                           .arg(numOperands);
         throw std::invalid_argument(msg.toStdString());
     }
+    else if (instrID == -1) {
+        return nullptr;
+    }
+
+    return instantiate(pc, name, instrID, std::vector<SharedExp>(args));
+}
+
+
+std::unique_ptr<RTL> NJMCDecoder::instantiate(Address pc, const char *name, int instrID,
+                                              const std::vector<SharedExp> &args)
+{
+    showInstruction(pc, name, args);
+    return m_rtlDict.instantiateRTL(instrID, pc, args);
+}
+
+
+int NJMCDecoder::getInstructionID(const char *name)
+{
+    auto it = m_instructionIDs.find(name);
+    if (it != m_instructionIDs.end()) {
+        // The name must not have been reused for another instruction
+        assert(it->second == m_rtlDict.getInstructionID(name));
+        return it->second;
+    }
 
-    // Put the operands into a vector
-    std::vector<SharedExp> actuals(args);
+    const int instrID = m_rtlDict.getInstructionID(name);
+    if (instrID == -1) {
+        LOG_ERROR("No entry for '%1' in RTL dictionary", name);
+    }
 
-    if (m_prog->getProject()->getSettings()->debugDecoder) {
-        OStream q_cout(stdout);
-        // Display a disassembly of this instruction if requested
-        q_cout << pc << ": " << name << " ";
+    m_instructionIDs[name] = instrID;
+    return instrID;
+}
 
-        for (const SharedExp &itd : actuals) {
-            if (itd->isIntConst()) {
-                int val = itd->access<Const>()->getInt();
 
-                if ((val > 100) || (val < -100)) {
-                    q_cout << "0x" << QString::number(val, 16);
-                }
-                else {
-                    q_cout << val;
-                }
+void NJMCDecoder::showInstruction(Address pc, const char *name,
+                                  const std::vector<SharedExp> &args)
+{
+    if (!m_prog->getProject()->getSettings()->debugDecoder) {
+        return;
+    }
+
+    OStream q_cout(stdout);
+    // Display a disassembly of this instruction if requested
+    q_cout << pc << ": " << name << " ";
+
+    for (const SharedExp &itd : args) {
+        if (itd->isIntConst()) {
+            int val = itd->access<Const>()->getInt();
+
+            if ((val > 100) || (val < -100)) {
+                q_cout << "0x" << QString::number(val, 16);
             }
             else {
-                itd->print(q_cout);
+                q_cout << val;
             }
         }
-
-        q_cout << '\n';
+        else {
+            itd->print(q_cout);
+        }
     }
 
-    return m_rtlDict.instantiateRTL(opcode, pc, actuals);
+    q_cout << '\n';
 }
 
 
@@ -15,6 +15,8 @@
 #include "boomerang/ssl/exp/ExpHelp.h"
 #include "boomerang/util/Util.h"
 
+#include <unordered_map>
+
 
 class BinaryImage;
 
@@ -22,7 +24,7 @@ class BinaryImage;
 /**
  * The NJMCDecoder class is a class that contains NJMC generated decoding methods.
  */
-class NJMCDecoder : public IDecoder
+class BOOMERANG_API NJMCDecoder : public IDecoder
 {
 public:
     NJMCDecoder(Prog *prog, const QString &sslFilePath);
@@ -87,6 +89,23 @@ protected:
     std::unique_ptr<RTL> instantiate(Address pc, const char *name,
                                      const std::initializer_list<SharedExp> &args = {});
 
+    /**
+     * Like \ref NJMCDecoder::instantiate, but for an instruction
+     * whose ID \p instrID in the RTL dictionary was already looked up.
+     * \param   name the name of the instruction (for debugging)
+     */
+    std::unique_ptr<RTL> instantiate(Address pc, const char *name, int instrID,
+                                     const std::vector<SharedExp> &args);
+
+    /**
+     * \returns the ID of the instruction \p name in the RTL dictionary, or -1 if not found.
+     * The ID is only looked up by name on the first use of \p name;
+     * subsequent lookups are cached by the address of the name.
+     * \note \p name must be a string literal (or otherwise have static storage duration).
+     * Debug builds check that the cached ID still belongs to \p name.
+     */
+    int getInstructionID(const char *name);
+
     /**
      * Similarly to \ref NJMCDecoder::instantiate, given a parameter name
      * and a list of Exp*'s representing sub-parameters, return
@@ -141,12 +160,20 @@ protected:
      */
     SharedExp dis_Num(unsigned num);
 
+private:
+    /// Display a disassembly of the instruction \p name if the decoder is being debugged.
+    void showInstruction(Address pc, const char *name, const std::vector<SharedExp> &args);
+
 protected:
     // Dictionary of instruction patterns, and other information summarised from the SSL file
     // (e.g. source machine's endianness)
     RTLInstDict m_rtlDict;
     Prog *m_prog         = nullptr;
     BinaryImage *m_image = nullptr;
+
+private:
+    /// Instruction IDs in the RTL dictionary, by the address of the instruction name
+    std::unordered_map<const char *, int> m_instructionIDs;
 };
 
 
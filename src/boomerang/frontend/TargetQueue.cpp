@@ -9,31 +9,47 @@
 #pragma endregion License
 #include "TargetQueue.h"
 
+#include "boomerang/db/BasicBlock.h"
 #include "boomerang/db/proc/ProcCFG.h"
 #include "boomerang/util/log/Log.h"
 
 
-TargetQueue::TargetQueue(bool traceDecoder)
+TargetQueue::TargetQueue(bool traceDecoder, TargetOrder order)
     : m_traceDecoder(traceDecoder)
+    , m_order(order)
 {
 }
 
 
 void TargetQueue::visit(ProcCFG *cfg, Address newAddr, BasicBlock *&newBB)
 {
-    if (cfg->isStartOfBB(newAddr)) {
-        // BB is already complete or the start address is already in the queue.
-        // Don't visit it twice.
+    if (!m_visited.insert(newAddr).second) {
+        // The address is already in the queue or has been decoded. Don't visit it twice.
+        m_stats.numDuplicates++;
         return;
     }
 
-    // Find out if we've already parsed the destination
-    const bool alreadyParsed = cfg->ensureBBExists(newAddr, newBB);
+    const BasicBlock *existingBB = cfg->getBBStartingAt(newAddr);
+
+    if (existingBB) {
+        if (existingBB->isIncomplete()) {
+            // An out edge to the address has been added already
+            push(newAddr);
+
+            if (m_traceDecoder) {
+                LOG_MSG(">%1", newAddr);
+            }
+        }
+
+        return;
+    }
 
-    // Add this address to the back of the local queue,
-    // if not already processed
-    if (!alreadyParsed) {
-        m_targets.push(newAddr);
+    // Find out if we've already parsed the destination
+    if (cfg->ensureBBExists(newAddr, newBB)) {
+        m_stats.numSplits++;
+    }
+    else {
+        push(newAddr);
 
         if (m_traceDecoder) {
             LOG_MSG(">%1", newAddr);
@@ -44,22 +60,35 @@ void TargetQueue::visit(ProcCFG *cfg, Address newAddr, BasicBlock *&newBB)
 
 void TargetQueue::initial(Address addr)
 {
-    m_targets.push(addr);
+    m_targets.clear();
+    m_sortedTargets.clear();
+    m_visited.clear();
+
+    m_visited.insert(addr);
+    push(addr);
 }
 
 
 Address TargetQueue::getNextAddress(const ProcCFG &cfg)
 {
-    while (!m_targets.empty()) {
-        Address address = m_targets.front();
-        m_targets.pop();
+    while (!m_targets.empty() || !m_sortedTargets.empty()) {
+        Address address;
+
+        if (m_order == TargetOrder::AddressOrder) {
+            address = *m_sortedTargets.begin();
+            m_sortedTargets.erase(m_sortedTargets.begin());
+        }
+        else {
+            address = m_targets.front();
+            m_targets.pop_front();
+        }
 
         if (m_traceDecoder) {
             LOG_MSG("<%1", address);
         }
 
         // If no label there at all, or if there is a BB, it's incomplete, then we can parse this
-        // address next
+        // address next. The BB might have been completed by decoding sequentially into it.
         if (!cfg.isStartOfBB(address) || cfg.isStartOfIncompleteBB(address)) {
             return address;
         }
@@ -67,3 +96,16 @@ Address TargetQueue::getNextAddress(const ProcCFG &cfg)
 
     return Address::INVALID;
 }
+
+
+void TargetQueue::push(Address addr)
+{
+    if (m_order == TargetOrder::AddressOrder) {
+        m_sortedTargets.insert(addr);
+    }
+    else {
+        m_targets.push_back(addr);
+    }
+
+    m_stats.numQueued++;
+}
@@ -12,22 +12,48 @@
 
 #include "boomerang/util/Address.h"
 
-#include <queue>
+#include <cstdint>
+#include <deque>
+#include <set>
 
 
 class ProcCFG;
 class BasicBlock;
 
 
-/// Put the target queue logic into this small class
-class TargetQueue
+/// The order in which queued targets are decoded.
+enum class TargetOrder : uint8_t
 {
+    /// Decode targets in the order they were found. Since decoding continues sequentially
+    /// after instructions with a fall through edge, fall through code is decoded before
+    /// the targets of the branches.
+    FallThroughFirst,
+
+    /// Decode the target with the lowest address first, for locality of the decoded code.
+    AddressOrder
+};
+
+
+/**
+ * The set of addresses within a procedure that still have to be decoded.
+ * Each address is only queued once per procedure.
+ */
+class BOOMERANG_API TargetQueue
+{
+public:
+    struct Stats
+    {
+        int numQueued     = 0; ///< number of targets queued for decoding
+        int numDuplicates = 0; ///< number of visits of targets that were visited before
+        int numSplits     = 0; ///< number of decoded BBs split by a visited target
+    };
+
 public:
-    TargetQueue(bool traceDecoder);
+    TargetQueue(bool traceDecoder, TargetOrder order = TargetOrder::FallThroughFirst);
 
     /**
-     * Seed the queue with an initial address.
-     * \note     Can be some targets already in the queue now
+     * Start decoding a new procedure (or fragment of a procedure) at \p addr.
+     * Discards all targets that are still queued.
      * \param    addr Native address to seed the queue with
      */
     void initial(Address addr);
@@ -36,11 +62,9 @@ public:
      * Visit a destination as a label, i.e. check whether we need to queue it as a new BB to create
      * later.
      *
-     * \note at present, it is important to visit an address BEFORE an out edge is added to that
-     * address. This is because adding an out edge enters the address into the ProcCFG's BB map, and
-     * it looks like the BB has already been visited, and it gets overlooked. It would be better to
-     * have a scheme whereby the order of calling these functions (i.e. visit() and AddOutEdge())
-     * did not matter.
+     * The address is queued unless it was visited before or it is the start of a complete BB,
+     * so it does not matter whether an out edge to the address (which creates an incomplete BB
+     * at the address) is added before or after visiting it.
      *
      * \param   cfg     the enclosing CFG
      * \param   newAddr the address to be checked
@@ -57,7 +81,28 @@ public:
      */
     Address getNextAddress(const ProcCFG &cfg);
 
+    /// \returns statistics about all targets visited so far.
+    const Stats &getStats() const { return m_stats; }
+
+    /// Add \p stats of another queue (e.g. a queue for a single procedure) to the statistics
+    /// of this queue.
+    void addStats(const Stats &stats)
+    {
+        m_stats.numQueued += stats.numQueued;
+        m_stats.numDuplicates += stats.numDuplicates;
+        m_stats.numSplits += stats.numSplits;
+    }
+
+private:
+    void push(Address addr);
+
 private:
     bool m_traceDecoder;
-    std::queue<Address> m_targets;
+    TargetOrder m_order;
+
+    std::deque<Address> m_targets;     ///< Targets in discovery order (FallThroughFirst)
+    std::set<Address> m_sortedTargets; ///< Targets in address order (AddressOrder)
+    std::set<Address> m_visited;       ///< All targets visited in the current procedure
+
+    Stats m_stats;
 };
@@ -26,8 +26,11 @@
 #include "boomerang/ssl/statements/CaseStatement.h"
 #include "boomerang/ssl/statements/ReturnStatement.h"
 #include "boomerang/ssl/type/IntegerType.h"
+#include "boomerang/ssl/type/PointerType.h"
+#include "boomerang/ssl/type/VoidType.h"
 #include "boomerang/util/log/Log.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
@@ -56,9 +59,18 @@
 #define DIS_OFF (addReloc(Const::get(off)))
 
 bool PentiumDecoder::decodeInstruction(Address pc, ptrdiff_t delta, DecodeResult &result)
+{
+    return decodeFromOpcodeTable(pc, delta, result) ||
+           decodeInstructionWithMatcher(pc, delta, result);
+}
+
+
+bool PentiumDecoder::decodeInstructionWithMatcher(Address pc, ptrdiff_t delta,
+                                                  DecodeResult &result)
 {
     result.reset();
     result.rtl.reset(new RTL(pc));
+    m_relocCandidates.clear();
 
     HostAddress hostPC = HostAddress(delta) + pc;
     HostAddress nextPC = HostAddress::INVALID;
@@ -46778,6 +46790,11 @@ bool PentiumDecoder::decodeInstruction(Address pc, ptrdiff_t delta, DecodeResult
 
     assert(nextPC >= hostPC);
     result.numBytes = (nextPC.value() - hostPC.value());
+
+    if (result.valid && !m_relocCandidates.empty()) {
+        tagRelocatedOperands(pc, result);
+    }
+
     return result.valid;
 }
 
@@ -47051,6 +47068,144 @@ bool PentiumDecoder::isFuncPrologue(Address)
 PentiumDecoder::PentiumDecoder(Prog *_prog)
     : NJMCDecoder(_prog, "ssl/pentium.ssl")
 {
+    initOpcodeTable();
+}
+
+
+void PentiumDecoder::initOpcodeTable()
+{
+    auto add = [this](Byte opcode, int count, TableOperands operands, const char *name) {
+        for (int i = 0; i < count; i++) {
+            m_opcodeTable[opcode + i] = { operands, name, -1 };
+        }
+    };
+
+    static const char *const ALU_MR_NAMES[] = { "ADDmrod", "ORmrod",  "ADCmrod", "SBBmrod",
+                                                "ANDmrod", "SUBmrod", "XORmrod", "CMPmrod" };
+    static const char *const ALU_RM_NAMES[] = { "ADDrmod", "ORrmod",  "ADCrmod", "SBBrmod",
+                                                "ANDrmod", "SUBrmod", "XORrmod", "CMPrmod" };
+
+    for (int i = 0; i < 8; i++) {
+        add(i * 8 + 1, 1, TableOperands::ModRMReg, ALU_MR_NAMES[i]); // e.g. add r/m32, r32
+        add(i * 8 + 3, 1, TableOperands::RegModRM, ALU_RM_NAMES[i]); // e.g. add r32, r/m32
+    }
+
+    add(0x40, 8, TableOperands::R32, "INCod");
+    add(0x48, 8, TableOperands::R32, "DECod");
+    add(0x50, 8, TableOperands::R32, "PUSHod");
+    add(0x58, 8, TableOperands::R32, "POPod");
+    add(0x85, 1, TableOperands::ModRMReg, "TEST.Ev.Gvod");
+    add(0x89, 1, TableOperands::ModRMReg, "MOVmrod");
+    add(0x8B, 1, TableOperands::RegModRM, "MOVrmod");
+    add(0x90, 1, TableOperands::None, "NOP");
+    add(0x91, 7, TableOperands::R32, "XCHGeAXod");
+    add(0x98, 1, TableOperands::None, "CWDE");
+    add(0x99, 1, TableOperands::None, "CDQ");
+    add(0x9E, 1, TableOperands::None, "SAHF");
+    add(0x9F, 1, TableOperands::None, "LAHF");
+    add(0xB0, 8, TableOperands::R8Imm8, "MOVib");
+    add(0xB8, 8, TableOperands::R32Imm32, "MOVid");
+    add(0xC3, 1, TableOperands::Return, "RET");
+    add(0xC9, 1, TableOperands::None, "LEAVE");
+    add(0xF5, 1, TableOperands::None, "CMC");
+    add(0xF8, 1, TableOperands::None, "CLC");
+    add(0xF9, 1, TableOperands::None, "STC");
+    add(0xFC, 1, TableOperands::None, "CLD");
+    add(0xFD, 1, TableOperands::None, "STD");
+
+    for (OpcodeTableEntry &entry : m_opcodeTable) {
+        if (entry.operands == TableOperands::Invalid) {
+            continue;
+        }
+
+        std::size_t numOperands = 0;
+        switch (entry.operands) {
+        case TableOperands::R32: numOperands = 1; break;
+        case TableOperands::R8Imm8:
+        case TableOperands::R32Imm32:
+        case TableOperands::ModRMReg:
+        case TableOperands::RegModRM: numOperands = 2; break;
+        default: break;
+        }
+
+        // Leave instructions that are missing from the SSL file to the matcher
+        entry.instrID = m_rtlDict.getInstructionID(entry.name);
+        if (entry.instrID == -1 || m_rtlDict.getNumParams(entry.instrID) != numOperands) {
+            entry.operands = TableOperands::Invalid;
+        }
+    }
+}
+
+
+bool PentiumDecoder::decodeFromOpcodeTable(Address pc, ptrdiff_t delta, DecodeResult &result)
+{
+    HostAddress hostPC            = HostAddress(delta) + pc;
+    const Byte opcode             = getByte(hostPC);
+    const OpcodeTableEntry &entry = m_opcodeTable[opcode];
+
+    m_relocCandidates.clear();
+    std::vector<SharedExp> args;
+    int numBytes = 1;
+
+    switch (entry.operands) {
+    case TableOperands::Invalid: return false;
+
+    case TableOperands::None:
+    case TableOperands::Return: break;
+
+    case TableOperands::R32: args = { dis_Reg((opcode & 0x7) + 24) }; break;
+
+    case TableOperands::R8Imm8: {
+        const int i8 = Util::signExtend(getByte(hostPC + 1) & 0xff, 8);
+        args         = { dis_Reg((opcode & 0x7) + 8), Const::get(i8) };
+        numBytes     = 2;
+    } break;
+
+    case TableOperands::R32Imm32: {
+        const unsigned i32 = getDword(hostPC + 1);
+        args               = { dis_Reg((opcode & 0x7) + 24), addReloc(Const::get(i32)) };
+        numBytes           = 5;
+    } break;
+
+    case TableOperands::ModRMReg:
+    case TableOperands::RegModRM: {
+        const Byte modrm = getByte(hostPC + 1);
+        if ((modrm >> 6 & 0x3) != 3) {
+            return false; // memory operands are decoded by the matcher
+        }
+
+        SharedExp rm  = dis_Reg((modrm & 0x7) + 24);
+        SharedExp reg = dis_Reg((modrm >> 3 & 0x7) + 24);
+
+        if (entry.operands == TableOperands::ModRMReg) {
+            args = { rm, reg };
+        }
+        else {
+            args = { reg, rm };
+        }
+
+        numBytes = 2;
+    } break;
+    }
+
+    result.reset();
+    result.rtl = instantiate(pc, entry.name, entry.instrID, args);
+
+    if (!result.rtl) {
+        result.rtl.reset(new RTL(pc));
+    }
+
+    if (entry.operands == TableOperands::Return) {
+        result.rtl->append(new ReturnStatement);
+    }
+
+    result.numBytes = numBytes;
+
+    if (!m_relocCandidates.empty()) {
+        tagRelocatedOperands(pc, result);
+    }
+
+    return true;
 }
 
 
@@ -47136,5 +47291,43 @@ void PentiumDecoder::genBSFR(Address pc, SharedExp dest, SharedExp modrm, int in
 
 SharedExp PentiumDecoder::addReloc(const SharedExp &e)
 {
+    if (e->isIntConst() && m_image->getNumRelocations() > 0) {
+        m_relocCandidates.push_back(static_cast<DWord>(e->access<Const>()->getInt()));
+    }
+
     return e;
 }
+
+
+void PentiumDecoder::tagRelocatedOperands(Address pc, DecodeResult &result)
+{
+    if (!result.rtl || result.numBytes < 4) {
+        return;
+    }
+
+    // Only consider relocated words that lie completely inside this instruction.
+    // The operand might be any of them (e.g. for mov [addr], imm32), so compare the values.
+    const Address lastWord = pc + result.numBytes - 3;
+
+    for (Address reloc = m_image->findRelocation(pc, lastWord); reloc != Address::INVALID;
+         reloc         = m_image->findRelocation(reloc + 1, lastWord)) {
+        const DWord value = m_image->readNative4(reloc);
+
+        if (std::find(m_relocCandidates.begin(), m_relocCandidates.end(), value) ==
+            m_relocCandidates.end()) {
+            continue;
+        }
+
+        // The operands were copied into the RTL by instantiate
+        const Const pattern(value);
+
+        for (Statement *stmt : *result.rtl) {
+            std::list<SharedExp> operands;
+            stmt->searchAll(pattern, operands);
+
+            for (const SharedExp &operand : operands) {
+                operand->access<Const>()->setType(PointerType::get(VoidType::get()));
+            }
+        }
+    }
+}
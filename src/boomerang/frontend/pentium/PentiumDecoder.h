@@ -14,6 +14,9 @@
 #include "boomerang/frontend/NJMCDecoder.h"
 #include "boomerang/ssl/exp/Operator.h"
 
+#include <array>
+#include <vector>
+
 
 class Prog;
 class DecodeResult;
@@ -21,9 +24,15 @@ class DecodeResult;
 
 /**
  * Decoder for x86 instructions.
+ *
+ * The most frequent simple instructions (e.g. push/pop, register to register moves
+ * and arithmetic) are decoded via an opcode table whose entries refer directly to
+ * the RTL dictionary IDs of the instructions. All other instructions
+ * are decoded by the generated matcher.
+ *
  * \note x86-64 instructions are not supported.
  */
-class PentiumDecoder : public NJMCDecoder
+class BOOMERANG_API PentiumDecoder : public NJMCDecoder
 {
 public:
     /// \copydoc NJMCDecoder::NJMCDecoder
@@ -55,15 +64,56 @@ public:
      */
     virtual bool decodeInstruction(Address pc, ptrdiff_t delta, DecodeResult &result) override;
 
+    /**
+     * Decode the instruction at \p pc with the generated matcher only,
+     * bypassing the opcode table. Used to validate the opcode table.
+     * \sa decodeInstruction
+     */
+    bool decodeInstructionWithMatcher(Address pc, ptrdiff_t delta, DecodeResult &result);
+
 private:
+    /// Operands of the instructions in the opcode table
+    enum class TableOperands : uint8_t
+    {
+        Invalid,  ///< Not in the table; decoded by the generated matcher
+        None,     ///< No operands
+        Return,   ///< No operands; the instruction returns from the procedure
+        R32,      ///< 32 bit register encoded in the opcode
+        R8Imm8,   ///< 8 bit register encoded in the opcode, 8 bit immediate
+        R32Imm32, ///< 32 bit register encoded in the opcode, 32 bit immediate
+        ModRMReg, ///< r/m32, r32 (register operands only)
+        RegModRM  ///< r32, r/m32 (register operands only)
+    };
+
+    struct OpcodeTableEntry
+    {
+        TableOperands operands = TableOperands::Invalid;
+        const char *name       = nullptr;
+        int instrID            = -1; ///< ID of the instruction in the RTL dictionary
+    };
+
+    /// Set up the opcode table and look up the dictionary IDs of all its instructions.
+    void initOpcodeTable();
+
+    /// Decode the instruction at \p pc via the opcode table.
+    /// \returns false if the instruction is not in the opcode table.
+    bool decodeFromOpcodeTable(Address pc, ptrdiff_t delta, DecodeResult &result);
+
     /*
      * Various functions to decode the operands of an instruction into
      * a SemStr representation.
      */
     SharedExp dis_Eaddr(HostAddress hostPC, int size = 0);
     SharedExp dis_Mem(HostAddress ps);
+
+    /// Remember the 32 bit constant \p e as a possibly relocated operand
+    /// of the current instruction. \sa tagRelocatedOperands
     SharedExp addReloc(const SharedExp &e);
 
+    /// After decoding the instruction at \p pc, mark all operands that were read
+    /// from a relocated word of this instruction as addresses.
+    void tagRelocatedOperands(Address pc, DecodeResult &result);
+
     bool isFuncPrologue(Address hostPC);
 
     /// Read bytes, words or dwords from the memory at address \p addr
@@ -85,5 +135,8 @@ private:
                  int numBytes, DecodeResult &result, bool debug);
 
 private:
+    std::array<OpcodeTableEntry, 256> m_opcodeTable; ///< indexed by the first opcode byte
+
     int BSFRstate = 0; ///< state machine state number for decoding BSF/BSR instruction
+    std::vector<DWord> m_relocCandidates; ///< possibly relocated operands (see addReloc)
 };
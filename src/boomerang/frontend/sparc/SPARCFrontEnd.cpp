@@ -584,7 +584,10 @@ bool SPARCFrontEnd::processProc(UserProc *proc, Address addr)
 {
     // Declare an object to manage the queue of targets not yet processed yet.
     // This has to be individual to the procedure! (so not a global)
-    TargetQueue _targetQueue(m_program->getProject()->getSettings()->traceDecoder);
+    const Settings *settings = m_program->getProject()->getSettings();
+    TargetQueue _targetQueue(settings->traceDecoder, settings->decodeAddrOrder
+                                                         ? TargetOrder::AddressOrder
+                                                         : TargetOrder::FallThroughFirst);
 
     // Similarly, we have a set of CallStatement pointers. These may be
     // disregarded if this is a speculative decode that fails (i.e. an illegal
@@ -650,9 +653,15 @@ bool SPARCFrontEnd::processProc(UserProc *proc, Address addr)
 
                 LOG_ERROR("Invalid or unrecognized instruction at address %1: %2", addr,
                           instructionString);
+
+                // The speculative decode failed; none of the code belongs to the procedure
+                m_program->removeDecodedCode(proc);
+                m_targetQueue.addStats(_targetQueue.getStats());
                 return false;
             }
 
+            m_program->addDecodedCode(proc, addr, addr + inst.numBytes);
+
             // Don't display the RTL here; do it after the switch statement in case the delay slot
             // instruction is moved before this one
 
@@ -1051,6 +1060,8 @@ bool SPARCFrontEnd::processProc(UserProc *proc, Address addr)
     // MVE: Not 100% sure this is the right place for this
     proc->setEntryBB();
 
+    // Report the targets of this procedure together with those of other procedures
+    m_targetQueue.addStats(_targetQueue.getStats());
     return true;
 }
 
@@ -37,6 +37,15 @@ public:
      */
     virtual void initialize(BinaryImage *image, BinarySymbolTable *symbols) = 0;
 
+    /**
+     * Allow the loader to decode large tables (e.g. symbol tables) in parallel.
+     * Loaders that always load sequentially ignore this.
+     * \param numThreads          maximum number of threads (0 = one per CPU core)
+     * \param minEntriesPerThread tables are only split between threads if each thread
+     *                            gets at least this many entries
+     */
+    virtual void setThreading(int /*numThreads*/, int /*minEntriesPerThread*/) {}
+
     /// Checks if the file can be loaded by this loader.
     /// If the file can be loaded, the function returns a score ( > 0)
     /// corresponding to the number of bytes checked.
@@ -75,13 +84,6 @@ public:
     virtual Address getEntryPoint() = 0;
 
 public:
-    /// Relocation functions
-    virtual bool isRelocationAt(Address addr)
-    {
-        Q_UNUSED(addr);
-        return false;
-    }
-
     /// \returns the target of the jmp/jXX instruction at address \p addr.
     /// If there is no jump at address \p addr, returns Address::INVALID.
     virtual Address getJumpTarget(Address addr) const
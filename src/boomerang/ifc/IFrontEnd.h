@@ -60,6 +60,11 @@ public:
     /// \returns true if decoded successfully.
     virtual bool decodeUndecoded() = 0;
 
+    /// Find and decode functions that are not reachable from the decoded functions
+    /// by a linear sweep over the code sections.
+    /// \returns true if decoded successfully.
+    virtual bool decodeLinearSweep() = 0;
+
     /// Decode a fragment of a procedure, e.g. for each destination of a switch statement
     /// \returns true iff decoded successfully.
     virtual bool decodeFragment(UserProc *proc, Address addr) = 0;
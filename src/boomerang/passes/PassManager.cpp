@@ -40,6 +40,7 @@
 #include "boomerang/passes/middle/StrengthReductionReversalPass.h"
 #include "boomerang/util/Util.h"
 #include "boomerang/util/log/Log.h"
+#include "boomerang/util/log/Trace.h"
 
 #include <cassert>
 
@@ -121,6 +122,8 @@ bool PassManager::executePass(PassID passID, UserProc *proc)
 bool PassManager::executePass(IPass *pass, UserProc *proc)
 {
     assert(pass != nullptr);
+    TRACE_SPAN(pass->getName(), proc);
+
     LOG_VERBOSE("Executing pass '%1' for '%2'", pass->getName(), proc->getName());
 
     const bool changed = pass->execute(proc);
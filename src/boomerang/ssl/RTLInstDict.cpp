@@ -10,6 +10,7 @@
 #include "RTLInstDict.h"
 
 #include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/RTLInstDictCache.h"
 #include "boomerang/ssl/exp/Binary.h"
 #include "boomerang/ssl/exp/Const.h"
 #include "boomerang/ssl/exp/Location.h"
@@ -63,6 +64,32 @@ int RTLInstDict::insert(const QString &name, std::list<QString> &params, const R
 
 
 bool RTLInstDict::readSSLFile(const QString &SSLFileName)
+{
+    const QByteArray sslHash    = RTLInstDictCache::hashSSLFile(SSLFileName);
+    const QString cacheFileName = RTLInstDictCache::getCacheFileName(SSLFileName);
+
+    // Loading the cache also clears all state
+    if (sslHash.isEmpty() || !RTLInstDictCache::load(*this, cacheFileName, sslHash)) {
+        if (!parseSSLFile(SSLFileName)) {
+            return false;
+        }
+        else if (!sslHash.isEmpty()) {
+            RTLInstDictCache::save(*this, cacheFileName, sslHash);
+        }
+    }
+
+    if (m_verboseOutput) {
+        OStream q_cout(stdout);
+        q_cout << "\n=======Expanded RTL template dictionary=======\n";
+        print(q_cout);
+        q_cout << "\n==============================================\n\n";
+    }
+
+    return true;
+}
+
+
+bool RTLInstDict::parseSSLFile(const QString &SSLFileName)
 {
     // emptying the rtl dictionary
     idict.clear();
@@ -89,14 +116,7 @@ bool RTLInstDict::readSSLFile(const QString &SSLFileName)
     theParser.yyparse(*this);
 
     fixupParams();
-
-    if (m_verboseOutput) {
-        OStream q_cout(stdout);
-        q_cout << "\n=======Expanded RTL template dictionary=======\n";
-        print(q_cout);
-        q_cout << "\n==============================================\n\n";
-    }
-
+    assignInstructionIDs();
     return true;
 }
 
@@ -281,6 +301,21 @@ std::unique_ptr<RTL> RTLInstDict::instantiateRTL(const QString &name, Address na
 }
 
 
+int RTLInstDict::getInstructionID(const char *name) const
+{
+    return m_instructionIDs.value(QString(name).remove('.').toUpper(), -1);
+}
+
+
+std::unique_ptr<RTL> RTLInstDict::instantiateRTL(int id, Address pc,
+                                                 const std::vector<SharedExp> &actuals)
+{
+    assert(0 <= id && id < getNumInstructions());
+    TableEntry *entry = m_instructions[id];
+    return instantiateRTL(entry->m_rtl, pc, entry->m_params, actuals);
+}
+
+
 std::unique_ptr<RTL> RTLInstDict::instantiateRTL(RTL &existingRTL, Address natPC,
                                                  std::list<QString> &params,
                                                  const std::vector<SharedExp> &actuals)
@@ -484,5 +519,19 @@ void RTLInstDict::reset()
     AliasMap.clear();
     fastMap.clear();
     idict.clear();
+    m_instructions.clear();
+    m_instructionIDs.clear();
     fetchExecCycle = nullptr;
 }
+
+
+void RTLInstDict::assignInstructionIDs()
+{
+    m_instructions.clear();
+    m_instructionIDs.clear();
+
+    for (auto &[name, entry] : idict) {
+        m_instructionIDs.insert(name, getNumInstructions());
+        m_instructions.push_back(&entry);
+    }
+}
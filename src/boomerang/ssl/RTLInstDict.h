@@ -15,9 +15,11 @@
 #include "boomerang/util/Address.h"
 #include "boomerang/util/ByteUtil.h"
 
+#include <QHash>
 #include <QMap>
 #include <QString>
 
+#include <cassert>
 #include <list>
 #include <map>
 #include <memory>
@@ -103,6 +105,7 @@ class BOOMERANG_API RTLInstDict
 {
     friend class SSLParser;
     friend class NJMCDecoder;
+    friend class RTLInstDictCache;
 
 public:
     RTLInstDict(bool verboseOutput = false) { m_verboseOutput = verboseOutput; }
@@ -118,6 +121,9 @@ public:
     /**
      * Read and parse the SSL file, and initialise the expanded instruction dictionary
      * (this object). This also reads and sets up the register map and flag functions.
+     * If a valid binary cache of the parsed SSL file exists, it is loaded instead;
+     * otherwise, the SSL file is parsed and the cache is (re-)created.
+     * \sa RTLInstDictCache
      *
      * \param sslFileName the name of the file containing the SSL specification.
      * \returns           true if the file was read successfully.
@@ -137,10 +143,41 @@ public:
     std::unique_ptr<RTL> instantiateRTL(const QString &name, Address pc,
                                         const std::vector<SharedExp> &actuals);
 
+    /**
+     * \returns the ID of the instruction with name \p name (in the same format as for
+     * \ref getSignature), or -1 if there is no such instruction.
+     * IDs are assigned densely when the SSL file is read, so decoders can look up
+     * the ID of an instruction once and instantiate it by ID afterwards.
+     */
+    int getInstructionID(const char *name) const;
+
+    /// \returns the number of instructions in the dictionary.
+    /// Instruction IDs are in the range [0, getNumInstructions()).
+    int getNumInstructions() const { return static_cast<int>(m_instructions.size()); }
+
+    /// \returns the number of parameters of the instruction with ID \p id
+    std::size_t getNumParams(int id) const
+    {
+        assert(0 <= id && id < getNumInstructions());
+        return m_instructions[id]->m_params.size();
+    }
+
+    /**
+     * Returns an RTL containing the semantics of the instruction with ID \p id.
+     * \sa getInstructionID
+     */
+    std::unique_ptr<RTL> instantiateRTL(int id, Address pc, const std::vector<SharedExp> &actuals);
+
 private:
+    /// Parse the SSL file \p sslFileName without using the cache.
+    bool parseSSLFile(const QString &sslFileName);
+
     /// Reset the object to "undo" a readSSLFile()
     void reset();
 
+    /// Assign IDs to all instructions of the dictionary. Called after the dictionary is loaded.
+    void assignInstructionIDs();
+
     /**
      * Returns an instance of a register transfer list for the parameterized rtlist with the given
      * formals replaced with the actuals given as the third parameter.
@@ -254,4 +291,7 @@ private:
 
     /// The actual dictionary.
     std::map<QString, TableEntry, std::less<QString>> idict;
+
+    std::vector<TableEntry *> m_instructions; ///< entries of idict, indexed by instruction ID
+    QHash<QString, int> m_instructionIDs;     ///< instruction name -> instruction ID
 };
@@ -0,0 +1,313 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "RTLInstDictCache.h"
+
+#include "boomerang/ssl/RTLInstDict.h"
+#include "boomerang/ssl/Serializer.h"
+#include "boomerang/util/log/Log.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+
+
+/// Identifies boomerang SSL cache files ("BSSL")
+static const quint32 CACHE_MAGIC = 0x4253534C;
+
+/// Increment this whenever the cache file format changes.
+static const quint32 CACHE_VERSION = 2;
+
+/// Cache files are only valid for the build of Boomerang that wrote them,
+/// since the SSL parser or the layout of expressions may have changed in between.
+static const QString CACHE_BUILD = QString(BOOMERANG_VERSION);
+
+
+static void writeRegister(QDataStream &os, const Register &reg)
+{
+    os << reg.getName() << static_cast<quint16>(reg.getSize()) << reg.isFloat()
+       << static_cast<qint32>(reg.getMappedIndex()) << static_cast<qint32>(reg.getMappedOffset());
+}
+
+
+static Register readRegister(QDataStream &is)
+{
+    QString name;
+    quint16 size;
+    bool isFloat;
+    qint32 mappedIndex, mappedOffset;
+
+    is >> name >> size >> isFloat >> mappedIndex >> mappedOffset;
+
+    Register reg(name, size, isFloat);
+    reg.setMappedIndex(mappedIndex);
+    reg.setMappedOffset(mappedOffset);
+    return reg;
+}
+
+
+static bool writeParam(QDataStream &os, SerialWriter &writer, const ParamEntry &param)
+{
+    writer.writeStrings(param.m_params);
+    writer.writeStrings(param.m_funcParams);
+    os << param.m_lhs << static_cast<qint32>(param.m_kind);
+
+    os << static_cast<quint32>(param.m_regIdx.size());
+    for (int idx : param.m_regIdx) {
+        os << static_cast<qint32>(idx);
+    }
+
+    return writer.writeStmt(param.m_asgn) && writer.writeType(param.m_regType);
+}
+
+
+static void readParam(QDataStream &is, SerialReader &reader, ParamEntry &param)
+{
+    param.m_params     = reader.readStrings();
+    param.m_funcParams = reader.readStrings();
+
+    qint32 kind;
+    is >> param.m_lhs >> kind;
+    param.m_kind = static_cast<ParamKind>(kind);
+
+    quint32 numRegIdx;
+    is >> numRegIdx;
+    for (quint32 i = 0; i < numRegIdx && reader.ok(); i++) {
+        qint32 idx;
+        is >> idx;
+        param.m_regIdx.insert(idx);
+    }
+
+    param.m_asgn    = reader.readStmt();
+    param.m_regType = reader.readType();
+}
+
+
+QString RTLInstDictCache::getCacheFileName(const QString &sslFileName)
+{
+    return sslFileName + ".cache";
+}
+
+
+QByteArray RTLInstDictCache::hashSSLFile(const QString &sslFileName)
+{
+    QFile sslFile(sslFileName);
+
+    if (!sslFile.open(QFile::ReadOnly)) {
+        return QByteArray();
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(sslFile.readAll());
+    return hash.result();
+}
+
+
+bool RTLInstDictCache::load(RTLInstDict &dict, const QString &cacheFileName,
+                            const QByteArray &sslHash)
+{
+    dict.reset();
+
+    QFile cacheFile(cacheFileName);
+    if (!cacheFile.open(QFile::ReadOnly)) {
+        return false;
+    }
+
+    const QByteArray data = cacheFile.readAll();
+    QDataStream is(data);
+    is.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic, version;
+    QString build;
+    qint32 numOpers;
+    QByteArray hash;
+    is >> magic >> version >> build >> numOpers >> hash;
+
+    if (is.status() != QDataStream::Ok || magic != CACHE_MAGIC || version != CACHE_VERSION ||
+        build != CACHE_BUILD || numOpers != static_cast<qint32>(opNumOf) || hash != sslHash) {
+        LOG_VERBOSE("SSL cache file '%1' is outdated, ignoring", cacheFileName);
+        return false;
+    }
+
+    SerialReader reader(is);
+    quint32 count;
+
+    qint32 endianness;
+    is >> endianness;
+    dict.m_bigEndian = static_cast<Endian>(endianness);
+
+    is >> count;
+    for (quint32 i = 0; i < count && reader.ok(); i++) {
+        QString name;
+        qint32 id;
+        is >> name >> id;
+        dict.RegMap[name] = id;
+    }
+
+    is >> count;
+    for (quint32 i = 0; i < count && reader.ok(); i++) {
+        qint32 id;
+        is >> id;
+        dict.DetRegMap.insert({ id, readRegister(is) });
+    }
+
+    is >> count;
+    for (quint32 i = 0; i < count && reader.ok(); i++) {
+        QString name;
+        is >> name;
+        dict.SpecialRegMap.insert({ name, readRegister(is) });
+    }
+
+    is >> count;
+    for (quint32 i = 0; i < count && reader.ok(); i++) {
+        QString name;
+        is >> name;
+        dict.ParamSet.insert(name);
+    }
+
+    is >> count;
+    for (quint32 i = 0; i < count && reader.ok(); i++) {
+        QString name;
+        is >> name;
+        readParam(is, reader, dict.DetParamMap[name]);
+    }
+
+    is >> count;
+    for (quint32 i = 0; i < count && reader.ok(); i++) {
+        QString name;
+        is >> name;
+        dict.FlagFuncs[name] = reader.readExp();
+    }
+
+    is >> count;
+    for (quint32 i = 0; i < count && reader.ok(); i++) {
+        QString from, to;
+        is >> from >> to;
+        dict.fastMap[from] = to;
+    }
+
+    is >> count;
+    for (quint32 i = 0; i < count && reader.ok(); i++) {
+        qint32 id;
+        is >> id;
+        dict.AliasMap[id] = reader.readExp();
+    }
+
+    dict.fetchExecCycle = reader.readRTL();
+
+    is >> count;
+    for (quint32 i = 0; i < count && reader.ok(); i++) {
+        QString name;
+        is >> name;
+
+        TableEntry &entry = dict.idict[name];
+        entry.m_params    = reader.readStrings();
+
+        std::unique_ptr<RTL> rtl = reader.readRTL();
+        if (rtl) {
+            entry.m_rtl = std::move(*rtl);
+        }
+    }
+
+    if (!reader.ok() || !is.atEnd()) {
+        LOG_WARN("SSL cache file '%1' is corrupt, ignoring", cacheFileName);
+        dict.reset();
+        return false;
+    }
+
+    dict.assignInstructionIDs();
+    return true;
+}
+
+
+bool RTLInstDictCache::save(const RTLInstDict &dict, const QString &cacheFileName,
+                            const QByteArray &sslHash)
+{
+    QByteArray data;
+    QDataStream os(&data, QIODevice::WriteOnly);
+    os.setVersion(QDataStream::Qt_5_0);
+
+    os << CACHE_MAGIC << CACHE_VERSION << CACHE_BUILD << static_cast<qint32>(opNumOf) << sslHash;
+
+    SerialWriter writer(os);
+    bool ok = true;
+
+    os << static_cast<qint32>(dict.m_bigEndian);
+
+    os << static_cast<quint32>(dict.RegMap.size());
+    for (const auto &[name, id] : dict.RegMap) {
+        os << name << static_cast<qint32>(id);
+    }
+
+    os << static_cast<quint32>(dict.DetRegMap.size());
+    for (const auto &[id, reg] : dict.DetRegMap) {
+        os << static_cast<qint32>(id);
+        writeRegister(os, reg);
+    }
+
+    os << static_cast<quint32>(dict.SpecialRegMap.size());
+    for (const auto &[name, reg] : dict.SpecialRegMap) {
+        os << name;
+        writeRegister(os, reg);
+    }
+
+    os << static_cast<quint32>(dict.ParamSet.size());
+    for (const QString &name : dict.ParamSet) {
+        os << name;
+    }
+
+    os << static_cast<quint32>(dict.DetParamMap.size());
+    for (auto it = dict.DetParamMap.begin(); ok && it != dict.DetParamMap.end(); ++it) {
+        os << it.key();
+        ok = writeParam(os, writer, it.value());
+    }
+
+    os << static_cast<quint32>(dict.FlagFuncs.size());
+    for (auto it = dict.FlagFuncs.begin(); ok && it != dict.FlagFuncs.end(); ++it) {
+        os << it->first;
+        ok = writer.writeExp(it->second);
+    }
+
+    os << static_cast<quint32>(dict.fastMap.size());
+    for (const auto &[from, to] : dict.fastMap) {
+        os << from << to;
+    }
+
+    os << static_cast<quint32>(dict.AliasMap.size());
+    for (auto it = dict.AliasMap.begin(); ok && it != dict.AliasMap.end(); ++it) {
+        os << static_cast<qint32>(it->first);
+        ok = writer.writeExp(it->second);
+    }
+
+    ok = ok && writer.writeRTL(dict.fetchExecCycle.get());
+
+    os << static_cast<quint32>(dict.idict.size());
+    for (auto it = dict.idict.begin(); ok && it != dict.idict.end(); ++it) {
+        os << it->first;
+        writer.writeStrings(it->second.m_params);
+        ok = writer.writeRTL(&it->second.m_rtl);
+    }
+
+    if (!ok) {
+        LOG_VERBOSE("Cannot write SSL cache file '%1': Dictionary contains unsupported "
+                    "expressions or statements",
+                    cacheFileName);
+        return false;
+    }
+
+    QSaveFile cacheFile(cacheFileName);
+    if (!cacheFile.open(QFile::WriteOnly) || cacheFile.write(data) != data.size() ||
+        !cacheFile.commit()) {
+        LOG_VERBOSE("Cannot write SSL cache file '%1'", cacheFileName);
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,56 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+
+#include <QByteArray>
+#include <QString>
+
+
+class RTLInstDict;
+
+
+/**
+ * Reads and writes fully parsed and expanded RTL dictionaries from/to a binary cache file,
+ * so that the SSL file does not have to be parsed again every time it is loaded.
+ *
+ * A cache file is only considered valid if it was written by the same build of Boomerang
+ * (as given by BOOMERANG_VERSION) and cache format version from an SSL file
+ * with exactly the same contents (as determined by a content hash).
+ * If the cache cannot be read or written for any reason, the SSL file is parsed normally.
+ */
+class BOOMERANG_API RTLInstDictCache
+{
+public:
+    /// \returns the name of the cache file belonging to the SSL file \p sslFileName.
+    static QString getCacheFileName(const QString &sslFileName);
+
+    /// \returns the content hash of the SSL file \p sslFileName,
+    /// or an empty byte array if the file cannot be read.
+    static QByteArray hashSSLFile(const QString &sslFileName);
+
+    /**
+     * Replace the contents of \p dict by the contents of the cache file \p cacheFileName.
+     * \param sslHash content hash of the SSL file the cache file must have been created from.
+     * \returns true if the cache file is valid and was read successfully.
+     * If false is returned, \p dict is left empty.
+     */
+    static bool load(RTLInstDict &dict, const QString &cacheFileName, const QByteArray &sslHash);
+
+    /**
+     * Write the contents of \p dict to the cache file \p cacheFileName.
+     * \param sslHash content hash of the SSL file \p dict was created from.
+     * \returns true if the cache file was written successfully.
+     */
+    static bool save(const RTLInstDict &dict, const QString &cacheFileName,
+                     const QByteArray &sslHash);
+};
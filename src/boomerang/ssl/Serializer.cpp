@@ -0,0 +1,628 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "Serializer.h"
+
+#include "boomerang/db/signature/Signature.h"
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/FlagDef.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/Terminal.h"
+#include "boomerang/ssl/exp/Ternary.h"
+#include "boomerang/ssl/exp/TypedExp.h"
+#include "boomerang/ssl/statements/Assign.h"
+#include "boomerang/ssl/type/ArrayType.h"
+#include "boomerang/ssl/type/BooleanType.h"
+#include "boomerang/ssl/type/CharType.h"
+#include "boomerang/ssl/type/CompoundType.h"
+#include "boomerang/ssl/type/FloatType.h"
+#include "boomerang/ssl/type/FuncType.h"
+#include "boomerang/ssl/type/IntegerType.h"
+#include "boomerang/ssl/type/NamedType.h"
+#include "boomerang/ssl/type/PointerType.h"
+#include "boomerang/ssl/type/SizeType.h"
+#include "boomerang/ssl/type/UnionType.h"
+#include "boomerang/ssl/type/VoidType.h"
+
+#include <QDataStream>
+
+#include <typeinfo>
+
+
+/// Types nested deeper than this are assumed to be cyclic.
+static const int MAX_TYPE_DEPTH = 256;
+
+
+/// Tags identifying the class of serialized expressions
+enum class ExpTag : quint8
+{
+    Null,
+    Const,
+    Terminal,
+    Unary,
+    Binary,
+    Ternary,
+    TypedExp,
+    FlagDef,
+    Location
+};
+
+
+/// Tags identifying the class of serialized statements
+enum class StmtTag : quint8
+{
+    Null,
+    Assign
+};
+
+
+SerialWriter::SerialWriter(QDataStream &os)
+    : m_os(os)
+{
+}
+
+
+bool SerialWriter::writeType(const SharedConstType &ty)
+{
+    if (!ty) {
+        m_os << static_cast<qint8>(-1);
+        return true;
+    }
+    else if (m_typeDepth >= MAX_TYPE_DEPTH) {
+        return false;
+    }
+
+    m_os << static_cast<qint8>(ty->getId());
+
+    m_typeDepth++;
+    const bool ok = writeTypeContents(ty);
+    m_typeDepth--;
+
+    return ok;
+}
+
+
+bool SerialWriter::writeExp(const SharedConstExp &exp)
+{
+    if (!exp) {
+        m_os << static_cast<quint8>(ExpTag::Null);
+        return true;
+    }
+
+    // Note: Subclasses must be checked before their base classes.
+    if (auto flagDef = std::dynamic_pointer_cast<const FlagDef>(exp)) {
+        m_os << static_cast<quint8>(ExpTag::FlagDef);
+        return writeExp(flagDef->getSubExp1()) && writeRTL(flagDef->getRTL().get());
+    }
+    else if (auto typedExp = std::dynamic_pointer_cast<const TypedExp>(exp)) {
+        m_os << static_cast<quint8>(ExpTag::TypedExp);
+        return writeType(typedExp->getType()) && writeExp(typedExp->getSubExp1());
+    }
+    else if (auto loc = std::dynamic_pointer_cast<const Location>(exp)) {
+        if (loc->getProc() != nullptr) {
+            return false;
+        }
+
+        m_os << static_cast<quint8>(ExpTag::Location) << static_cast<qint32>(loc->getOper());
+        return writeExp(loc->getSubExp1());
+    }
+    else if (std::dynamic_pointer_cast<const Ternary>(exp)) {
+        m_os << static_cast<quint8>(ExpTag::Ternary) << static_cast<qint32>(exp->getOper());
+        return writeExp(exp->getSubExp1()) && writeExp(exp->getSubExp2()) &&
+               writeExp(exp->getSubExp3());
+    }
+    else if (std::dynamic_pointer_cast<const Binary>(exp)) {
+        m_os << static_cast<quint8>(ExpTag::Binary) << static_cast<qint32>(exp->getOper());
+        return writeExp(exp->getSubExp1()) && writeExp(exp->getSubExp2());
+    }
+    else if (typeid(*exp) == typeid(Unary)) {
+        m_os << static_cast<quint8>(ExpTag::Unary) << static_cast<qint32>(exp->getOper());
+        return writeExp(exp->getSubExp1());
+    }
+    else if (auto c = std::dynamic_pointer_cast<const Const>(exp)) {
+        m_os << static_cast<quint8>(ExpTag::Const) << static_cast<qint32>(c->getOper());
+
+        switch (c->getOper()) {
+        case opIntConst: m_os << static_cast<qint32>(c->getInt()); break;
+        case opLongConst: m_os << static_cast<quint64>(c->getLong()); break;
+        case opFltConst: m_os << c->getFlt(); break;
+        case opStrConst: m_os << c->getStr(); break;
+        default: return false;
+        }
+
+        return writeType(c->getType());
+    }
+    else if (typeid(*exp) == typeid(Terminal)) {
+        m_os << static_cast<quint8>(ExpTag::Terminal) << static_cast<qint32>(exp->getOper());
+        return true;
+    }
+
+    return false; // RefExp etc. are never created by parsers
+}
+
+
+bool SerialWriter::writeStmt(const Statement *stmt)
+{
+    if (!stmt) {
+        m_os << static_cast<quint8>(StmtTag::Null);
+        return true;
+    }
+    else if (!stmt->isAssign()) {
+        return false;
+    }
+
+    const Assign *asgn = static_cast<const Assign *>(stmt);
+    m_os << static_cast<quint8>(StmtTag::Assign);
+
+    return writeType(asgn->getType()) && writeExp(asgn->getLeft()) &&
+           writeExp(asgn->getRight()) && writeExp(asgn->getGuard());
+}
+
+
+bool SerialWriter::writeRTL(const RTL *rtl)
+{
+    if (!rtl) {
+        m_os << static_cast<qint8>(0);
+        return true;
+    }
+
+    m_os << static_cast<qint8>(1) << static_cast<quint64>(rtl->getAddress().value())
+         << static_cast<quint32>(rtl->size());
+
+    for (const Statement *stmt : *rtl) {
+        if (!writeStmt(stmt)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+bool SerialWriter::writeSignature(const Signature *sig)
+{
+    if (!sig) {
+        m_os << static_cast<qint8>(0);
+        return true;
+    }
+
+    m_os << static_cast<qint8>(1) << sig->getName()
+         << static_cast<qint32>(sig->getConvention()) << sig->hasEllipsis() << sig->isUnknown()
+         << sig->isForced() << sig->getPreferredName() << sig->getSigFilePath();
+
+    m_os << static_cast<quint32>(sig->getNumParams());
+    for (const std::shared_ptr<Parameter> &param : sig->getParameters()) {
+        m_os << param->getName() << param->getBoundMax();
+
+        if (!writeType(param->getType()) || !writeExp(param->getExp())) {
+            return false;
+        }
+    }
+
+    m_os << static_cast<quint32>(sig->getNumReturns());
+    for (int i = 0; i < sig->getNumReturns(); i++) {
+        if (!writeType(sig->getReturnType(i)) || !writeExp(sig->getReturnExp(i))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+bool SerialWriter::writeTypeContents(const SharedConstType &ty)
+{
+    switch (ty->getId()) {
+    case TypeClass::Void:
+    case TypeClass::Boolean:
+    case TypeClass::Char: return true;
+
+    case TypeClass::Integer:
+        m_os << static_cast<quint32>(ty->getSize())
+             << static_cast<qint8>(ty->as<IntegerType>()->getSign());
+        return true;
+
+    case TypeClass::Float:
+    case TypeClass::Size: m_os << static_cast<quint32>(ty->getSize()); return true;
+
+    case TypeClass::Named: m_os << ty->as<NamedType>()->getName(); return true;
+
+    case TypeClass::Pointer: return writeType(ty->as<PointerType>()->getPointsTo());
+
+    case TypeClass::Array: {
+        auto arrayTy = ty->as<ArrayType>();
+        m_os << static_cast<quint64>(arrayTy->getLength());
+        return writeType(arrayTy->getBaseType());
+    }
+
+    case TypeClass::Compound: {
+        // the member accessors of CompoundType are not const
+        auto compTy = std::const_pointer_cast<Type>(ty)->as<CompoundType>();
+        m_os << compTy->isGeneric() << static_cast<qint32>(compTy->getNumMembers());
+
+        for (int i = 0; i < compTy->getNumMembers(); i++) {
+            m_os << compTy->getMemberNameByIdx(i);
+
+            if (!writeType(compTy->getMemberTypeByIdx(i))) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    case TypeClass::Union: {
+        auto unionTy = std::const_pointer_cast<Type>(ty)->as<UnionType>();
+        m_os << static_cast<quint32>(unionTy->getNumTypes());
+
+        for (const UnionElement &elem : *unionTy) {
+            m_os << elem.name;
+
+            if (!writeType(elem.type)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    case TypeClass::Func:
+        return writeSignature(std::const_pointer_cast<Type>(ty)->as<FuncType>()->getSignature());
+    }
+
+    return false;
+}
+
+
+void SerialWriter::writeStrings(const std::list<QString> &strings)
+{
+    m_os << static_cast<quint32>(strings.size());
+    for (const QString &s : strings) {
+        m_os << s;
+    }
+}
+
+
+SerialReader::SerialReader(QDataStream &is, Machine machine)
+    : m_is(is)
+    , m_machine(machine)
+{
+}
+
+
+bool SerialReader::ok() const
+{
+    return m_ok && m_is.status() == QDataStream::Ok;
+}
+
+
+SharedType SerialReader::readType()
+{
+    if (!ok()) {
+        return nullptr;
+    }
+
+    qint8 id;
+    m_is >> id;
+
+    if (id == -1) {
+        return nullptr;
+    }
+
+    switch (static_cast<TypeClass>(id)) {
+    case TypeClass::Void: return VoidType::get();
+    case TypeClass::Boolean: return BooleanType::get();
+    case TypeClass::Char: return CharType::get();
+
+    case TypeClass::Integer: {
+        quint32 size;
+        qint8 sign;
+        m_is >> size >> sign;
+        return IntegerType::get(size, static_cast<Sign>(sign));
+    }
+
+    case TypeClass::Float: {
+        quint32 size;
+        m_is >> size;
+        return FloatType::get(size);
+    }
+
+    case TypeClass::Size: {
+        quint32 size;
+        m_is >> size;
+        return SizeType::get(size);
+    }
+
+    case TypeClass::Named: {
+        QString name;
+        m_is >> name;
+        return NamedType::get(name);
+    }
+
+    case TypeClass::Pointer: return PointerType::get(readType());
+
+    case TypeClass::Array: {
+        quint64 length;
+        m_is >> length;
+        return ArrayType::get(readType(), static_cast<unsigned>(length));
+    }
+
+    case TypeClass::Compound: {
+        bool isGeneric;
+        qint32 numMembers;
+        m_is >> isGeneric >> numMembers;
+
+        std::shared_ptr<CompoundType> result = std::make_shared<CompoundType>(isGeneric);
+        for (qint32 i = 0; i < numMembers && ok(); i++) {
+            QString name;
+            m_is >> name;
+            result->addMember(readType(), name);
+        }
+
+        return result;
+    }
+
+    case TypeClass::Union: {
+        quint32 numTypes;
+        m_is >> numTypes;
+
+        std::shared_ptr<UnionType> result = UnionType::get();
+        for (quint32 i = 0; i < numTypes && ok(); i++) {
+            QString name;
+            m_is >> name;
+            result->addType(readType(), name);
+        }
+
+        return result;
+    }
+
+    case TypeClass::Func: return FuncType::get(readSignature());
+    }
+
+    return fail<SharedType>();
+}
+
+
+SharedExp SerialReader::readExp()
+{
+    if (!ok()) {
+        return nullptr;
+    }
+
+    quint8 tag;
+    m_is >> tag;
+
+    switch (static_cast<ExpTag>(tag)) {
+    case ExpTag::Null: return nullptr;
+
+    case ExpTag::Const: {
+        std::shared_ptr<Const> result;
+
+        switch (readOper()) {
+        case opIntConst: {
+            qint32 value;
+            m_is >> value;
+            result = Const::get(static_cast<int>(value));
+            break;
+        }
+
+        case opLongConst: {
+            quint64 value;
+            m_is >> value;
+            result = Const::get(static_cast<QWord>(value));
+            break;
+        }
+
+        case opFltConst: {
+            double value;
+            m_is >> value;
+            result = Const::get(value);
+            break;
+        }
+
+        case opStrConst: {
+            QString value;
+            m_is >> value;
+            result = Const::get(value);
+            break;
+        }
+
+        default: return fail<SharedExp>();
+        }
+
+        result->setType(readType());
+        return result;
+    }
+
+    case ExpTag::Terminal: return Terminal::get(readOper());
+
+    case ExpTag::Unary: {
+        const OPER op = readOper();
+        return Unary::get(op, readExp());
+    }
+
+    case ExpTag::Binary: {
+        const OPER op       = readOper();
+        const SharedExp lhs = readExp();
+        return Binary::get(op, lhs, readExp());
+    }
+
+    case ExpTag::Ternary: {
+        const OPER op      = readOper();
+        const SharedExp e1 = readExp();
+        const SharedExp e2 = readExp();
+        return Ternary::get(op, e1, e2, readExp());
+    }
+
+    case ExpTag::TypedExp: {
+        const SharedType ty = readType();
+        return std::make_shared<TypedExp>(ty, readExp());
+    }
+
+    case ExpTag::FlagDef: {
+        const SharedExp params = readExp();
+        return std::make_shared<FlagDef>(params, SharedRTL(readRTL()));
+    }
+
+    case ExpTag::Location: {
+        const OPER op = readOper();
+        return Location::get(op, readExp(), nullptr);
+    }
+    }
+
+    return fail<SharedExp>();
+}
+
+
+Statement *SerialReader::readStmt()
+{
+    if (!ok()) {
+        return nullptr;
+    }
+
+    quint8 tag;
+    m_is >> tag;
+
+    if (static_cast<StmtTag>(tag) == StmtTag::Null) {
+        return nullptr;
+    }
+    else if (static_cast<StmtTag>(tag) != StmtTag::Assign) {
+        return fail<Statement *>();
+    }
+
+    const SharedType ty   = readType();
+    const SharedExp lhs   = readExp();
+    const SharedExp rhs   = readExp();
+    const SharedExp guard = readExp();
+
+    if (!ok() || !lhs || !rhs) {
+        return fail<Statement *>();
+    }
+
+    return new Assign(ty, lhs, rhs, guard);
+}
+
+
+std::unique_ptr<RTL> SerialReader::readRTL()
+{
+    if (!ok()) {
+        return nullptr;
+    }
+
+    qint8 present;
+    m_is >> present;
+
+    if (present == 0) {
+        return nullptr;
+    }
+
+    quint64 addr;
+    quint32 numStmts;
+    m_is >> addr >> numStmts;
+
+    std::unique_ptr<RTL> rtl(new RTL(Address(addr)));
+
+    for (quint32 i = 0; i < numStmts && ok(); i++) {
+        Statement *stmt = readStmt();
+        if (stmt) {
+            rtl->append(stmt);
+        }
+    }
+
+    return rtl;
+}
+
+
+std::shared_ptr<Signature> SerialReader::readSignature()
+{
+    if (!ok()) {
+        return nullptr;
+    }
+
+    qint8 present;
+    m_is >> present;
+
+    if (present == 0) {
+        return nullptr;
+    }
+
+    QString name, preferredName, sigFile;
+    qint32 cc;
+    bool ellipsis, unknown, forced;
+
+    m_is >> name >> cc >> ellipsis >> unknown >> forced >> preferredName >> sigFile;
+
+    std::shared_ptr<Signature> sig = static_cast<CallConv>(cc) != CallConv::INVALID
+                                         ? Signature::instantiate(m_machine,
+                                                                  static_cast<CallConv>(cc), name)
+                                         : std::make_shared<Signature>(name);
+
+    // Replace the parameters and returns the constructor might have added
+    // by the ones that were written.
+    sig->m_params.clear();
+    sig->m_returns.clear();
+
+    sig->setHasEllipsis(ellipsis);
+    sig->setUnknown(unknown);
+    sig->setForced(forced);
+    sig->setPreferredName(preferredName);
+    sig->setSigFilePath(sigFile);
+
+    quint32 numParams;
+    m_is >> numParams;
+    for (quint32 i = 0; i < numParams && ok(); i++) {
+        QString paramName, boundMax;
+        m_is >> paramName >> boundMax;
+
+        const SharedType ty = readType();
+        const SharedExp exp = readExp();
+        sig->m_params.push_back(std::make_shared<Parameter>(ty, paramName, exp, boundMax));
+    }
+
+    quint32 numReturns;
+    m_is >> numReturns;
+    for (quint32 i = 0; i < numReturns && ok(); i++) {
+        const SharedType ty = readType();
+        const SharedExp exp = readExp();
+        sig->m_returns.push_back(std::make_shared<Return>(ty, exp));
+    }
+
+    return ok() ? sig : nullptr;
+}
+
+
+std::list<QString> SerialReader::readStrings()
+{
+    std::list<QString> result;
+    quint32 count;
+    m_is >> count;
+
+    for (quint32 i = 0; i < count && ok(); i++) {
+        QString s;
+        m_is >> s;
+        result.push_back(s);
+    }
+
+    return result;
+}
+
+
+OPER SerialReader::readOper()
+{
+    qint32 op;
+    m_is >> op;
+
+    if (op < opWild || op >= opNumOf) {
+        return fail<OPER>(opNil);
+    }
+
+    return static_cast<OPER>(op);
+}
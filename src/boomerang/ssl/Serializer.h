@@ -0,0 +1,109 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/db/binary/BinaryFile.h"
+#include "boomerang/ssl/exp/ExpHelp.h"
+#include "boomerang/ssl/exp/Operator.h"
+
+#include <QString>
+
+#include <list>
+#include <memory>
+
+
+class QDataStream;
+class RTL;
+class Signature;
+class Statement;
+class Type;
+
+using SharedType      = std::shared_ptr<Type>;
+using SharedConstType = std::shared_ptr<const Type>;
+
+
+/**
+ * Writes expressions, types, statements, RTLs and signatures to a binary stream,
+ * e.g. for caching the results of parsing SSL or C header files.
+ * Only the kinds of objects that are created by the parsers are supported;
+ * if an object cannot be serialized, the corresponding write function returns false
+ * and the contents of the stream must be discarded.
+ *
+ * \sa SerialReader
+ */
+class BOOMERANG_API SerialWriter
+{
+public:
+    SerialWriter(QDataStream &os);
+
+public:
+    /// \returns false if \p ty cannot be serialized.
+    bool writeType(const SharedConstType &ty);
+
+    /// \returns false if \p exp cannot be serialized.
+    bool writeExp(const SharedConstExp &exp);
+
+    /// \returns false if \p stmt cannot be serialized.
+    bool writeStmt(const Statement *stmt);
+
+    /// \returns false if \p rtl cannot be serialized.
+    bool writeRTL(const RTL *rtl);
+
+    /// \returns false if \p sig cannot be serialized.
+    bool writeSignature(const Signature *sig);
+
+    void writeStrings(const std::list<QString> &strings);
+
+private:
+    bool writeTypeContents(const SharedConstType &ty);
+
+private:
+    QDataStream &m_os;
+    int m_typeDepth = 0; ///< to detect cyclic types
+};
+
+
+/**
+ * Reads objects written by SerialWriter from a binary stream.
+ * Reading stops at the first error; check ok() after reading.
+ */
+class BOOMERANG_API SerialReader
+{
+public:
+    /// \param machine the machine signatures are instantiated for.
+    SerialReader(QDataStream &is, Machine machine = Machine::UNKNOWN);
+
+public:
+    /// \returns true if all objects so far were read successfully.
+    bool ok() const;
+
+    SharedType readType();
+    SharedExp readExp();
+    Statement *readStmt();
+    std::unique_ptr<RTL> readRTL();
+    std::shared_ptr<Signature> readSignature();
+    std::list<QString> readStrings();
+
+private:
+    OPER readOper();
+
+    template<typename T>
+    T fail(T result = T())
+    {
+        m_ok = false;
+        return result;
+    }
+
+private:
+    QDataStream &m_is;
+    Machine m_machine;
+    bool m_ok = true;
+};
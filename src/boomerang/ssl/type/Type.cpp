@@ -159,6 +159,12 @@ QString Type::getTempName() const
 }
 
 
+const QMap<QString, SharedType> &Type::getNamedTypes()
+{
+    return g_namedTypes;
+}
+
+
 void Type::clearNamedTypes()
 {
     g_namedTypes.clear();
@@ -11,6 +11,7 @@
 
 #include "boomerang/core/BoomerangAPI.h"
 
+#include <QMap>
 #include <QString>
 
 #include <cassert>
@@ -86,6 +87,9 @@ public:
     /// \returns the actual type of the named type with name \p name
     static SharedType getNamedType(const QString &name);
 
+    /// \returns all named types, by name.
+    static const QMap<QString, SharedType> &getNamedTypes();
+
     /**
      * Given the name of a temporary variable, return its Type
      * \param   name reference to a string (e.g. "tmp", "tmpd")
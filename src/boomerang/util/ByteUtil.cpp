@@ -10,6 +10,7 @@
 #include "ByteUtil.h"
 
 #include <cassert>
+#include <cstring>
 
 
 namespace Util
@@ -63,6 +64,22 @@ QWord readQWord(const void *src, Endian srcEndian)
 }
 
 
+void readDWords(const void *src, DWord *dst, std::size_t count, Endian srcEndian)
+{
+    assert(src && dst);
+    std::memcpy(dst, src, count * sizeof(DWord));
+
+    constexpr Endian myEndian = static_cast<Endian>(BOOMERANG_BIG_ENDIAN);
+    if (myEndian == srcEndian) {
+        return;
+    }
+
+    for (std::size_t i = 0; i < count; i++) {
+        dst[i] = swapEndian(dst[i]);
+    }
+}
+
+
 void writeByte(void *dst, Byte value)
 {
     assert(dst);
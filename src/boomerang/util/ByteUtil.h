@@ -13,6 +13,7 @@
 #include "boomerang/core/BoomerangAPI.h"
 #include "boomerang/util/Types.h"
 
+#include <cstddef>
 #include <initializer_list>
 #include <type_traits>
 
@@ -79,6 +80,13 @@ BOOMERANG_API SWord readWord(const void *src, Endian srcEndian);
 BOOMERANG_API DWord readDWord(const void *src, Endian srcEndian);
 BOOMERANG_API QWord readQWord(const void *src, Endian srcEndian);
 
+/**
+ * Read \p count consecutive 32 bit values from \p src to \p dst, respecting endianness.
+ * For large arrays, this is much faster than reading the values one by one,
+ * since all values are swapped in a single loop that can be vectorized.
+ */
+BOOMERANG_API void readDWords(const void *src, DWord *dst, std::size_t count, Endian srcEndian);
+
 
 /// Write values to \p dst, respecting endianness
 BOOMERANG_API void writeByte(void *dst, Byte value);
@@ -0,0 +1,181 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/util/Types.h"
+
+#include <cassert>
+#include <vector>
+
+
+/**
+ * An open addressing (linear probing) hash index that maps hash values
+ * to indices of elements stored in an external container.
+ * The keys themselves are not stored in the index; instead, the owner supplies
+ * a predicate to check whether the element at a given index matches the key.
+ * This way, keys (e.g. names) are only stored once, in the elements themselves.
+ */
+class HashIndex
+{
+    struct Slot
+    {
+        uint32 hash = 0;
+        int value   = -1; ///< -1 if the slot is empty
+    };
+
+public:
+    static constexpr int NOT_FOUND = -1;
+
+public:
+    /// \returns the number of elements in this index.
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    /// Remove all elements from this index.
+    void clear()
+    {
+        m_slots.clear();
+        m_size = 0;
+    }
+
+    /// Make sure \p numElements can be stored without rehashing.
+    void reserve(std::size_t numElements)
+    {
+        // keep the load factor <= 0.5
+        if (2 * numElements > m_slots.size()) {
+            rehash(2 * numElements);
+        }
+    }
+
+    /**
+     * Find the element with hash \p hash for which \p matches returns true.
+     * \param matches predicate taking the index of a candidate element.
+     * \returns the index of the element, or NOT_FOUND.
+     */
+    template<typename Pred>
+    int find(uint32 hash, Pred matches) const
+    {
+        if (m_slots.empty()) {
+            return NOT_FOUND;
+        }
+
+        const std::size_t mask = m_slots.size() - 1;
+
+        for (std::size_t pos = hash & mask;; pos = (pos + 1) & mask) {
+            const Slot &slot = m_slots[pos];
+
+            if (slot.value == NOT_FOUND) {
+                return NOT_FOUND;
+            }
+            else if (slot.hash == hash && matches(slot.value)) {
+                return slot.value;
+            }
+        }
+    }
+
+    /// Insert element index \p value with hash \p hash.
+    /// \note It is not checked whether a matching element already exists.
+    void insert(uint32 hash, int value)
+    {
+        assert(value >= 0);
+        reserve(m_size + 1);
+
+        const std::size_t mask = m_slots.size() - 1;
+        std::size_t pos        = hash & mask;
+
+        while (m_slots[pos].value != NOT_FOUND) {
+            pos = (pos + 1) & mask;
+        }
+
+        m_slots[pos].hash  = hash;
+        m_slots[pos].value = value;
+        m_size++;
+    }
+
+    /**
+     * Remove the element with hash \p hash for which \p matches returns true.
+     * \returns true if an element was removed.
+     */
+    template<typename Pred>
+    bool remove(uint32 hash, Pred matches)
+    {
+        if (m_slots.empty()) {
+            return false;
+        }
+
+        const std::size_t mask = m_slots.size() - 1;
+        std::size_t pos        = hash & mask;
+
+        while (true) {
+            if (m_slots[pos].value == NOT_FOUND) {
+                return false;
+            }
+            else if (m_slots[pos].hash == hash && matches(m_slots[pos].value)) {
+                break;
+            }
+
+            pos = (pos + 1) & mask;
+        }
+
+        // Backward shift deletion: Move subsequent elements of the probe sequence
+        // into the hole so that lookups never need tombstones.
+        std::size_t hole = pos;
+
+        for (std::size_t next = (hole + 1) & mask; m_slots[next].value != NOT_FOUND;
+             next             = (next + 1) & mask) {
+            const std::size_t home = m_slots[next].hash & mask;
+
+            // can the element at next be moved to hole without breaking its probe sequence?
+            const bool canMove = (hole <= next) ? (home <= hole || home > next)
+                                                : (home <= hole && home > next);
+
+            if (canMove) {
+                m_slots[hole] = m_slots[next];
+                hole          = next;
+            }
+        }
+
+        m_slots[hole] = Slot();
+        m_size--;
+        return true;
+    }
+
+private:
+    void rehash(std::size_t minSlots)
+    {
+        std::size_t newSize = 16;
+        while (newSize < minSlots) {
+            newSize *= 2;
+        }
+
+        std::vector<Slot> oldSlots(newSize);
+        std::swap(oldSlots, m_slots);
+
+        const std::size_t mask = m_slots.size() - 1;
+
+        for (const Slot &slot : oldSlots) {
+            if (slot.value == NOT_FOUND) {
+                continue;
+            }
+
+            std::size_t pos = slot.hash & mask;
+            while (m_slots[pos].value != NOT_FOUND) {
+                pos = (pos + 1) & mask;
+            }
+
+            m_slots[pos] = slot;
+        }
+    }
+
+private:
+    std::vector<Slot> m_slots; ///< size is always 0 or a power of 2
+    std::size_t m_size = 0;    ///< number of used slots
+};
@@ -15,9 +15,15 @@
 #include <QTextStream>
 
 
+/// Size of the write-behind buffer for files
+static const int BUFFER_SIZE = 1024 * 1024;
+
+
 OStream::OStream(QFile *tgt)
-    : m_os(new QTextStream(tgt))
+    : m_device(tgt)
+    , m_fmt(new QTextStream(&m_fmtBuffer))
 {
+    m_buffer.reserve(BUFFER_SIZE);
 }
 
 
@@ -34,74 +40,211 @@ OStream::OStream(FILE *tgt)
 
 
 OStream::OStream(QSaveFile *tgt)
-    : m_os(new QTextStream(tgt))
+    : m_device(tgt)
+    , m_fmt(new QTextStream(&m_fmtBuffer))
 {
+    m_buffer.reserve(BUFFER_SIZE);
 }
 
 
 OStream::~OStream()
 {
+    if (m_device) {
+        flush();
+    }
+
     delete m_os;
+    delete m_fmt;
 }
 
 
 OStream &OStream::operator<<(const QString &rhs)
 {
-    *m_os << rhs;
+    if (m_os) {
+        *m_os << rhs;
+    }
+    else if (isFormatted()) {
+        *m_fmt << rhs;
+        writeFormatted();
+    }
+    else {
+        m_buffer.append(rhs.toUtf8());
+        writeBehind();
+    }
+
     return *this;
 }
 
 
 OStream &OStream::operator<<(const QTextStreamManipulator &rhs)
 {
-    *m_os << rhs;
+    if (m_os) {
+        *m_os << rhs;
+    }
+    else {
+        *m_fmt << rhs;
+        writeFormatted();
+    }
+
     return *this;
 }
 
 
 OStream &OStream::operator<<(uint64 rhs)
 {
-    *m_os << rhs;
+    if (m_os) {
+        *m_os << rhs;
+    }
+    else if (isFormatted()) {
+        *m_fmt << rhs;
+        writeFormatted();
+    }
+    else {
+        m_buffer.append(QByteArray::number(static_cast<qulonglong>(rhs)));
+        writeBehind();
+    }
+
     return *this;
 }
 
 
 OStream &OStream::operator<<(int rhs)
 {
-    *m_os << rhs;
+    if (m_os) {
+        *m_os << rhs;
+    }
+    else if (isFormatted()) {
+        *m_fmt << rhs;
+        writeFormatted();
+    }
+    else {
+        m_buffer.append(QByteArray::number(rhs));
+        writeBehind();
+    }
+
     return *this;
 }
 
 
 OStream &OStream::operator<<(unsigned int rhs)
 {
-    *m_os << rhs;
+    if (m_os) {
+        *m_os << rhs;
+    }
+    else if (isFormatted()) {
+        *m_fmt << rhs;
+        writeFormatted();
+    }
+    else {
+        m_buffer.append(QByteArray::number(rhs));
+        writeBehind();
+    }
+
     return *this;
 }
 
 
 OStream &OStream::operator<<(double rhs)
 {
-    *m_os << rhs;
+    if (m_os) {
+        *m_os << rhs;
+    }
+    else {
+        // always use QTextStream for consistent formatting of floating point numbers
+        *m_fmt << rhs;
+        writeFormatted();
+    }
+
     return *this;
 }
 
 
 OStream &OStream::operator<<(const char *rhs)
 {
-    *m_os << rhs;
+    if (m_os) {
+        *m_os << rhs;
+    }
+    else if (isFormatted()) {
+        *m_fmt << rhs;
+        writeFormatted();
+    }
+    else {
+        writeLatin1(rhs, static_cast<int>(qstrlen(rhs)));
+    }
+
     return *this;
 }
 
 
 OStream &OStream::operator<<(char rhs)
 {
-    *m_os << rhs;
+    if (m_os) {
+        *m_os << rhs;
+    }
+    else if (isFormatted()) {
+        *m_fmt << rhs;
+        writeFormatted();
+    }
+    else {
+        writeLatin1(&rhs, 1);
+    }
+
     return *this;
 }
 
 
 void OStream::flush()
 {
-    m_os->flush();
+    if (m_os) {
+        m_os->flush();
+        return;
+    }
+
+    if (!m_buffer.isEmpty()) {
+        m_device->write(m_buffer);
+        m_buffer.resize(0);
+    }
+}
+
+
+bool OStream::isFormatted() const
+{
+    return m_fmt->fieldWidth() != 0 || m_fmt->numberFlags() != 0 ||
+           (m_fmt->integerBase() != 0 && m_fmt->integerBase() != 10);
+}
+
+
+void OStream::writeLatin1(const char *str, int len)
+{
+    for (int i = 0; i < len; i++) {
+        if (static_cast<uchar>(str[i]) >= 0x80) {
+            // QTextStream treats char strings as Latin-1; re-encode as UTF-8
+            m_buffer.append(QString::fromLatin1(str, len).toUtf8());
+            writeBehind();
+            return;
+        }
+    }
+
+    m_buffer.append(str, len);
+    writeBehind();
+}
+
+
+void OStream::writeFormatted()
+{
+    m_fmt->flush();
+
+    if (!m_fmtBuffer.isEmpty()) {
+        m_buffer.append(m_fmtBuffer.toUtf8());
+        m_fmtBuffer.clear();
+        writeBehind();
+    }
+}
+
+
+void OStream::writeBehind()
+{
+    if (m_buffer.size() >= BUFFER_SIZE) {
+        flush();
+    }
 }
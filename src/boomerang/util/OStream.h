@@ -13,12 +13,15 @@
 #include "boomerang/core/BoomerangAPI.h"
 #include "boomerang/util/Types.h"
 
+#include <QByteArray>
+#include <QString>
+
 #include <cstdio>
 
 
 class QFile;
+class QIODevice;
 class QSaveFile;
-class QString;
 class QTextStream;
 class QTextStreamManipulator;
 
@@ -26,6 +29,11 @@ class QTextStreamManipulator;
 /**
  * Wrapper facade around QTextStream providing
  * only output functionality to a target.
+ *
+ * Output to files is encoded as UTF-8 directly into a large write-behind buffer
+ * which is written to the file in big blocks, bypassing QTextStream and its codec.
+ * Only formatted output (i.e. after a manipulator was applied) still goes through
+ * a QTextStream.
  */
 class BOOMERANG_API OStream
 {
@@ -57,5 +65,23 @@ public:
     void flush();
 
 private:
-    QTextStream *m_os;
+    /// \returns true if output must be formatted by m_fmt (e.g. because of a field width)
+    bool isFormatted() const;
+
+    /// Append the Latin-1 string \p str to the write buffer
+    void writeLatin1(const char *str, int len);
+
+    /// Append the output of m_fmt to the write buffer
+    void writeFormatted();
+
+    /// Write the buffer to the target device if it is full
+    void writeBehind();
+
+private:
+    QTextStream *m_os = nullptr; ///< for unbuffered targets (strings, FILE *)
+
+    QIODevice *m_device = nullptr; ///< for buffered targets (files)
+    QByteArray m_buffer;           ///< write-behind buffer for m_device
+    QString m_fmtBuffer;
+    QTextStream *m_fmt = nullptr; ///< formats numbers etc. for m_device
 };
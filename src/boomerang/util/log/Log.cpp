@@ -20,6 +20,7 @@
 
 #include <QDir>
 #include <QFileInfo>
+#include <QMutexLocker>
 
 
 static Log *g_log = nullptr;
@@ -57,6 +58,8 @@ Log &Log::getOrCreateLog()
 
 void Log::flush()
 {
+    QMutexLocker lock(&m_sinkMutex);
+
     for (std::unique_ptr<ILogSink> &s : m_sinks) {
         s->flush();
     }
@@ -217,6 +220,8 @@ QString Log::collectArg(const QString &msg, const LocationSet *l)
 
 void Log::write(const QString &msg)
 {
+    QMutexLocker lock(&m_sinkMutex);
+
     for (std::unique_ptr<ILogSink> &s : m_sinks) {
         s->write(msg);
     }
@@ -13,6 +13,8 @@
 #include "boomerang/util/Address.h"
 #include "boomerang/util/Types.h"
 
+#include <QMutex>
+
 #include <memory>
 #include <vector>
 
@@ -195,6 +197,7 @@ private:
     size_t m_fileNameOffset;
     LogLevel m_level = LogLevel::Default;
     std::vector<std::unique_ptr<ILogSink>> m_sinks;
+    QMutex m_sinkMutex; ///< Serializes writes to the sinks from multiple threads
 };
 
 
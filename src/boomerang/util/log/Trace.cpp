@@ -0,0 +1,177 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "Trace.h"
+
+#include "boomerang/db/proc/Proc.h"
+
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+
+namespace
+{
+struct TraceEvent
+{
+    QString name;
+    QString funcName;
+    Address funcAddr = Address::INVALID;
+    qint64 start     = 0; ///< in ns
+    qint64 duration  = 0; ///< in ns
+};
+
+
+/// The spans recorded by a single thread.
+struct ThreadBuffer
+{
+    int threadID = 0;
+    std::vector<TraceEvent> events;
+};
+
+
+/// Buffers of all threads. Buffers are never deleted while the program runs,
+/// so spans of threads that have already finished are kept.
+QMutex g_buffersMutex;
+std::vector<std::unique_ptr<ThreadBuffer>> g_buffers;
+
+thread_local ThreadBuffer *g_threadBuffer = nullptr;
+
+std::atomic<bool> g_clockStarted(false);
+std::chrono::steady_clock::time_point g_startTime;
+
+
+ThreadBuffer &getThreadBuffer()
+{
+    if (!g_threadBuffer) {
+        QMutexLocker lock(&g_buffersMutex);
+
+        g_buffers.push_back(std::make_unique<ThreadBuffer>());
+        g_buffers.back()->threadID = static_cast<int>(g_buffers.size());
+        g_threadBuffer             = g_buffers.back().get();
+    }
+
+    return *g_threadBuffer;
+}
+}
+
+
+std::atomic<bool> Trace::s_enabled(false);
+
+
+void Trace::enable()
+{
+    if (!g_clockStarted.exchange(true)) {
+        g_startTime = std::chrono::steady_clock::now();
+    }
+
+    s_enabled = true;
+}
+
+
+void Trace::disable()
+{
+    s_enabled = false;
+}
+
+
+void Trace::clear()
+{
+    QMutexLocker lock(&g_buffersMutex);
+
+    for (std::unique_ptr<ThreadBuffer> &buffer : g_buffers) {
+        buffer->events.clear();
+    }
+}
+
+
+qint64 Trace::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                                g_startTime)
+        .count();
+}
+
+
+void Trace::record(const QString &name, const QString &funcName, Address funcAddr, qint64 start,
+                   qint64 end)
+{
+    TraceEvent event;
+    event.name     = name;
+    event.funcName = funcName;
+    event.funcAddr = funcAddr;
+    event.start    = start;
+    event.duration = end - start;
+
+    getThreadBuffer().events.push_back(std::move(event));
+}
+
+
+bool Trace::writeChromeTrace(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QFile::WriteOnly)) {
+        return false;
+    }
+
+    QMutexLocker lock(&g_buffersMutex);
+    bool first = true;
+
+    file.write("{\"traceEvents\":[\n");
+
+    for (const std::unique_ptr<ThreadBuffer> &buffer : g_buffers) {
+        for (const TraceEvent &event : buffer->events) {
+            // Complete event; timestamps are in microseconds
+            QJsonObject obj;
+            obj["name"] = event.name;
+            obj["cat"]  = "boomerang";
+            obj["ph"]   = "X";
+            obj["ts"]   = event.start / 1000.0;
+            obj["dur"]  = event.duration / 1000.0;
+            obj["pid"]  = 1;
+            obj["tid"]  = buffer->threadID;
+
+            if (!event.funcName.isEmpty()) {
+                QJsonObject args;
+                args["proc"]    = event.funcName;
+                args["address"] = event.funcAddr.toString();
+                obj["args"]     = args;
+            }
+
+            if (!first) {
+                file.write(",\n");
+            }
+
+            file.write(QJsonDocument(obj).toJson(QJsonDocument::Compact));
+            first = false;
+        }
+    }
+
+    file.write("\n],\"displayTimeUnit\":\"ms\"}\n");
+    return file.error() == QFile::NoError;
+}
+
+
+void TraceSpan::begin(const QString &name, const Function *func)
+{
+    m_name = name;
+
+    if (func) {
+        m_funcName = func->getName();
+        m_funcAddr = func->getEntryAddress();
+    }
+
+    m_start = Trace::now();
+}
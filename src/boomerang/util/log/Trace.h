@@ -0,0 +1,121 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/util/Address.h"
+
+#include <QString>
+
+#include <atomic>
+
+
+class Function;
+
+
+/**
+ * Records the duration of scoped spans of code (see \ref TraceSpan) for performance analysis.
+ * Each thread records its spans into its own buffer, so recording does not need any locking.
+ * The recorded spans can be written to a file in the Chrome trace event format,
+ * which can be viewed e.g. in chrome://tracing or Perfetto.
+ *
+ * Tracing is disabled by default; in this case, spans are not recorded at all.
+ */
+class BOOMERANG_API Trace
+{
+public:
+    /// \returns true if spans are currently recorded.
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    /// Start recording spans.
+    static void enable();
+
+    /// Stop recording spans. Already recorded spans are kept.
+    static void disable();
+
+    /// Discard all recorded spans.
+    /// \note Recording is not locked, so this must only be called
+    /// when no thread has a live span, e.g. between two decompilations.
+    static void clear();
+
+    /// \returns the number of nanoseconds since tracing was first enabled.
+    static qint64 now();
+
+    /// Record a span of the current thread.
+    /// \param funcName name of the function the span belongs to, or empty for program-wide spans.
+    /// \param funcAddr entry address of the function the span belongs to.
+    static void record(const QString &name, const QString &funcName, Address funcAddr,
+                       qint64 start, qint64 end);
+
+    /**
+     * Write all recorded spans of all threads to \p fileName in the Chrome trace event format.
+     * \note No spans must be recorded while writing.
+     * \returns false if the file could not be written.
+     */
+    static bool writeChromeTrace(const QString &fileName);
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+
+/**
+ * Records the time between construction and destruction as a span if tracing is enabled.
+ * The name and address of the function are captured on construction,
+ * so the function may be deleted before the span ends.
+ * Usage: TRACE_SPAN("Decode"); or TRACE_SPAN(pass->getName(), proc);
+ */
+class BOOMERANG_API TraceSpan
+{
+public:
+    TraceSpan(const char *name, const Function *func = nullptr)
+    {
+        if (Trace::isEnabled()) {
+            begin(QString(name), func);
+        }
+    }
+
+    TraceSpan(const QString &name, const Function *func = nullptr)
+    {
+        if (Trace::isEnabled()) {
+            begin(name, func);
+        }
+    }
+
+    TraceSpan(const TraceSpan &other) = delete;
+    TraceSpan(TraceSpan &&other)      = delete;
+
+    ~TraceSpan()
+    {
+        if (m_start >= 0) {
+            Trace::record(m_name, m_funcName, m_funcAddr, m_start, Trace::now());
+        }
+    }
+
+    TraceSpan &operator=(const TraceSpan &other) = delete;
+    TraceSpan &operator=(TraceSpan &&other) = delete;
+
+private:
+    void begin(const QString &name, const Function *func);
+
+private:
+    QString m_name;
+    QString m_funcName;
+    Address m_funcAddr = Address::INVALID;
+    qint64 m_start     = -1; ///< -1 if tracing was disabled when the span was created
+};
+
+
+#define TRACE_SPAN_CONCAT_(a, b) a##b
+#define TRACE_SPAN_CONCAT(a, b) TRACE_SPAN_CONCAT_(a, b)
+
+/// Usage: TRACE_SPAN("Decode"); or TRACE_SPAN("Early decompile", proc);
+#define TRACE_SPAN(...) TraceSpan TRACE_SPAN_CONCAT(traceSpan, __LINE__)(__VA_ARGS__)
@@ -0,0 +1,30 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "BenchmarkUtils.h"
+
+#include "boomerang/core/Settings.h"
+
+#include <QDir>
+
+
+BenchmarkProject::BenchmarkProject()
+{
+    getSettings()->setDataDirectory(BOOMERANG_BENCHMARK_BASE "share/boomerang/");
+    getSettings()->setPluginDirectory(BOOMERANG_BENCHMARK_BASE "lib/boomerang/plugins/");
+    getSettings()->setOutputDirectory(QDir::temp().absoluteFilePath("boomerang-benchmarks"));
+
+    loadPlugins();
+}
+
+
+QString getFullSamplePath(const QString &relpath)
+{
+    return QString(BOOMERANG_BENCHMARK_BASE) + "share/boomerang/samples/" + relpath;
+}
@@ -0,0 +1,29 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/Project.h"
+
+#include <QString>
+
+
+/// Project using the data and plugins of the build directory.
+/// All plugins are loaded on construction.
+class BenchmarkProject : public Project
+{
+public:
+    BenchmarkProject();
+};
+
+
+/// \returns the full absolute path given a path
+/// relative to the data/samples/ directory
+QString getFullSamplePath(const QString &relpath);
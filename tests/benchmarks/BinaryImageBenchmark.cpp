@@ -0,0 +1,49 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "BenchmarkUtils.h"
+
+#include "boomerang/db/binary/BinaryFile.h"
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySection.h"
+
+#include <benchmark/benchmark.h>
+
+
+/// Read the .text section of a binary word by word
+static void binaryImageRead(benchmark::State &state)
+{
+    BenchmarkProject project;
+    if (!project.loadBinaryFile(getFullSamplePath("pentium/hello"))) {
+        state.SkipWithError("Cannot load binary file");
+        return;
+    }
+
+    const BinaryImage *image     = project.getLoadedBinaryFile()->getImage();
+    const BinarySection *section = image->getSectionByName(".text");
+    if (!section) {
+        state.SkipWithError("Cannot find .text section");
+        return;
+    }
+
+    const Address start = section->getSourceAddr();
+    const Address end   = start + section->getSize() - 4;
+
+    for (auto _ : state) {
+        DWord sum = 0;
+        for (Address addr = start; addr < end; addr += 4) {
+            sum += image->readNative4(addr);
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetBytesProcessed(state.iterations() * section->getSize());
+}
+BENCHMARK(binaryImageRead);
@@ -0,0 +1,71 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "boomerang/codegen/ControlFlowAnalyzer.h"
+#include "boomerang/db/BasicBlock.h"
+#include "boomerang/db/proc/ProcCFG.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/exp/Terminal.h"
+#include "boomerang/ssl/statements/Assign.h"
+#include "boomerang/ssl/type/VoidType.h"
+
+#include <benchmark/benchmark.h>
+
+
+static std::unique_ptr<RTLList> createRTLs(Address baseAddr, int numRTLs)
+{
+    std::unique_ptr<RTLList> rtls(new RTLList);
+
+    for (int i = 0; i < numRTLs; i++) {
+        rtls->push_back(std::unique_ptr<RTL>(new RTL(
+            baseAddr + i,
+            { new Assign(VoidType::get(), Terminal::get(opNil), Terminal::get(opNil)) })));
+    }
+
+    return rtls;
+}
+
+
+/**
+ * Structure a sequence of state.range(0) / 2 while loops followed by a return block,
+ * i.e. a CFG of about state.range(0) nodes.
+ */
+static void structureLoopSequence(benchmark::State &state)
+{
+    const int numLoops = static_cast<int>(state.range(0) / 2);
+
+    UserProc proc(Address(0x1000), "test", nullptr);
+    ProcCFG *cfg = proc.getCFG();
+    std::vector<BasicBlock *> headers, bodies;
+
+    for (int i = 0; i < numLoops; i++) {
+        headers.push_back(cfg->createBB(BBType::Twoway, createRTLs(Address(0x1000 + 2 * i), 1)));
+        bodies.push_back(cfg->createBB(BBType::Oneway, createRTLs(Address(0x1001 + 2 * i), 1)));
+    }
+
+    BasicBlock *ret = cfg->createBB(BBType::Ret, createRTLs(Address(0x1000 + 2 * numLoops), 1));
+
+    for (int i = 0; i < numLoops; i++) {
+        cfg->addEdge(headers[i], bodies[i]);
+        cfg->addEdge(headers[i], i + 1 < numLoops ? headers[i + 1] : ret);
+        cfg->addEdge(bodies[i], headers[i]);
+    }
+
+    cfg->setEntryAndExitBB(headers[0]);
+
+    for (auto _ : state) {
+        ControlFlowAnalyzer analyzer;
+        analyzer.structureCFG(cfg);
+        benchmark::DoNotOptimize(analyzer.getStructType(headers[0]));
+    }
+
+    state.SetItemsProcessed(state.iterations() * cfg->getNumBBs());
+}
+BENCHMARK(structureLoopSequence)->Arg(1000)->Arg(100000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,117 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "BenchmarkUtils.h"
+
+#include "boomerang/db/BasicBlock.h"
+#include "boomerang/db/DataFlow.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/statements/Assign.h"
+
+#include <benchmark/benchmark.h>
+
+
+/// \returns a single RTL at \p addr that increments eax and ecx.
+static std::unique_ptr<RTLList> createRTLs(Address addr)
+{
+    std::unique_ptr<RTLList> rtls(new RTLList);
+
+    rtls->push_back(std::unique_ptr<RTL>(new RTL(
+        addr, { new Assign(Location::regOf(REG_PENT_EAX),
+                           Binary::get(opPlus, Location::regOf(REG_PENT_EAX), Const::get(1))),
+                new Assign(Location::regOf(REG_PENT_ECX),
+                           Binary::get(opPlus, Location::regOf(REG_PENT_ECX), Const::get(1))) })));
+
+    return rtls;
+}
+
+
+/**
+ * Create a CFG consisting of \p numDiamonds if-then-else constructs in sequence,
+ * wrapped in a single loop.
+ */
+static void createDiamondCFG(UserProc *proc, int numDiamonds)
+{
+    ProcCFG *cfg = proc->getCFG();
+    Address addr(0x1000);
+
+    BasicBlock *entry = cfg->createBB(BBType::Oneway, createRTLs(addr++));
+    BasicBlock *prev  = entry;
+
+    for (int i = 0; i < numDiamonds; i++) {
+        BasicBlock *head  = cfg->createBB(BBType::Twoway, createRTLs(addr++));
+        BasicBlock *left  = cfg->createBB(BBType::Oneway, createRTLs(addr++));
+        BasicBlock *right = cfg->createBB(BBType::Oneway, createRTLs(addr++));
+        BasicBlock *join  = cfg->createBB(BBType::Oneway, createRTLs(addr++));
+
+        cfg->addEdge(prev, head);
+        cfg->addEdge(head, left);
+        cfg->addEdge(head, right);
+        cfg->addEdge(left, join);
+        cfg->addEdge(right, join);
+        prev = join;
+    }
+
+    BasicBlock *latch = cfg->createBB(BBType::Twoway, createRTLs(addr++));
+    BasicBlock *exit  = cfg->createBB(BBType::Ret, createRTLs(addr++));
+
+    cfg->addEdge(prev, latch);
+    cfg->addEdge(latch, entry->getSuccessor(0));
+    cfg->addEdge(latch, exit);
+
+    proc->setEntryBB();
+}
+
+
+static void calculateDominators(benchmark::State &state)
+{
+    BenchmarkProject project;
+    if (!project.loadBinaryFile(getFullSamplePath("pentium/hello"))) {
+        state.SkipWithError("Cannot load binary file");
+        return;
+    }
+
+    UserProc proc(Address(0x1000), "test", project.getProg()->getRootModule());
+    createDiamondCFG(&proc, static_cast<int>(state.range(0)));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(proc.getDataFlow()->calculateDominators());
+    }
+
+    state.SetItemsProcessed(state.iterations() * proc.getCFG()->getNumBBs());
+}
+BENCHMARK(calculateDominators)->Range(8, 4096);
+
+
+static void placePhiFunctions(benchmark::State &state)
+{
+    BenchmarkProject project;
+    if (!project.loadBinaryFile(getFullSamplePath("pentium/hello"))) {
+        state.SkipWithError("Cannot load binary file");
+        return;
+    }
+
+    std::unique_ptr<UserProc> proc;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        proc.reset(new UserProc(Address(0x1000), "test", project.getProg()->getRootModule()));
+        createDiamondCFG(proc.get(), static_cast<int>(state.range(0)));
+        proc->getDataFlow()->calculateDominators();
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(proc->getDataFlow()->placePhiFunctions());
+    }
+}
+BENCHMARK(placePhiFunctions)->Range(8, 4096)->Unit(benchmark::kMicrosecond);
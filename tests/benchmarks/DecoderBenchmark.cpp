@@ -0,0 +1,74 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "BenchmarkUtils.h"
+
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/binary/BinaryFile.h"
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySection.h"
+#include "boomerang/frontend/DecodeResult.h"
+#include "boomerang/frontend/pentium/PentiumDecoder.h"
+#include "boomerang/ifc/IFrontEnd.h"
+#include "boomerang/ssl/RTL.h"
+
+#include <benchmark/benchmark.h>
+
+
+/// Decode the .text section of pentium/hello instruction by instruction.
+/// \p useTable selects between the opcode table and the generated matcher only.
+static void decodePentium(benchmark::State &state, bool useTable)
+{
+    BenchmarkProject project;
+    if (!project.loadBinaryFile(getFullSamplePath("pentium/hello"))) {
+        state.SkipWithError("Cannot load sample binary");
+        return;
+    }
+
+    PentiumDecoder *decoder = dynamic_cast<PentiumDecoder *>(
+        project.getProg()->getFrontEnd()->getDecoder());
+    const BinarySection *text = project.getLoadedBinaryFile()->getImage()->getSectionByName(
+        ".text");
+
+    if (!decoder || !text) {
+        state.SkipWithError("Cannot find decoder or .text section");
+        return;
+    }
+
+    const ptrdiff_t delta = (text->getHostAddr() - text->getSourceAddr()).value();
+    const Address end     = text->getSourceAddr() + text->getSize();
+    int64_t numDecoded    = 0;
+
+    for (auto _ : state) {
+        for (Address pc = text->getSourceAddr(); pc < end;) {
+            DecodeResult result;
+            const bool ok = useTable ? decoder->decodeInstruction(pc, delta, result)
+                                     : decoder->decodeInstructionWithMatcher(pc, delta, result);
+
+            pc += (ok && result.numBytes > 0) ? result.numBytes : 1;
+            numDecoded++;
+        }
+    }
+
+    state.SetItemsProcessed(numDecoded);
+}
+
+
+static void decodePentiumTable(benchmark::State &state)
+{
+    decodePentium(state, true);
+}
+BENCHMARK(decodePentiumTable);
+
+
+static void decodePentiumMatcher(benchmark::State &state)
+{
+    decodePentium(state, false);
+}
+BENCHMARK(decodePentiumMatcher);
@@ -0,0 +1,109 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "BenchmarkUtils.h"
+
+#include <benchmark/benchmark.h>
+
+
+namespace
+{
+enum class Stage
+{
+    Load,
+    Decode,
+    Decompile,
+    Codegen
+};
+
+const std::vector<std::pair<Stage, const char *>> stages = {
+    { Stage::Load, "load" },
+    { Stage::Decode, "decode" },
+    { Stage::Decompile, "decompile" },
+    { Stage::Codegen, "codegen" },
+};
+
+/// Sample binaries the whole decompilation pipeline is measured for.
+const char *const samples[] = {
+    "pentium/hello",  "pentium/fibo-O4",  "pentium/nestedswitch", "pentium/recursion",
+    "sparc/fib",      "elf32-ppc/fibo",
+};
+}
+
+
+static bool runStage(Project &project, Stage stage, const QString &samplePath)
+{
+    switch (stage) {
+    case Stage::Load: return project.loadBinaryFile(samplePath);
+    case Stage::Decode: return project.decodeBinaryFile();
+    case Stage::Decompile: return project.decompileBinaryFile();
+    case Stage::Codegen: return project.generateCode();
+    }
+
+    return false;
+}
+
+
+/// Measure the time of a single stage of decompiling \p samplePath.
+/// All previous stages are done without measuring the time.
+static void decompilationStage(benchmark::State &state, const QString &samplePath,
+                               Stage measuredStage)
+{
+    BenchmarkProject project;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        project.unloadBinaryFile();
+
+        bool ok      = true;
+        bool running = false;
+
+        for (const auto &stage : stages) {
+            if (stage.first == measuredStage) {
+                state.ResumeTiming();
+                running = true;
+            }
+
+            ok = runStage(project, stage.first, samplePath);
+            if (!ok || stage.first == measuredStage) {
+                break;
+            }
+        }
+
+        if (!running) {
+            state.ResumeTiming();
+        }
+
+        if (!ok) {
+            state.SkipWithError("Decompilation failed");
+            break;
+        }
+    }
+}
+
+
+/// Register one benchmark per sample binary and stage,
+/// e.g. "decompile/pentium/hello/decode"
+void registerDecompilationBenchmarks()
+{
+    for (const char *sample : samples) {
+        const QString samplePath = getFullSamplePath(sample);
+
+        for (const auto &[stage, stageName] : stages) {
+            const QString name = QString("decompile/%1/%2").arg(sample).arg(stageName);
+            const Stage measuredStage = stage;
+
+            benchmark::RegisterBenchmark(name.toStdString().c_str(),
+                                         [samplePath, measuredStage](benchmark::State &state) {
+                                             decompilationStage(state, samplePath, measuredStage);
+                                         })
+                ->Unit(benchmark::kMillisecond);
+        }
+    }
+}
@@ -0,0 +1,125 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/util/LocationSet.h"
+
+#include <benchmark/benchmark.h>
+
+
+/// m[r28 + K] + r24
+static SharedExp createExp(int k)
+{
+    return Binary::get(opPlus, Location::memOf(Binary::get(opPlus, Location::regOf(REG_PENT_ESP),
+                                                           Const::get(k))),
+                       Location::regOf(REG_PENT_EAX));
+}
+
+
+static void expConstruct(benchmark::State &state)
+{
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(createExp(8));
+    }
+}
+BENCHMARK(expConstruct);
+
+
+static void expCompare(benchmark::State &state)
+{
+    const SharedExp e1 = createExp(8);
+    const SharedExp e2 = createExp(8);
+    const SharedExp e3 = createExp(12);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(*e1 == *e2);
+        benchmark::DoNotOptimize(*e1 < *e3);
+    }
+}
+BENCHMARK(expCompare);
+
+
+static void expSimplify(benchmark::State &state)
+{
+    // ((r24 + 0) * 1) + (m[r28 + 4 + 4] - m[r28 + 8])
+    const SharedExp exp = Binary::get(
+        opPlus,
+        Binary::get(opMult, Binary::get(opPlus, Location::regOf(REG_PENT_EAX), Const::get(0)),
+                    Const::get(1)),
+        Binary::get(opMinus,
+                    Location::memOf(Binary::get(
+                        opPlus, Binary::get(opPlus, Location::regOf(REG_PENT_ESP), Const::get(4)),
+                        Const::get(4))),
+                    Location::memOf(
+                        Binary::get(opPlus, Location::regOf(REG_PENT_ESP), Const::get(8)))));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(exp->clone()->simplify());
+    }
+}
+BENCHMARK(expSimplify);
+
+
+static LocationSet createLocationSet(int numLocations, int offset = 0)
+{
+    LocationSet locs;
+
+    for (int i = 0; i < numLocations; i++) {
+        locs.insert(Location::memOf(
+            Binary::get(opPlus, Location::regOf(REG_PENT_ESP), Const::get(4 * (i + offset)))));
+    }
+
+    return locs;
+}
+
+
+static void locationSetInsert(benchmark::State &state)
+{
+    const int numLocations = static_cast<int>(state.range(0));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(createLocationSet(numLocations));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(locationSetInsert)->Range(16, 4096);
+
+
+static void locationSetContains(benchmark::State &state)
+{
+    const int numLocations = static_cast<int>(state.range(0));
+    const LocationSet locs = createLocationSet(numLocations);
+
+    // in the middle of the set
+    const SharedExp exp = Location::memOf(
+        Binary::get(opPlus, Location::regOf(REG_PENT_ESP), Const::get(2 * numLocations)));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(locs.contains(exp));
+    }
+}
+BENCHMARK(locationSetContains)->Range(16, 4096);
+
+
+static void locationSetUnion(benchmark::State &state)
+{
+    const int numLocations  = static_cast<int>(state.range(0));
+    const LocationSet locs1 = createLocationSet(numLocations);
+    const LocationSet locs2 = createLocationSet(numLocations, numLocations / 2);
+
+    for (auto _ : state) {
+        LocationSet result(locs1);
+        result.makeUnion(locs2);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(locationSetUnion)->Range(16, 4096);
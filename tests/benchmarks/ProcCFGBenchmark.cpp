@@ -0,0 +1,64 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "boomerang/db/BasicBlock.h"
+#include "boomerang/db/proc/ProcCFG.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/exp/Terminal.h"
+#include "boomerang/ssl/statements/Assign.h"
+#include "boomerang/ssl/type/VoidType.h"
+
+#include <benchmark/benchmark.h>
+
+
+static std::unique_ptr<RTLList> createRTLs(Address baseAddr, int numRTLs)
+{
+    std::unique_ptr<RTLList> rtls(new RTLList);
+
+    for (int i = 0; i < numRTLs; i++) {
+        rtls->push_back(std::unique_ptr<RTL>(new RTL(
+            baseAddr + i,
+            { new Assign(VoidType::get(), Terminal::get(opNil), Terminal::get(opNil)) })));
+    }
+
+    return rtls;
+}
+
+
+/**
+ * Split a single BB of state.range(0) instructions at every other instruction,
+ * like the destinations of a dense jump table found after the code of the cases
+ * has been decoded sequentially. The destinations are visited from high to low addresses,
+ * so each split happens at the end of a large BB.
+ */
+static void splitJumpTableBB(benchmark::State &state)
+{
+    const int numRTLs = static_cast<int>(state.range(0));
+    int64_t numSplits = 0;
+    std::unique_ptr<UserProc> proc;
+
+    for (auto _ : state) {
+        // Destroy the procedure of the previous iteration outside of the measurement
+        state.PauseTiming();
+        proc.reset(new UserProc(Address(0x1000), "test", nullptr));
+        ProcCFG *cfg = proc->getCFG();
+        cfg->createBB(BBType::Oneway, createRTLs(Address(0x1000), numRTLs));
+        state.ResumeTiming();
+
+        for (int i = numRTLs - 2; i > 0; i -= 2) {
+            BasicBlock *currBB = nullptr;
+            cfg->ensureBBExists(Address(0x1000) + i, currBB);
+            numSplits++;
+        }
+    }
+
+    state.SetItemsProcessed(numSplits);
+}
+BENCHMARK(splitJumpTableBB)->Range(64, 4096)->Unit(benchmark::kMicrosecond);
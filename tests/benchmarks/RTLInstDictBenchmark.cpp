@@ -0,0 +1,65 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "BenchmarkUtils.h"
+
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/RTLInstDict.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+
+#include <benchmark/benchmark.h>
+
+
+static void instantiateRTL(benchmark::State &state)
+{
+    RTLInstDict dict(false);
+    if (!dict.readSSLFile(BOOMERANG_BENCHMARK_BASE "share/boomerang/ssl/pentium.ssl")) {
+        state.SkipWithError("Cannot read SSL file");
+        return;
+    }
+
+    const QString push = dict.getSignature("PUSH.IXOB").first;
+    const QString add  = dict.getSignature("ADD.ID").first;
+
+    const std::vector<SharedExp> pushArgs = { Const::get(5) };
+    const std::vector<SharedExp> addArgs  = { Location::regOf(REG_PENT_EAX), Const::get(5) };
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(dict.instantiateRTL(push, Address(0x1000), pushArgs));
+        benchmark::DoNotOptimize(dict.instantiateRTL(add, Address(0x1002), addArgs));
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(instantiateRTL);
+
+
+static void instantiateRTLByID(benchmark::State &state)
+{
+    RTLInstDict dict(false);
+    if (!dict.readSSLFile(BOOMERANG_BENCHMARK_BASE "share/boomerang/ssl/pentium.ssl")) {
+        state.SkipWithError("Cannot read SSL file");
+        return;
+    }
+
+    const int push = dict.getInstructionID("PUSH.IXOB");
+    const int add  = dict.getInstructionID("ADD.ID");
+
+    const std::vector<SharedExp> pushArgs = { Const::get(5) };
+    const std::vector<SharedExp> addArgs  = { Location::regOf(REG_PENT_EAX), Const::get(5) };
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(dict.instantiateRTL(push, Address(0x1000), pushArgs));
+        benchmark::DoNotOptimize(dict.instantiateRTL(add, Address(0x1002), addArgs));
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(instantiateRTLByID);
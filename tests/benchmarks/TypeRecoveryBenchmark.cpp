@@ -0,0 +1,47 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "BenchmarkUtils.h"
+
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/module/Module.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/ifc/ITypeRecovery.h"
+
+#include <benchmark/benchmark.h>
+
+
+/// Data-flow based type recovery of all procedures of an already decompiled binary.
+static void dfaTypeRecovery(benchmark::State &state)
+{
+    BenchmarkProject project;
+    if (!project.loadBinaryFile(getFullSamplePath("pentium/fibo-O4")) ||
+        !project.decodeBinaryFile() || !project.decompileBinaryFile()) {
+        state.SkipWithError("Cannot decompile binary file");
+        return;
+    }
+
+    std::list<UserProc *> procs;
+    for (const auto &module : project.getProg()->getModuleList()) {
+        for (Function *function : *module) {
+            if (!function->isLib()) {
+                procs.push_back(static_cast<UserProc *>(function));
+            }
+        }
+    }
+
+    ITypeRecovery *typeRecovery = project.getTypeRecoveryEngine();
+
+    for (auto _ : state) {
+        for (UserProc *proc : procs) {
+            typeRecovery->recoverFunctionTypes(proc);
+        }
+    }
+}
+BENCHMARK(dfaTypeRecovery)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,35 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "boomerang/util/log/Log.h"
+
+#include <QCoreApplication>
+
+#include <benchmark/benchmark.h>
+
+
+void registerDecompilationBenchmarks();
+
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    Log::getOrCreateLog();
+
+    registerDecompilationBenchmarks();
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
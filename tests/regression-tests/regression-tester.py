@@ -7,13 +7,17 @@
 # WARRANTIES.
 #
 
+import argparse
+import json
 import os
 import shutil
 import subprocess
 import sys
 import difflib
+import time
 
 from collections import defaultdict
+from concurrent.futures import ThreadPoolExecutor, as_completed
 from filecmp import dircmp
 
 
@@ -365,16 +369,25 @@ def compare_directories(dir_expected, dir_actual):
 
 """ Perform the actual test on a single input binary """
 def test_single_input(cli_path, input_file, output_path, expected_output_path, args):
-    cmdline   = [cli_path] + ['-P', os.path.dirname(cli_path), '-o', output_path] + args + [input_file]
+    stats_file = os.path.join(output_path, os.path.basename(input_file) + ".stats.json")
+    cmdline    = [cli_path] + ['-P', os.path.dirname(cli_path), '-o', output_path, '--stats', stats_file] + args + [input_file]
+    stats      = {}
 
     try:
         with open(os.path.join(output_path, os.path.basename(input_file) + ".stdout"), "w") as test_stdout, \
              open(os.path.join(output_path, os.path.basename(input_file) + ".stderr"), "w") as test_stderr:
 
             try:
+                start_time = time.monotonic()
                 result = subprocess.call(cmdline, stdout=test_stdout, stderr=test_stderr, timeout=360)
+                wall_time = time.monotonic() - start_time
                 result = '.' if result == 0 else 'f'
 
+                if os.path.isfile(stats_file):
+                    with open(stats_file, 'r') as f:
+                        stats = json.load(f)
+                    stats['wallTime'] = wall_time
+
                 if result == '.' and expected_output_path != "":
                     # Perform regression diff
                     if not compare_directories(expected_output_path, output_path):
@@ -386,34 +399,50 @@ def test_single_input(cli_path, input_file, output_path, expected_output_path, a
             except:
                 result = '!'
 
-        return [result, ' '.join(cmdline), input_file]
+        return [result, ' '.join(cmdline), input_file, stats]
     except IOError:
-        return ['d', ' '.join(cmdline), input_file]
+        return ['d', ' '.join(cmdline), input_file, stats]
 
 
 
-""" Perform regression tests on inputs in test_list. Returns true on success (no regressions). """
-def perform_regression_tests(base_dir, test_input_base, test_list):
-    test_results = defaultdict();
+""" Run test_single_input for all inputs in test_list concurrently. Returns a dict test_file -> result """
+def run_tests(base_dir, test_input_base, test_list, check_outputs, options):
+    test_results = defaultdict()
 
-    sys.stdout.write("Testing for regressions ")
-    for test_file in test_list:
-        input_file = os.path.join(test_input_base, test_file)
-        expected_output_dir = os.path.join(base_dir, "expected-outputs", test_file)
-        output_dir = os.path.join(base_dir, "outputs", test_file)
-        os.makedirs(output_dir)
+    with ThreadPoolExecutor(max_workers=options.jobs) as executor:
+        futures = {}
+        for test_file in test_list:
+            input_file = os.path.join(test_input_base, test_file)
+            expected_output_dir = os.path.join(base_dir, "expected-outputs", test_file) if check_outputs else ""
+            output_dir = os.path.join(base_dir, "outputs", test_file)
+            os.makedirs(output_dir)
+
+            future = executor.submit(test_single_input, options.cli_path, input_file, output_dir,
+                                     expected_output_dir, options.cli_args)
+            futures[future] = test_file
+
+        for future in as_completed(futures):
+            test_result = future.result()
+            if test_result[3]:
+                # wall times of concurrent tests are skewed by the other tests
+                test_result[3]['serial'] = (options.jobs == 1)
+            test_results[futures[future]] = test_result
+
+            sys.stdout.write(test_result[0]) # print status
+            sys.stdout.flush()
 
-        test_result = test_single_input(sys.argv[1], input_file, output_dir, expected_output_dir, sys.argv[2:])
-        test_results[test_file] = test_result
+    # Report results in a deterministic order
+    return { test_file: test_results[test_file] for test_file in test_list }
 
-        sys.stdout.write(test_result[0]) # print status
-        sys.stdout.flush()
 
+
+""" Print all tests in test_results that did not succeed. Returns true if all tests succeeded. """
+def print_failures(title, test_results):
     num_failed = sum(1 for res in test_results.values() if res[0] != '.')
 
     print("")
     if num_failed != 0:
-        print("\nRegressions:")
+        print("\n" + title + ":")
         for res in test_results.values():
             if res[0] != '.':
                 sys.stdout.write(res[0] + " " + res[2] + "\n")
@@ -426,37 +455,149 @@ def perform_regression_tests(base_dir, test_input_base, test_list):
 
 
 """ Perform regression tests on inputs in test_list. Returns true on success (no regressions). """
-def perform_smoke_tests(base_dir, test_input_base, test_list):
-    test_results = defaultdict();
+def perform_regression_tests(base_dir, test_input_base, test_list, options, performance):
+    sys.stdout.write("Testing for regressions ")
+    test_results = run_tests(base_dir, test_input_base, test_list, True, options)
+
+    for test_file, res in test_results.items():
+        performance[test_file] = res[3]
+
+    return print_failures("Regressions", test_results)
+
 
+
+""" Perform smoke tests on inputs in test_list. Returns true on success (no crashes or failures). """
+def perform_smoke_tests(base_dir, test_input_base, test_list, options, performance):
     sys.stdout.write("Testing for crashes ")
-    for test_file in test_list:
-        input_file = os.path.join(test_input_base, test_file)
-        output_dir = os.path.join(base_dir, "outputs", test_file)
-        os.makedirs(output_dir)
+    test_results = run_tests(base_dir, test_input_base, test_list, False, options)
 
-        test_result = test_single_input(sys.argv[1], input_file, output_dir, "", sys.argv[2:])
-        test_results[test_file] = test_result
+    for test_file, res in test_results.items():
+        performance[test_file] = res[3]
 
-        sys.stdout.write(test_result[0]) # print status
-        sys.stdout.flush()
+    return print_failures("Failures", test_results)
 
-    num_failed = sum(1 for res in test_results.values() if res[0] != '.')
 
-    print("")
-    if num_failed != 0:
-        print("\nFailures:")
-        for res in test_results.values():
-            if res[0] != '.':
-                sys.stdout.write(res[0] + " " + res[2] + "\n")
-                sys.stdout.flush()
 
+""" Test batch mode with binaries that have the same base name, one of which fails to load.
+    Returns true if every job reported the expected status and wrote to its own output directory. """
+def perform_batch_tests(base_dir, test_input_base, options):
+    sys.stdout.write("Testing batch mode ")
     sys.stdout.flush()
-    return num_failed == 0
+
+    output_dir = os.path.join(base_dir, "outputs", "batch")
+    os.makedirs(output_dir)
+
+    jobs = [
+        ("pentium/hello", "ok"),
+        ("sparc/hello", "ok"),
+        ("does-not-exist/hello", "failed")
+    ]
+
+    manifest = os.path.join(output_dir, "manifest.txt")
+    with open(manifest, "w") as f:
+        for test_file, _ in jobs:
+            f.write(os.path.join(test_input_base, test_file) + "\n")
+
+    cmdline = [options.cli_path, '-P', os.path.dirname(options.cli_path), '-o', output_dir, '--batch', manifest]
+    failures = []
+
+    try:
+        process = subprocess.run(cmdline, stdout=subprocess.PIPE, stderr=subprocess.DEVNULL,
+                                 universal_newlines=True, timeout=360)
+    except subprocess.TimeoutExpired:
+        print("\n\nBatch mode:\n! " + ' '.join(cmdline) + "\n")
+        return False
+
+    results = [json.loads(line) for line in process.stdout.splitlines() if line.startswith('{')]
+
+    if process.returncode != 1:
+        failures.append("exit code %d, expected 1" % process.returncode)
+    if len(results) != len(jobs):
+        failures.append("%d results, expected %d" % (len(results), len(jobs)))
+    else:
+        output_dirs = set()
+        for (test_file, expected_status), result in zip(jobs, results):
+            if result.get('status') != expected_status:
+                failures.append("%s: status '%s', expected '%s'" % (test_file, result.get('status'), expected_status))
+            if result.get('output') in output_dirs:
+                failures.append("%s: output directory '%s' is used by another job" % (test_file, result.get('output')))
+            elif expected_status == "ok" and not (os.path.isdir(result['output']) and os.listdir(result['output'])):
+                failures.append("%s: no output in '%s'" % (test_file, result.get('output')))
+            output_dirs.add(result.get('output'))
+
+    sys.stdout.write('.' if not failures else 'f')
+    print("")
+
+    if failures:
+        print("\nBatch mode:")
+        for failure in failures:
+            print("f " + failure)
+        print("")
+
+    return not failures
+
+
+
+""" Compare the performance of all tests against the baseline.
+    CPU time is compared for all runs; the wall time of each stage is only compared
+    if both this run and the baseline were run serially (-j 1), since concurrent tests
+    compete for the CPU. Timings below min_time seconds are ignored since they are
+    dominated by noise.
+    Returns true if no test got slower or used more memory than allowed. """
+def compare_performance(performance, baseline, options, min_time=0.1):
+    regressions = []
+
+    def check(test_file, what, actual, expected, max_increase, min_value=0):
+        if actual is None or expected is None or expected <= 0 or actual < min_value:
+            return
+        increase = 100.0 * (actual - expected) / expected
+        if increase > max_increase:
+            regressions.append("%s: %s %.2f -> %.2f (+%.0f%%)" % (test_file, what, expected, actual, increase))
+
+    for test_file, stats in sorted(performance.items()):
+        base_stats = baseline.get(test_file)
+        if not stats or not base_stats:
+            continue
+
+        check(test_file, "CPU time", stats.get('cpuTime'), base_stats.get('cpuTime'), options.max_slowdown, min_time)
+
+        if stats.get('serial') and base_stats.get('serial'):
+            for stage, seconds in stats.get('stages', {}).items():
+                check(test_file, stage + " time", seconds, base_stats.get('stages', {}).get(stage), options.max_slowdown, min_time)
+
+        check(test_file, "peak memory (KiB)", stats.get('peakMemory'), base_stats.get('peakMemory'), options.max_growth)
+
+        if stats.get('numProcs') != base_stats.get('numProcs'):
+            print("Note: %s: number of procedures changed from %s to %s" %
+                (test_file, base_stats.get('numProcs'), stats.get('numProcs')))
+
+    if regressions:
+        print("\nPerformance regressions:")
+        for regression in regressions:
+            print("p " + regression)
+        print("")
+
+    return not regressions
 
 
 
 def main():
+    parser = argparse.ArgumentParser(description="Boomerang regression tester")
+    parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count(),
+                        help="number of tests to run concurrently (default: number of CPU cores)")
+    parser.add_argument('--baseline', default=os.path.join(os.getcwd(), "performance-baseline.json"),
+                        help="performance baseline to compare against (default: %(default)s)")
+    parser.add_argument('--update-baseline', action='store_true',
+                        help="store the performance of this run as the new baseline")
+    parser.add_argument('--max-slowdown', type=float, default=25.0,
+                        help="maximum allowed increase of CPU time and, for serial runs (-j 1), "
+                             "of the time of each stage in percent (default: %(default)s)")
+    parser.add_argument('--max-growth', type=float, default=25.0,
+                        help="maximum allowed increase of peak memory usage in percent (default: %(default)s)")
+    parser.add_argument('cli_path', help="path to boomerang-cli")
+    parser.add_argument('cli_args', nargs=argparse.REMAINDER, help="additional arguments for boomerang-cli")
+    options = parser.parse_args()
+
     print("")
     print("Boomerang 0.4.0 Regression Tester")
     print("=================================")
@@ -467,10 +608,28 @@ def main():
     tests_input_base = os.path.abspath(os.path.join(os.getcwd(), "../../out/share/boomerang/samples/"))
 
     all_ok = True
+    performance = {}
 
     clean_old_outputs(base_dir)
-    all_ok &= perform_regression_tests(base_dir, tests_input_base, regression_tests)
-    all_ok &= perform_smoke_tests(base_dir, tests_input_base, smoke_tests)
+    all_ok &= perform_regression_tests(base_dir, tests_input_base, regression_tests, options, performance)
+    all_ok &= perform_smoke_tests(base_dir, tests_input_base, smoke_tests, options, performance)
+    all_ok &= perform_batch_tests(base_dir, tests_input_base, options)
+
+    with open(os.path.join(base_dir, "outputs", "performance.json"), "w") as f:
+        json.dump(performance, f, indent=2, sort_keys=True)
+
+    if options.update_baseline:
+        with open(options.baseline, "w") as f:
+            json.dump(performance, f, indent=2, sort_keys=True)
+        print("Performance baseline written to '%s'" % options.baseline)
+        if options.jobs != 1:
+            print("Note: Run with -j 1 to include the time of each stage in the baseline.")
+    elif os.path.isfile(options.baseline):
+        with open(options.baseline, "r") as f:
+            all_ok &= compare_performance(performance, json.load(f), options)
+    else:
+        print("No performance baseline found at '%s', skipping performance comparison." % options.baseline)
+        print("Run with --update-baseline to create it.")
 
     print("Testing finished.\n")
 
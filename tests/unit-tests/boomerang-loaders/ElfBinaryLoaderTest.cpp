@@ -13,6 +13,8 @@
 #include "boomerang/core/Settings.h"
 #include "boomerang/db/binary/BinaryImage.h"
 #include "boomerang/db/binary/BinarySection.h"
+#include "boomerang/db/binary/BinarySymbol.h"
+#include "boomerang/db/binary/BinarySymbolTable.h"
 #include "boomerang/util/log/Log.h"
 
 #include <QLibrary>
@@ -131,4 +133,64 @@ void ElfBinaryLoaderTest::testPentiumLoad_data()
 
 
 
+/// Load \p fileName and describe all symbols and relocations of the loaded binary.
+static QStringList loadSymbolsAndRelocations(Project &project, const QString &fileName,
+                                             int numThreads, int minEntriesPerThread)
+{
+    project.getSettings()->numThreads                = numThreads;
+    project.getSettings()->loaderMinEntriesPerThread = minEntriesPerThread;
+
+    if (!project.loadBinaryFile(fileName)) {
+        return { "<failed>" };
+    }
+
+    QStringList result;
+
+    for (const BinarySymbol *sym : *project.getLoadedBinaryFile()->getSymbols()) {
+        result << QString("%1 %2 %3 %4%5%6")
+                      .arg(sym->getName())
+                      .arg(sym->getLocation().toString())
+                      .arg(sym->getSize())
+                      .arg(sym->isFunction())
+                      .arg(sym->isImportedFunction())
+                      .arg(sym->isStaticFunction());
+    }
+
+    const BinaryImage *image = project.getLoadedBinaryFile()->getImage();
+    const Address maxAddr    = Address(Address::getSourceMask());
+
+    for (Address reloc = image->findRelocation(Address::ZERO, maxAddr); reloc != Address::INVALID;
+         reloc = image->findRelocation(reloc + 1, maxAddr)) {
+        result << QString("reloc %1 %2").arg(reloc.toString()).arg(image->readNative4(reloc));
+    }
+
+    return result;
+}
+
+
+void ElfBinaryLoaderTest::testParallelLoad()
+{
+    QFETCH(QString, fileName);
+
+    const QStringList expected = loadSymbolsAndRelocations(m_project, fileName, 1, 0x4000);
+    const QStringList actual   = loadSymbolsAndRelocations(m_project, fileName, 4, 1);
+
+    m_project.getSettings()->numThreads                = 1;
+    m_project.getSettings()->loaderMinEntriesPerThread = 0x4000;
+
+    QVERIFY(expected.size() > 1);
+    QCOMPARE(actual, expected);
+}
+
+
+void ElfBinaryLoaderTest::testParallelLoad_data()
+{
+    QTest::addColumn<QString>("fileName");
+
+    QTest::newRow("pentium/hello")        << HELLO_PENTIUM;
+    QTest::newRow("hello-clang4-dynamic") << HELLO_CLANG4;
+    QTest::newRow("hello-clang4-static")  << HELLO_CLANG4_STATIC;
+}
+
+
 QTEST_GUILESS_MAIN(ElfBinaryLoaderTest)
@@ -25,4 +25,9 @@ private slots:
     /// Test loading the Pentium (Solaris) hello world program
     void testPentiumLoad();
     void testPentiumLoad_data();
+
+    /// Test that splitting the symbol and relocation tables between threads
+    /// gives the same result as loading them sequentially
+    void testParallelLoad();
+    void testParallelLoad_data();
 };
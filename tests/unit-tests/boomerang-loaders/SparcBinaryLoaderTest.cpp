@@ -29,6 +29,11 @@ void SparcBinaryLoaderTest::testSparcLoad()
     QCOMPARE(image->getNumSections(), 28);
     QCOMPARE(image->getSectionByIndex(1)->getName(), QString(".hash"));
     QCOMPARE(image->getSectionByIndex(27)->getName(), QString(".stab.indexstr"));
+
+    // destinations of relocations with addend (.rela.got, .rela.plt)
+    QVERIFY(image->isRelocationAt(Address(0x0002077C)));
+    QVERIFY(image->isRelocationAt(Address(0x000207B8)));
+    QVERIFY(!image->isRelocationAt(Address(0x00020778)));
 }
 
 
@@ -18,6 +18,6 @@ class SparcBinaryLoaderTest : public BoomerangTestWithPlugins
     Q_OBJECT
 
 private slots:
-    /// Test loading the SPARC hello world program
+    /// Test loading the SPARC hello world program and its relocations
     void testSparcLoad();
 };
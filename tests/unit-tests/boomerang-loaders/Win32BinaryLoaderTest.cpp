@@ -12,11 +12,17 @@
 
 #include "boomerang/db/binary/BinaryImage.h"
 #include "boomerang/db/binary/BinarySection.h"
+#include "boomerang/db/binary/BinarySymbol.h"
+#include "boomerang/db/binary/BinarySymbolTable.h"
 
 #include "boomerang/util/log/Log.h"
 
+#include <QFile>
+#include <QTemporaryDir>
+
 
 #define SWITCH_BORLAND    getFullSamplePath("windows/switch_borland.exe")
+#define SWITCH_GCC        getFullSamplePath("windows/switch_gcc.exe")
 
 
 void Win32BinaryLoaderTest::testWinLoad()
@@ -30,4 +36,60 @@ void Win32BinaryLoaderTest::testWinLoad()
 }
 
 
+void Win32BinaryLoaderTest::testJumpsToIAT()
+{
+    QVERIFY(m_project.loadBinaryFile(SWITCH_GCC));
+
+    // 0x004014D0: jmp [0x00404088]
+    const BinarySymbolTable *symbols = m_project.getLoadedBinaryFile()->getSymbols();
+    const BinarySymbol *thunk        = symbols->findSymbolByAddress(Address(0x004014D0));
+    const BinarySymbol *iatEntry     = symbols->findSymbolByAddress(Address(0x00404088));
+
+    QVERIFY(thunk != nullptr && thunk->isImportedFunction());
+    QVERIFY(iatEntry != nullptr);
+    QCOMPARE(iatEntry->getName(), "__imp_" + thunk->getName());
+
+    const BinarySymbol *mainSym = symbols->findSymbolByName("main");
+    QVERIFY(mainSym != nullptr);
+    const Address mainAddr = mainSym->getLocation();
+
+    // Put a jmp [main] into the padding after the thunk. main is not an IAT entry,
+    // so neither the jump nor main must be renamed.
+    QFile sample(SWITCH_GCC);
+    QVERIFY(sample.open(QFile::ReadOnly));
+    QByteArray data = sample.readAll();
+
+    const int jumpOffset = 0x8D8; // file offset of 0x004014D8
+    QCOMPARE(data.mid(jumpOffset, 6), QByteArray(6, '\0'));
+
+    data[jumpOffset + 0] = '\xFF';
+    data[jumpOffset + 1] = '\x25';
+    for (int i = 0; i < 4; i++) {
+        data[jumpOffset + 2 + i] = static_cast<char>((mainAddr.value() >> (8 * i)) & 0xFF);
+    }
+
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString patchedFile = tempDir.filePath("switch_gcc.exe");
+
+    QFile patched(patchedFile);
+    QVERIFY(patched.open(QFile::WriteOnly));
+    QCOMPARE(patched.write(data), static_cast<qint64>(data.size()));
+    patched.close();
+
+    QVERIFY(m_project.loadBinaryFile(patchedFile));
+    symbols = m_project.getLoadedBinaryFile()->getSymbols();
+
+    QVERIFY(symbols->findSymbolByAddress(Address(0x004014D8)) == nullptr);
+    QVERIFY(symbols->findSymbolByName("__imp_main") == nullptr);
+    mainSym = symbols->findSymbolByName("main");
+    QVERIFY(mainSym != nullptr);
+    QCOMPARE(mainSym->getLocation(), mainAddr);
+
+    // The real thunk is still named after the imported function
+    thunk = symbols->findSymbolByAddress(Address(0x004014D0));
+    QVERIFY(thunk != nullptr && thunk->isImportedFunction());
+}
+
+
 QTEST_GUILESS_MAIN(Win32BinaryLoaderTest)
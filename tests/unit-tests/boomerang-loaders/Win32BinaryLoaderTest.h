@@ -20,4 +20,7 @@ class Win32BinaryLoaderTest : public BoomerangTestWithPlugins
 private slots:
     /// Test loading Windows programs
     void testWinLoad();
+
+    /// Test naming jumps to IAT entries after the imported function
+    void testJumpsToIAT();
 };
@@ -0,0 +1,164 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "SignatureDBTest.h"
+
+
+#include "boomerang/c/CSymbolProvider.h"
+#include "boomerang/c/SignatureDB.h"
+#include "boomerang/db/signature/Signature.h"
+#include "boomerang/ssl/type/CharType.h"
+#include "boomerang/ssl/type/PointerType.h"
+
+#include <QDataStream>
+#include <QFile>
+#include <QTemporaryDir>
+
+
+static bool writeFile(const QString &fileName, const QByteArray &contents)
+{
+    QFile file(fileName);
+    return file.open(QFile::WriteOnly) && file.write(contents) == contents.size();
+}
+
+
+static QString createCatalog(const QTemporaryDir &tempDir)
+{
+    const QString catalogFile = tempDir.filePath("test.hs");
+
+    if (!writeFile(tempDir.filePath("test.h"), "typedef int myint_t;\n"
+                                               "int printf(char *fmt, ...);\n"
+                                               "myint_t abs(myint_t x);\n") ||
+        !writeFile(catalogFile, "# test catalog\ntest.h\n")) {
+        return "";
+    }
+
+    return catalogFile;
+}
+
+
+void SignatureDBTest::testCompileOpen()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString catalogFile = createCatalog(tempDir);
+    QVERIFY(!catalogFile.isEmpty());
+
+    std::vector<SignatureDB::CatalogEntry> entries;
+    QVERIFY(CSymbolProvider::readCatalogEntries(catalogFile, entries));
+    QCOMPARE(entries.size(), size_t(1));
+
+    const QString dbFile = SignatureDB::getDBFileName(catalogFile, Machine::PENTIUM);
+    QVERIFY(SignatureDB::compile(catalogFile, Machine::PENTIUM, dbFile));
+
+    Type::clearNamedTypes();
+
+    SignatureDB db;
+    QVERIFY(db.open(dbFile, Machine::PENTIUM, SignatureDB::hashCatalog(catalogFile, entries)));
+
+    db.registerNamedTypes();
+    QVERIFY(Type::getNamedType("myint_t") != nullptr);
+
+    QVERIFY(db.contains("printf"));
+    QVERIFY(db.contains("abs"));
+    QVERIFY(!db.contains("puts"));
+    QVERIFY(db.getSignature("puts") == nullptr);
+
+    std::shared_ptr<Signature> sig = db.getSignature("printf");
+    QVERIFY(sig != nullptr);
+    QCOMPARE(sig->getName(), QString("printf"));
+    QCOMPARE(sig->getNumParams(), 1);
+    QVERIFY(*sig->getParamType(0) == *PointerType::get(CharType::get()));
+    QCOMPARE(sig->getParamName(0), QString("fmt"));
+    QVERIFY(sig->hasEllipsis());
+    QCOMPARE(sig->getSigFilePath(), tempDir.filePath("test.h"));
+
+    // compare with the signature parsed from the header
+    QMap<QString, std::shared_ptr<Signature>> parsed;
+    QVERIFY(CSymbolProvider::parseSignatureFile(entries[0].first, Machine::PENTIUM,
+                                                entries[0].second, parsed));
+    QVERIFY(parsed.contains("abs"));
+
+    std::shared_ptr<Signature> absSig = db.getSignature("abs");
+    QVERIFY(absSig != nullptr);
+    QVERIFY(*absSig == *parsed["abs"]);
+}
+
+
+void SignatureDBTest::testOpenOutdated()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QString catalogFile = createCatalog(tempDir);
+    QVERIFY(!catalogFile.isEmpty());
+
+    std::vector<SignatureDB::CatalogEntry> entries;
+    QVERIFY(CSymbolProvider::readCatalogEntries(catalogFile, entries));
+
+    const QString dbFile = SignatureDB::getDBFileName(catalogFile, Machine::PENTIUM);
+    QVERIFY(SignatureDB::compile(catalogFile, Machine::PENTIUM, dbFile));
+
+    const QByteArray catalogHash = SignatureDB::hashCatalog(catalogFile, entries);
+
+    {
+        // wrong machine
+        SignatureDB db;
+        QVERIFY(!db.open(dbFile, Machine::SPARC, catalogHash));
+    }
+
+    {
+        // written by a different build
+        QFile file(dbFile);
+        QVERIFY(file.open(QFile::ReadOnly));
+        const QByteArray data = file.readAll();
+        file.close();
+
+        QDataStream is(data);
+        is.setVersion(QDataStream::Qt_5_0);
+
+        quint32 magic, version;
+        QString build;
+        is >> magic >> version >> build;
+        QCOMPARE(build, QString(BOOMERANG_VERSION));
+
+        QByteArray otherBuildData;
+        QDataStream os(&otherBuildData, QIODevice::WriteOnly);
+        os.setVersion(QDataStream::Qt_5_0);
+        os << magic << version << QString("other build");
+        otherBuildData.append(data.mid(is.device()->pos()));
+        QVERIFY(writeFile(dbFile, otherBuildData));
+
+        SignatureDB db;
+        QVERIFY(!db.open(dbFile, Machine::PENTIUM, catalogHash));
+
+        QVERIFY(writeFile(dbFile, data));
+        QVERIFY(db.open(dbFile, Machine::PENTIUM, catalogHash));
+    }
+
+    {
+        // modified header
+        QVERIFY(writeFile(tempDir.filePath("test.h"), "int puts(char *s);\n"));
+
+        SignatureDB db;
+        QVERIFY(!db.open(dbFile, Machine::PENTIUM, SignatureDB::hashCatalog(catalogFile, entries)));
+    }
+
+    {
+        // corrupt database
+        QVERIFY(writeFile(dbFile, "garbage"));
+
+        SignatureDB db;
+        QVERIFY(!db.open(dbFile, Machine::PENTIUM, catalogHash));
+    }
+}
+
+
+QTEST_GUILESS_MAIN(SignatureDBTest)
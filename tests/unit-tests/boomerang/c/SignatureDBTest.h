@@ -0,0 +1,29 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+/**
+ * Tests precompiled library signature databases
+ */
+class SignatureDBTest : public BoomerangTest
+{
+    Q_OBJECT
+
+private slots:
+    /// Test that signatures are the same after compiling and reading the database
+    void testCompileOpen();
+
+    /// Test that outdated databases are rejected
+    void testOpenOutdated();
+};
@@ -0,0 +1,77 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "CCodeGeneratorTest.h"
+
+
+#include "boomerang/core/Project.h"
+#include "boomerang/core/Settings.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/binary/BinaryFile.h"
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySection.h"
+#include "boomerang/db/module/Module.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+
+
+void CCodeGeneratorTest::testGenerateDataSections()
+{
+    QTemporaryDir outputDir;
+    QVERIFY(outputDir.isValid());
+
+    // text at the end of the section, so the last row ends with a newline
+    char textData[] = "Hello world\n";
+    char binaryData[] = { 0x01, 0x02, 'a', 'b', 'c', 'd', 0x03 };
+    QString outFileName;
+
+    {
+        Project project;
+        project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+        project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+        project.getSettings()->setOutputDirectory(outputDir.path() + "/");
+        project.getSettings()->generateDataSections = true;
+        project.loadPlugins();
+
+        QVERIFY(project.loadBinaryFile(getFullSamplePath("pentium/hello")));
+
+        BinaryImage *image = project.getProg()->getBinaryFile()->getImage();
+
+        BinarySection *text = image->createSection(".text_data", Address(0x10000000),
+                                                   Address(0x10000000 + sizeof(textData) - 1));
+        QVERIFY(text != nullptr);
+        text->setHostAddr(HostAddress(textData));
+        text->setData(true);
+
+        BinarySection *binary = image->createSection(".binary_data", Address(0x10001000),
+                                                     Address(0x10001000 + sizeof(binaryData)));
+        QVERIFY(binary != nullptr);
+        binary->setHostAddr(HostAddress(binaryData));
+        binary->setData(true);
+
+        QVERIFY(project.decodeBinaryFile());
+        QVERIFY(project.decompileBinaryFile());
+        QVERIFY(project.generateCode());
+
+        outFileName = project.getProg()->getRootModule()->getOutPath("c");
+    } // output files are closed here
+
+    QFile outFile(outFileName);
+    QVERIFY(outFile.open(QFile::ReadOnly));
+    const QString code = QString::fromUtf8(outFile.readAll());
+
+    QVERIFY(code.contains("unsigned char _text_data[12] =\n"
+                          "    \"Hello world\\n\";// 12 bytes\n"));
+    QVERIFY(code.contains("unsigned char _binary_data[7] =\n"
+                          "    \"\\x01\\x02\" \"abcd\\x03\";// 7 bytes\n"));
+}
+
+
+QTEST_GUILESS_MAIN(CCodeGeneratorTest)
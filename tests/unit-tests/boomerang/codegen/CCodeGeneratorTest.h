@@ -0,0 +1,26 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+/**
+ * Tests the C code generator
+ */
+class CCodeGeneratorTest : public BoomerangTest
+{
+    Q_OBJECT
+
+private slots:
+    /// Test generating the contents of data sections as byte arrays
+    void testGenerateDataSections();
+};
@@ -0,0 +1,199 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ControlFlowAnalyzerTest.h"
+
+
+#include "boomerang/codegen/ControlFlowAnalyzer.h"
+#include "boomerang/db/BasicBlock.h"
+#include "boomerang/db/proc/ProcCFG.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/exp/Terminal.h"
+#include "boomerang/ssl/statements/Assign.h"
+#include "boomerang/ssl/type/VoidType.h"
+
+
+static std::unique_ptr<RTLList> createRTLs(Address baseAddr, int numRTLs)
+{
+    std::unique_ptr<RTLList> rtls(new RTLList);
+
+    for (int i = 0; i < numRTLs; i++) {
+        rtls->push_back(std::unique_ptr<RTL>(new RTL(baseAddr + i,
+            { new Assign(VoidType::get(), Terminal::get(opNil), Terminal::get(opNil)) })));
+    }
+
+    return rtls;
+}
+
+
+void ControlFlowAnalyzerTest::testIfThenElse()
+{
+    UserProc proc(Address(0x1000), "test", nullptr);
+    ProcCFG *cfg = proc.getCFG();
+
+    BasicBlock *cond = cfg->createBB(BBType::Twoway, createRTLs(Address(0x1000), 1));
+    BasicBlock *bbThen = cfg->createBB(BBType::Oneway, createRTLs(Address(0x1001), 1));
+    BasicBlock *bbElse = cfg->createBB(BBType::Oneway, createRTLs(Address(0x1002), 1));
+    BasicBlock *ret = cfg->createBB(BBType::Ret, createRTLs(Address(0x1003), 1));
+
+    cfg->addEdge(cond, bbThen);
+    cfg->addEdge(cond, bbElse);
+    cfg->addEdge(bbThen, ret);
+    cfg->addEdge(bbElse, ret);
+    cfg->setEntryAndExitBB(cond);
+
+    ControlFlowAnalyzer analyzer;
+    analyzer.structureCFG(cfg);
+
+    QVERIFY(analyzer.getStructType(cond) == StructType::Cond);
+    QVERIFY(analyzer.getCondType(cond) == CondType::IfThenElse);
+    QVERIFY(analyzer.getCondFollow(cond) == ret);
+    QVERIFY(analyzer.getImmPDom(cond) == ret);
+    QVERIFY(analyzer.getImmPDom(bbThen) == ret);
+    QVERIFY(analyzer.getImmPDom(ret) == nullptr);
+    QVERIFY(analyzer.getStructType(bbThen) == StructType::Seq);
+    QVERIFY(!analyzer.isBackEdge(bbThen, ret));
+}
+
+
+void ControlFlowAnalyzerTest::testWhileLoop()
+{
+    UserProc proc(Address(0x1000), "test", nullptr);
+    ProcCFG *cfg = proc.getCFG();
+
+    BasicBlock *entry = cfg->createBB(BBType::Oneway, createRTLs(Address(0x1000), 1));
+    BasicBlock *header = cfg->createBB(BBType::Twoway, createRTLs(Address(0x1001), 1));
+    BasicBlock *body = cfg->createBB(BBType::Oneway, createRTLs(Address(0x1002), 1));
+    BasicBlock *ret = cfg->createBB(BBType::Ret, createRTLs(Address(0x1003), 1));
+
+    cfg->addEdge(entry, header);
+    cfg->addEdge(header, body);
+    cfg->addEdge(header, ret);
+    cfg->addEdge(body, header);
+    cfg->setEntryAndExitBB(entry);
+
+    ControlFlowAnalyzer analyzer;
+    analyzer.structureCFG(cfg);
+
+    QVERIFY(analyzer.getStructType(header) == StructType::Loop);
+    QVERIFY(analyzer.getLoopType(header) == LoopType::PreTested);
+    QVERIFY(analyzer.getLatchNode(header) == body);
+    QVERIFY(analyzer.getLoopFollow(header) == ret);
+    QVERIFY(analyzer.getLoopHead(body) == header);
+    QVERIFY(analyzer.getLoopHead(entry) == nullptr);
+    QVERIFY(analyzer.isLatchNode(body));
+    QVERIFY(analyzer.isBackEdge(body, header));
+    QVERIFY(!analyzer.isBackEdge(header, body));
+}
+
+
+void ControlFlowAnalyzerTest::testNestedSwitch()
+{
+    UserProc proc(Address(0x1000), "test", nullptr);
+    ProcCFG *cfg = proc.getCFG();
+
+    // switch (a) {
+    // case 0: ...; break;
+    // case 1: switch (b) { case 0: ...; break; case 1: ...; break; } ...; break;
+    // default: ...; break;
+    // }
+    BasicBlock *outer = cfg->createBB(BBType::Nway, createRTLs(Address(0x1000), 1));
+    BasicBlock *caseA = cfg->createBB(BBType::Oneway, createRTLs(Address(0x1001), 1));
+    BasicBlock *inner = cfg->createBB(BBType::Nway, createRTLs(Address(0x1002), 1));
+    BasicBlock *innerA = cfg->createBB(BBType::Oneway, createRTLs(Address(0x1003), 1));
+    BasicBlock *innerB = cfg->createBB(BBType::Oneway, createRTLs(Address(0x1004), 1));
+    BasicBlock *innerFollow = cfg->createBB(BBType::Oneway, createRTLs(Address(0x1005), 1));
+    BasicBlock *caseDefault = cfg->createBB(BBType::Oneway, createRTLs(Address(0x1006), 1));
+    BasicBlock *ret = cfg->createBB(BBType::Ret, createRTLs(Address(0x1007), 1));
+
+    cfg->addEdge(outer, caseA);
+    cfg->addEdge(outer, inner);
+    cfg->addEdge(outer, caseDefault);
+    cfg->addEdge(caseA, ret);
+    cfg->addEdge(inner, innerA);
+    cfg->addEdge(inner, innerB);
+    cfg->addEdge(innerA, innerFollow);
+    cfg->addEdge(innerB, innerFollow);
+    cfg->addEdge(innerFollow, ret);
+    cfg->addEdge(caseDefault, ret);
+    cfg->setEntryAndExitBB(outer);
+
+    ControlFlowAnalyzer analyzer;
+    analyzer.structureCFG(cfg);
+
+    QVERIFY(analyzer.getStructType(outer) == StructType::Cond);
+    QVERIFY(analyzer.getCondType(outer) == CondType::Case);
+    QVERIFY(analyzer.getCondFollow(outer) == ret);
+    QVERIFY(analyzer.getStructType(inner) == StructType::Cond);
+    QVERIFY(analyzer.getCondType(inner) == CondType::Case);
+    QVERIFY(analyzer.getCondFollow(inner) == innerFollow);
+
+    QVERIFY(analyzer.getImmPDom(inner) == innerFollow);
+    QVERIFY(analyzer.getImmPDom(innerA) == innerFollow);
+    QVERIFY(analyzer.getImmPDom(innerFollow) == ret);
+    QVERIFY(analyzer.getImmPDom(outer) == ret);
+
+    // members of the inner switch belong to the inner switch,
+    // everything else up to the outer follow belongs to the outer switch
+    QVERIFY(analyzer.getCaseHead(outer) == nullptr);
+    QVERIFY(analyzer.getCaseHead(caseA) == outer);
+    QVERIFY(analyzer.getCaseHead(inner) == outer);
+    QVERIFY(analyzer.getCaseHead(innerA) == inner);
+    QVERIFY(analyzer.getCaseHead(innerB) == inner);
+    QVERIFY(analyzer.getCaseHead(innerFollow) == outer);
+    QVERIFY(analyzer.getCaseHead(caseDefault) == outer);
+    QVERIFY(analyzer.getCaseHead(ret) == nullptr);
+
+    QVERIFY(analyzer.isCaseOption(caseA));
+    QVERIFY(analyzer.isCaseOption(innerA));
+    QVERIFY(!analyzer.isCaseOption(innerFollow));
+}
+
+
+void ControlFlowAnalyzerTest::testLoopSequence()
+{
+    UserProc proc(Address(0x1000), "test", nullptr);
+    ProcCFG *cfg = proc.getCFG();
+
+    // A sequence of 1000 while loops, followed by a return block.
+    // See tests/benchmarks for the performance of structuring large CFGs.
+    const int numLoops = 1000;
+    std::vector<BasicBlock *> headers, bodies;
+
+    for (int i = 0; i < numLoops; i++) {
+        headers.push_back(cfg->createBB(BBType::Twoway, createRTLs(Address(0x1000 + 2 * i), 1)));
+        bodies.push_back(cfg->createBB(BBType::Oneway, createRTLs(Address(0x1001 + 2 * i), 1)));
+    }
+
+    BasicBlock *ret = cfg->createBB(BBType::Ret, createRTLs(Address(0x1000 + 2 * numLoops), 1));
+
+    for (int i = 0; i < numLoops; i++) {
+        cfg->addEdge(headers[i], bodies[i]);
+        cfg->addEdge(headers[i], i + 1 < numLoops ? headers[i + 1] : ret);
+        cfg->addEdge(bodies[i], headers[i]);
+    }
+
+    cfg->setEntryAndExitBB(headers[0]);
+
+    ControlFlowAnalyzer analyzer;
+    analyzer.structureCFG(cfg);
+
+    for (int i : { 0, numLoops / 2, numLoops - 1 }) {
+        QVERIFY(analyzer.getStructType(headers[i]) == StructType::Loop);
+        QVERIFY(analyzer.getLoopType(headers[i]) == LoopType::PreTested);
+        QVERIFY(analyzer.getLatchNode(headers[i]) == bodies[i]);
+        QVERIFY(analyzer.getLoopHead(bodies[i]) == headers[i]);
+        QVERIFY(analyzer.getLoopFollow(headers[i]) ==
+                (i + 1 < numLoops ? headers[i + 1] : ret));
+    }
+}
+
+
+QTEST_GUILESS_MAIN(ControlFlowAnalyzerTest)
@@ -0,0 +1,32 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+/**
+ * Tests control flow structuring
+ */
+class ControlFlowAnalyzerTest : public BoomerangTest
+{
+    Q_OBJECT
+
+private slots:
+    void testIfThenElse();
+    void testWhileLoop();
+
+    /// Test tagging the members of a switch statement nested inside another switch
+    void testNestedSwitch();
+
+    /// Test structuring a long sequence of loops
+    void testLoopSequence();
+};
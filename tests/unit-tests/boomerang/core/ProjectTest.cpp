@@ -12,7 +12,19 @@
 
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
+#include "boomerang/core/Watcher.h"
 #include "boomerang/db/Prog.h"
+#include "boomerang/db/module/Module.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/util/log/Trace.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+#include <map>
 
 
 void ProjectTest::testLoadBinaryFile()
@@ -86,6 +98,11 @@ void ProjectTest::testDecodeBinaryFile()
     QVERIFY(project.loadBinaryFile(getFullSamplePath("elf/hello-clang4-dynamic")));
     QVERIFY(project.decodeBinaryFile());
     QVERIFY(project.decodeBinaryFile()); // re-decode this file
+
+    // unreadable pattern files are errors
+    project.getSettings()->m_patternFiles.push_back("does-not-exist.pat");
+    QVERIFY(project.loadBinaryFile(getFullSamplePath("elf/hello-clang4-dynamic")));
+    QVERIFY(!project.decodeBinaryFile());
 }
 
 
@@ -122,4 +139,225 @@ void ProjectTest::testGenerateCode()
 }
 
 
+/// Decompile the sample \p samplePath and \returns the generated code of the root module.
+static QByteArray generateSampleCode(const QString &samplePath, int numThreads,
+                                     const QString &outputDir)
+{
+    QString outFileName;
+
+    {
+        Project project;
+        project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+        project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+        project.getSettings()->setOutputDirectory(outputDir);
+        project.getSettings()->numThreads = numThreads;
+        project.loadPlugins();
+
+        if (!project.loadBinaryFile(getFullSamplePath(samplePath)) ||
+            !project.decodeBinaryFile() || !project.decompileBinaryFile() ||
+            !project.generateCode()) {
+            return QByteArray();
+        }
+
+        outFileName = project.getProg()->getRootModule()->getOutPath("c");
+    } // output files are closed here
+
+    QFile outFile(outFileName);
+    return outFile.open(QFile::ReadOnly) ? outFile.readAll() : QByteArray();
+}
+
+
+void ProjectTest::testGenerateCodeParallel()
+{
+    QTemporaryDir serialDir, parallelDir;
+    QVERIFY(serialDir.isValid() && parallelDir.isValid());
+
+    // This sample has enough user procedures for all workers
+    const QString sample = "pentium/recursion";
+
+    const QByteArray serialCode = generateSampleCode(sample, 1, serialDir.path() + "/");
+
+    Trace::clear();
+    Trace::enable();
+    const QByteArray parallelCode = generateSampleCode(sample, 4, parallelDir.path() + "/");
+    Trace::disable();
+
+    QVERIFY(!serialCode.isEmpty());
+    QCOMPARE(parallelCode, serialCode);
+
+    // Check that the procedures were really generated by multiple workers
+    const QString traceFile = parallelDir.filePath("trace.json");
+    QVERIFY(Trace::writeChromeTrace(traceFile));
+    Trace::clear();
+
+    QFile file(traceFile);
+    QVERIFY(file.open(QFile::ReadOnly));
+
+    // Number of procedures generated by each thread
+    std::map<int, int> procsByThread;
+    for (const QJsonValue &event :
+         QJsonDocument::fromJson(file.readAll()).object()["traceEvents"].toArray()) {
+        if (event.toObject()["name"].toString() == "Generate code for proc") {
+            procsByThread[event.toObject()["tid"].toInt()]++;
+        }
+    }
+
+    QVERIFY(procsByThread.size() > 1);
+}
+
+
+/**
+ * Decompile the sample \p samplePath with the given per-procedure budgets.
+ * \param code receives the generated code of the root module
+ * \returns the names of all degraded procedures, or "<failed>" if the decompilation failed.
+ */
+static QStringList decompileWithBudget(const QString &samplePath, int passBudget,
+                                       double timeBudget, QByteArray &code)
+{
+    QTemporaryDir outputDir;
+    QStringList degradedProcs;
+    QString outFileName;
+
+    {
+        Project project;
+        project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+        project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+        project.getSettings()->setOutputDirectory(outputDir.path() + "/");
+        project.getSettings()->procPassBudget = passBudget;
+        project.getSettings()->procTimeBudget = timeBudget;
+        project.loadPlugins();
+
+        if (!outputDir.isValid() || !project.loadBinaryFile(getFullSamplePath(samplePath)) ||
+            !project.decodeBinaryFile() || !project.decompileBinaryFile() ||
+            !project.generateCode()) {
+            return { "<failed>" };
+        }
+
+        for (const auto &module : project.getProg()->getModuleList()) {
+            for (Function *function : *module) {
+                if (!function->isLib() && static_cast<UserProc *>(function)->isDegraded()) {
+                    degradedProcs.append(function->getName());
+                }
+            }
+        }
+
+        outFileName = project.getProg()->getRootModule()->getOutPath("c");
+    } // output files are closed here
+
+    QFile outFile(outFileName);
+    code = outFile.open(QFile::ReadOnly) ? outFile.readAll() : QByteArray();
+    return degradedProcs;
+}
+
+
+void ProjectTest::testProcPassBudget()
+{
+    const QByteArray comment = "Decompilation budget exceeded";
+    QByteArray code;
+
+    QStringList degraded = decompileWithBudget("pentium/recursion", 0, 0.0, code);
+    QCOMPARE(degraded, QStringList());
+    QVERIFY(!code.isEmpty());
+    QVERIFY(!code.contains(comment));
+
+    // A single propagation pass is not enough for any non-trivial procedure
+    degraded = decompileWithBudget("pentium/recursion", 1, 0.0, code);
+    QVERIFY(!degraded.isEmpty());
+    QVERIFY(!degraded.contains("<failed>"));
+    QCOMPARE(code.count(comment), degraded.size());
+}
+
+
+void ProjectTest::testProcTimeBudget()
+{
+    const QByteArray comment = "Decompilation budget exceeded";
+    QByteArray code;
+
+    // The budget is generous enough for every procedure
+    QStringList degraded = decompileWithBudget("pentium/recursion", 0, 3600.0, code);
+    QCOMPARE(degraded, QStringList());
+    QVERIFY(!code.isEmpty());
+    QVERIFY(!code.contains(comment));
+
+    // Every procedure reaching middleDecompile has exceeded a budget of 1ns
+    degraded = decompileWithBudget("pentium/recursion", 0, 1e-9, code);
+    QVERIFY(!degraded.isEmpty());
+    QVERIFY(!degraded.contains("<failed>"));
+    QVERIFY(degraded.contains("main"));
+    QCOMPARE(code.count(comment), degraded.size());
+}
+
+
+class CountingWatcher : public IWatcher
+{
+public:
+    CountingWatcher(bool allEvents)
+        : m_allEvents(allEvents)
+    {
+    }
+
+    bool wantsAllEvents() const override { return m_allEvents; }
+    void onProgress(const DecompileProgress &progress) override
+    {
+        numProgress++;
+        lastProgress = progress;
+    }
+
+    void onInstructionDecoded(Address, int) override { numInstructions++; }
+    void onFunctionCreated(Function *) override { numFunctionsCreated++; }
+
+public:
+    int numProgress         = 0;
+    int numInstructions     = 0;
+    int numFunctionsCreated = 0;
+    DecompileProgress lastProgress;
+
+private:
+    bool m_allEvents;
+};
+
+
+void ProjectTest::testWatcherProgress()
+{
+    Project project;
+    project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+    project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    project.loadPlugins();
+
+    CountingWatcher allEvents(true);
+    CountingWatcher coalesced(false);
+    project.addWatcher(&allEvents);
+    project.addWatcher(&coalesced);
+
+    QVERIFY(project.loadBinaryFile(getFullSamplePath("elf/hello-clang4-dynamic")));
+    QVERIFY(project.decodeBinaryFile());
+
+    QVERIFY(allEvents.numInstructions > 0);
+    QCOMPARE(allEvents.numProgress, 0);
+
+    QCOMPARE(coalesced.numInstructions, 0);
+    QVERIFY(coalesced.numProgress > 0);
+    QCOMPARE(coalesced.lastProgress.numInstructionsDecoded,
+             static_cast<uint64>(allEvents.numInstructions));
+
+    // structural events are batched, but not dropped
+    project.flushWatcherEvents();
+    QVERIFY(allEvents.numFunctionsCreated > 0);
+    QCOMPARE(coalesced.numFunctionsCreated, allEvents.numFunctionsCreated);
+
+    // the procs counted by status are the procs of the program
+    std::map<ProcStatus, int> numProcsByStatus;
+    for (const auto &module : project.getProg()->getModuleList()) {
+        for (Function *function : *module) {
+            if (!function->isLib()) {
+                numProcsByStatus[static_cast<UserProc *>(function)->getStatus()]++;
+            }
+        }
+    }
+
+    QVERIFY(!numProcsByStatus.empty());
+    QVERIFY(coalesced.lastProgress.numProcsByStatus == numProcsByStatus);
+}
+
+
 QTEST_GUILESS_MAIN(ProjectTest)
@@ -34,4 +34,16 @@ private slots:
     void testDecodeBinaryFile();
     void testDecompileBinaryFile();
     void testGenerateCode();
+
+    /// Test that generating code with multiple threads gives the same output
+    void testGenerateCodeParallel();
+
+    /// Test that procedures exceeding their propagation pass budget are degraded
+    void testProcPassBudget();
+
+    /// Test that procedures exceeding their time budget are degraded
+    void testProcTimeBudget();
+
+    /// Test that high-frequency events are coalesced into progress updates
+    void testWatcherProgress();
 };
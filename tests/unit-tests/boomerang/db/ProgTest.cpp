@@ -16,6 +16,8 @@
 #include "boomerang/db/binary/BinarySymbol.h"
 #include "boomerang/db/binary/BinarySymbolTable.h"
 #include "boomerang/db/proc/LibProc.h"
+#include "boomerang/db/proc/ProcCFG.h"
+#include "boomerang/db/proc/UserProc.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/db/module/Module.h"
 #include "boomerang/db/signature/Signature.h"
@@ -222,6 +224,177 @@ void ProgTest::testRemoveFunction()
 }
 
 
+void ProgTest::testGetFunctionsInRange()
+{
+    Prog prog("test", &m_project);
+    QVERIFY(prog.getFunctionsInRange(Address(0x0000), Address(0x4000)).empty());
+
+    Function *f1 = prog.getOrCreateFunction(Address(0x2000));
+    Function *f2 = prog.getOrCreateFunction(Address(0x1000));
+    Function *f3 = prog.getOrCreateFunction(Address(0x3000));
+
+    std::vector<Function *> funcs = prog.getFunctionsInRange(Address(0x0000), Address(0x4000));
+    QCOMPARE(funcs.size(), static_cast<size_t>(3));
+    QVERIFY(funcs[0] == f2);
+    QVERIFY(funcs[1] == f1);
+    QVERIFY(funcs[2] == f3);
+
+    funcs = prog.getFunctionsInRange(Address(0x1000), Address(0x3000));
+    QCOMPARE(funcs.size(), static_cast<size_t>(2));
+    QVERIFY(funcs[0] == f2);
+    QVERIFY(funcs[1] == f1);
+
+    QVERIFY(prog.getFunctionsInRange(Address(0x1001), Address(0x2000)).empty());
+}
+
+
+void ProgTest::testGetFunctionContaining()
+{
+    Prog prog("test", &m_project);
+    QVERIFY(prog.getFunctionContaining(Address(0x1000)) == nullptr);
+
+    UserProc *proc1 = static_cast<UserProc *>(prog.getOrCreateFunction(Address(0x1000)));
+    UserProc *proc2 = static_cast<UserProc *>(prog.getOrCreateFunction(Address(0x1008)));
+    proc1->setName("proc1");
+    proc2->setName("proc2");
+
+    prog.addDecodedCode(proc1, Address(0x1000), Address(0x1004));
+    prog.addDecodedCode(proc1, Address(0x1004), Address(0x1010));
+    QVERIFY(prog.getFunctionContaining(Address(0x0FFF)) == nullptr);
+    QVERIFY(prog.getFunctionContaining(Address(0x1000)) == proc1);
+    QVERIFY(prog.getFunctionContaining(Address(0x100F)) == proc1);
+    QVERIFY(prog.getFunctionContaining(Address(0x1010)) == nullptr);
+
+    // shared code belongs to the procedure that decoded it first
+    prog.addDecodedCode(proc2, Address(0x1008), Address(0x1020));
+    QVERIFY(prog.getFunctionContaining(Address(0x1008)) == proc1);
+    QVERIFY(prog.getFunctionContaining(Address(0x1010)) == proc2);
+    QVERIFY(prog.getFunctionContaining(Address(0x101F)) == proc2);
+    QVERIFY(prog.getFunctionContaining(Address(0x1020)) == nullptr);
+
+    // only the gaps between existing code are added
+    prog.addDecodedCode(proc2, Address(0x2000), Address(0x2004));
+    prog.addDecodedCode(proc1, Address(0x1FF0), Address(0x2010));
+    QVERIFY(prog.getFunctionContaining(Address(0x1FF0)) == proc1);
+    QVERIFY(prog.getFunctionContaining(Address(0x2003)) == proc2);
+    QVERIFY(prog.getFunctionContaining(Address(0x2004)) == proc1);
+    QVERIFY(prog.getFunctionContaining(Address(0x200F)) == proc1);
+
+    QVERIFY(prog.removeFunction("proc2"));
+    QVERIFY(prog.getFunctionContaining(Address(0x1010)) == nullptr);
+    QVERIFY(prog.getFunctionContaining(Address(0x2000)) == nullptr);
+    QVERIFY(prog.getFunctionContaining(Address(0x1008)) == proc1);
+
+    // decoded code is added by the front end
+    QVERIFY(m_project.loadBinaryFile(HELLO_PENTIUM));
+    Prog *helloProg    = m_project.getProg();
+    UserProc *mainProc = static_cast<UserProc *>(
+        helloProg->getOrCreateFunction(Address(0x08048328)));
+    QVERIFY(helloProg->decodeFragment(mainProc, Address(0x08048328)));
+
+    QVERIFY(helloProg->getFunctionContaining(Address(0x08048328)) == mainProc);
+    QVERIFY(helloProg->getFunctionContaining(Address(0x08048329)) == mainProc);
+    QVERIFY(helloProg->getFunctionContaining(Address(0x08048327)) == nullptr);
+}
+
+
+void ProgTest::testRemoveDecodedCode()
+{
+    Prog prog("test", &m_project);
+
+    UserProc *proc1 = static_cast<UserProc *>(prog.getOrCreateFunction(Address(0x1000)));
+    UserProc *proc2 = static_cast<UserProc *>(prog.getOrCreateFunction(Address(0x1010)));
+
+    prog.addDecodedCode(proc1, Address(0x1000), Address(0x1010));
+    prog.addDecodedCode(proc2, Address(0x1010), Address(0x1020));
+    prog.addDecodedCode(proc1, Address(0x1020), Address(0x1024));
+    QCOMPARE(prog.getDecodedCode().size(), size_t(3));
+
+    prog.removeDecodedCode(proc1);
+    QVERIFY(prog.getFunctionContaining(Address(0x1000)) == nullptr);
+    QVERIFY(prog.getFunctionContaining(Address(0x1010)) == proc2);
+    QVERIFY(prog.getFunctionContaining(Address(0x1020)) == nullptr);
+
+    const std::vector<std::pair<Address, Address>> code = prog.getDecodedCode();
+    QCOMPARE(code.size(), size_t(1));
+    QCOMPARE(code[0].first, Address(0x1010));
+    QCOMPARE(code[0].second, Address(0x1020));
+
+    // the code can be claimed by another procedure now
+    prog.addDecodedCode(proc2, Address(0x1000), Address(0x1010));
+    QVERIFY(prog.getFunctionContaining(Address(0x1000)) == proc2);
+
+    // Decoding a procedure again discards its stale code
+    QVERIFY(m_project.loadBinaryFile(HELLO_PENTIUM));
+    Prog *helloProg    = m_project.getProg();
+    UserProc *mainProc = static_cast<UserProc *>(
+        helloProg->getOrCreateFunction(Address(0x08048328)));
+    QVERIFY(helloProg->decodeFragment(mainProc, Address(0x08048328)));
+
+    helloProg->addDecodedCode(mainProc, Address(0x08048300), Address(0x08048304));
+    QVERIFY(helloProg->getFunctionContaining(Address(0x08048300)) == mainProc);
+
+    mainProc->getCFG()->clear();
+    QVERIFY(helloProg->reDecode(mainProc));
+    QVERIFY(helloProg->getFunctionContaining(Address(0x08048300)) == nullptr);
+    QVERIFY(helloProg->getFunctionContaining(Address(0x08048328)) == mainProc);
+}
+
+
+void ProgTest::testFunctionIndex()
+{
+    Prog prog("test", &m_project);
+
+    Function *func = prog.getOrCreateFunction(Address(0x1000));
+    func->setName("foo");
+    QVERIFY(prog.getFunctionByName("foo") == func);
+
+    func->setName("bar");
+    QVERIFY(prog.getFunctionByName("foo") == nullptr);
+    QVERIFY(prog.getFunctionByName("bar") == func);
+
+    func->setEntryAddress(Address(0x2000));
+    QVERIFY(prog.getFunctionByAddr(Address(0x1000)) == nullptr);
+    QVERIFY(prog.getFunctionByAddr(Address(0x2000)) == func);
+
+    // moving a function to another module keeps it in the index
+    Module *mod = prog.getOrInsertModule("otherModule");
+    func->setModule(mod);
+    QVERIFY(prog.getFunctionByAddr(Address(0x2000)) == func);
+    QVERIFY(prog.getFunctionByName("bar") == func);
+
+    QVERIFY(prog.removeFunction("bar"));
+    QVERIFY(prog.getFunctionByAddr(Address(0x2000)) == nullptr);
+    QVERIFY(prog.getFunctionByName("bar") == nullptr);
+}
+
+
+void ProgTest::testDecodeWorklist()
+{
+    Prog prog("test", &m_project);
+    QVERIFY(prog.takeNextUndecodedProc() == nullptr);
+
+    UserProc *foo = static_cast<UserProc *>(prog.getOrCreateFunction(Address(0x1000)));
+    UserProc *bar = static_cast<UserProc *>(prog.getOrCreateFunction(Address(0x2000)));
+    UserProc *baz = static_cast<UserProc *>(prog.getOrCreateFunction(Address(0x3000)));
+    prog.getOrCreateLibraryProc("lib");
+    QCOMPARE(prog.getDecodeWorklistSize(), 3);
+
+    // procedures are returned in order of discovery,
+    // skipping procedures that were decoded or removed in the meantime
+    bar->setDecoded();
+    QVERIFY(prog.removeFunction(baz->getName()));
+
+    QVERIFY(prog.takeNextUndecodedProc() == foo);
+    QVERIFY(prog.takeNextUndecodedProc() == nullptr);
+
+    // newly discovered procedures are appended to the worklist
+    Function *qux = prog.getOrCreateFunction(Address(0x4000));
+    QVERIFY(prog.takeNextUndecodedProc() == qux);
+    QCOMPARE(prog.getDecodeWorklistSize(), 0);
+}
+
+
 void ProgTest::testGetNumFunctions()
 {
     Prog prog("test", &m_project);
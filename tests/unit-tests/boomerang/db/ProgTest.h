@@ -36,6 +36,11 @@ private slots:
     void testGetFunctionByAddr();
     void testGetFunctionByName();
     void testRemoveFunction();
+    void testGetFunctionsInRange();
+    void testGetFunctionContaining();
+    void testRemoveDecodedCode();
+    void testFunctionIndex();
+    void testDecodeWorklist();
     void testGetNumFunctions();
 
     void testIsWellFormed();
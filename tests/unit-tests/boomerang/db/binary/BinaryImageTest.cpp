@@ -101,6 +101,17 @@ void BinaryImageTest::testGetSectionByAddr()
     QVERIFY(img.getSectionByAddr(Address(0x1000)) == sect1);
     QVERIFY(img.getSectionByAddr(Address(0x1800)) == sect1);
     QVERIFY(img.getSectionByAddr(Address(0x2000)) == nullptr);
+
+    // overlapping sections; the section with the lowest start address wins
+    BinarySection *sect2 = img.createSection("sect2", Address(0x1800), Address(0x2800));
+    QVERIFY(img.getSectionByAddr(Address(0x1800)) == sect1);
+    QVERIFY(img.getSectionByAddr(Address(0x2000)) == sect2);
+    QVERIFY(img.getSectionByAddr(Address(0x1000)) == sect1);
+
+    BinarySection *sect3 = img.createSection("sect3", Address(0x0800), Address(0x0900));
+    QVERIFY(img.getSectionByAddr(Address(0x0800)) == sect3);
+    QVERIFY(img.getSectionByAddr(Address(0x0900)) == nullptr);
+    QVERIFY(img.getSectionByAddr(Address(0x27FF)) == sect2);
 }
 
 
@@ -179,6 +190,87 @@ void BinaryImageTest::testRead()
 }
 
 
+void BinaryImageTest::testReadArray()
+{
+    char sectionData[8] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77 };
+    DWord values[4]     = { 0, 0, 0, 0 };
+
+    BinaryImage img(QByteArray{});
+    QCOMPARE(img.readNative4(Address(0x1000), values, 2), static_cast<std::size_t>(0));
+
+    BinarySection *sect1 = img.createSection("sect1", Address(0x1000), Address(0x1008));
+    QCOMPARE(img.readNative4(Address(0x1000), values, 2), static_cast<std::size_t>(0));
+
+    sect1->setHostAddr(HostAddress(sectionData));
+    QCOMPARE(img.readNative4(Address(0x1000), values, 2), static_cast<std::size_t>(2));
+    QCOMPARE(values[0], static_cast<DWord>(0x33221100));
+    QCOMPARE(values[1], static_cast<DWord>(0x77665544));
+
+    // read crosses section boundary
+    QCOMPARE(img.readNative4(Address(0x1002), values, 4), static_cast<std::size_t>(1));
+    QCOMPARE(values[0], static_cast<DWord>(0x55443322));
+
+    sect1->setEndian(Endian::Big);
+    SWord words[4] = { 0, 0, 0, 0 };
+    QCOMPARE(img.readNative2(Address(0x1000), words, 4), static_cast<std::size_t>(4));
+    QCOMPARE(words[0], static_cast<SWord>(0x0011));
+    QCOMPARE(words[3], static_cast<SWord>(0x6677));
+}
+
+
+void BinaryImageTest::testCountPointersInRange()
+{
+    DWord table[4] = { 0x1000, 0x1004, 0x5000, 0x1008 };
+
+    BinaryImage img(QByteArray{});
+    BinarySection *sect1 = img.createSection("sect1", Address(0x2000), Address(0x2010));
+    sect1->setHostAddr(HostAddress(table));
+
+    QCOMPARE(img.countPointersInRange(Address(0x2000), 4, 4, Address(0x1000), Address(0x2000)),
+             static_cast<std::size_t>(2));
+    QCOMPARE(img.countPointersInRange(Address(0x2000), 1, 4, Address(0x1000), Address(0x2000)),
+             static_cast<std::size_t>(1));
+    QCOMPARE(img.countPointersInRange(Address(0x200C), 4, 4, Address(0x1000), Address(0x2000)),
+             static_cast<std::size_t>(1));
+    QCOMPARE(img.countPointersInRange(Address(0x3000), 4, 4, Address(0x1000), Address(0x2000)),
+             static_cast<std::size_t>(0));
+}
+
+
+void BinaryImageTest::testFindPointersInRange()
+{
+    DWord table[4] = { 0x1000, 0x1004, 0x5000, 0x1008 };
+
+    BinaryImage img(QByteArray{});
+    BinarySection *sect1 = img.createSection("sect1", Address(0x2000), Address(0x2010));
+    sect1->setHostAddr(HostAddress(table));
+
+    std::vector<Address> result = img.findPointersInRange(Address(0x0000), Address(0x3000), 4,
+                                                          Address(0x1000), Address(0x2000));
+
+    QCOMPARE(result.size(), static_cast<std::size_t>(3));
+    QCOMPARE(result[0], Address(0x2000));
+    QCOMPARE(result[1], Address(0x2004));
+    QCOMPARE(result[2], Address(0x200C));
+
+    result = img.findPointersInRange(Address(0x2001), Address(0x200C), 4, Address(0x1000),
+                                     Address(0x2000));
+    QCOMPARE(result.size(), static_cast<std::size_t>(1));
+    QCOMPARE(result[0], Address(0x2004));
+
+    // pointers in a later section, after a gap without sections
+    DWord table2[2] = { 0x1010, 0x0000 };
+    BinarySection *sect2 = img.createSection("sect2", Address(0x2800), Address(0x2808));
+    sect2->setHostAddr(HostAddress(table2));
+
+    result = img.findPointersInRange(Address(0x2008), Address(0x3000), 4, Address(0x1000),
+                                     Address(0x2000));
+    QCOMPARE(result.size(), static_cast<std::size_t>(2));
+    QCOMPARE(result[0], Address(0x200C));
+    QCOMPARE(result[1], Address(0x2800));
+}
+
+
 void BinaryImageTest::testWrite()
 {
     char sectionData[8] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77 };
@@ -220,4 +312,28 @@ void BinaryImageTest::testIsReadOnly()
 }
 
 
+void BinaryImageTest::testRelocations()
+{
+    BinaryImage img(QByteArray{});
+    QCOMPARE(img.getNumRelocations(), static_cast<std::size_t>(0));
+    QVERIFY(!img.isRelocationAt(Address(0x1000)));
+    QCOMPARE(img.findRelocation(Address(0x1000), Address(0x2000)), Address::INVALID);
+
+    img.addRelocations({ Address(0x1010), Address(0x1000), Address(0x1010) });
+    img.addRelocations({ Address(0x1008) });
+    QCOMPARE(img.getNumRelocations(), static_cast<std::size_t>(3));
+
+    QVERIFY(img.isRelocationAt(Address(0x1000)));
+    QVERIFY(img.isRelocationAt(Address(0x1008)));
+    QVERIFY(!img.isRelocationAt(Address(0x1004)));
+
+    QCOMPARE(img.findRelocation(Address(0x1001), Address(0x2000)), Address(0x1008));
+    QCOMPARE(img.findRelocation(Address(0x1009), Address(0x1010)), Address::INVALID);
+    QCOMPARE(img.findRelocation(Address(0x1009), Address(0x1011)), Address(0x1010));
+
+    img.reset();
+    QCOMPARE(img.getNumRelocations(), static_cast<std::size_t>(0));
+}
+
+
 QTEST_GUILESS_MAIN(BinaryImageTest)
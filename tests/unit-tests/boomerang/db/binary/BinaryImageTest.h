@@ -28,7 +28,11 @@ private slots:
     void testUpdateTextLimits();
 
     void testRead();
+    void testReadArray();
+    void testCountPointersInRange();
+    void testFindPointersInRange();
     void testWrite();
 
     void testIsReadOnly();
+    void testRelocations();
 };
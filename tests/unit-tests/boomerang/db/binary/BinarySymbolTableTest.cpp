@@ -14,6 +14,9 @@
 #include "boomerang/db/binary/BinarySymbol.h"
 #include "boomerang/db/binary/BinarySymbolTable.h"
 
+#include <atomic>
+#include <thread>
+
 
 void BinarySymbolTableTest::testSize()
 {
@@ -66,6 +69,27 @@ void BinarySymbolTableTest::testCreateSymbol()
 }
 
 
+void BinarySymbolTableTest::testCreateSymbols()
+{
+    BinarySymbolTable tbl;
+
+    QCOMPARE(tbl.createSymbols({}), 0);
+    QCOMPARE(tbl.createSymbols({ { Address(0x1000), "sym1" },
+                                 { Address(0x2000), "sym2" },
+                                 { Address(0x2000), "sym3" },   // same address
+                                 { Address(0x3000), "sym1" } }), // same name
+             2);
+
+    QCOMPARE(tbl.size(), 2);
+    QVERIFY(tbl.findSymbolByName("sym3") == nullptr);
+    QVERIFY(tbl.findSymbolByAddress(Address(0x3000)) == tbl.findSymbolByName("sym1"));
+
+    QCOMPARE(tbl.createSymbols({ { Address(0x4000), "local" } }, true), 1);
+    QVERIFY(tbl.findSymbolByAddress(Address(0x4000)) != nullptr);
+    QVERIFY(tbl.findSymbolByName("local") == nullptr);
+}
+
+
 void BinarySymbolTableTest::testFindSymbolByAddress()
 {
     BinarySymbolTable tbl;
@@ -88,6 +112,60 @@ void BinarySymbolTableTest::testFindSymbolByName()
 }
 
 
+void BinarySymbolTableTest::testFindSymbolContaining()
+{
+    BinarySymbolTable tbl;
+    QVERIFY(tbl.findSymbolContaining(Address(0x1000)) == nullptr);
+
+    BinarySymbol *sym1 = tbl.createSymbol(Address(0x2000), "sym1");
+    BinarySymbol *sym2 = tbl.createSymbol(Address(0x1000), "sym2");
+    sym2->setSize(0x10);
+
+    QVERIFY(tbl.findSymbolContaining(Address(0x0800)) == nullptr);
+    QVERIFY(tbl.findSymbolContaining(Address(0x1000)) == sym2);
+    QVERIFY(tbl.findSymbolContaining(Address(0x100F)) == sym2);
+    QVERIFY(tbl.findSymbolContaining(Address(0x1010)) == nullptr);
+    QVERIFY(tbl.findSymbolContaining(Address(0x2000)) == sym1);
+    QVERIFY(tbl.findSymbolContaining(Address(0x2001)) == nullptr); // size 0
+
+    // symbols added after the first lookup
+    BinarySymbol *sym3 = tbl.createSymbol(Address(0x1800), "sym3");
+    sym3->setSize(0x100);
+    QVERIFY(tbl.findSymbolContaining(Address(0x1810)) == sym3);
+    QVERIFY(tbl.findSymbolContaining(Address(0x1008)) == sym2);
+}
+
+
+void BinarySymbolTableTest::testFindSymbolContainingParallel()
+{
+    BinarySymbolTable tbl;
+    for (int i = 0; i < 10000; i++) {
+        tbl.createSymbol(Address(0x100000 - 0x10 * i), QString("sym%1").arg(i))->setSize(0x10);
+    }
+
+    // All threads race to build the sorted index on their first lookup
+    std::atomic<int> numFound(0);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&tbl, &numFound]() {
+            for (int i = 0; i < 10000; i++) {
+                const BinarySymbol *sym = tbl.findSymbolContaining(Address(0x100008 - 0x10 * i));
+                if (sym && sym->getName() == QString("sym%1").arg(i)) {
+                    numFound++;
+                }
+            }
+        });
+    }
+
+    for (std::thread &t : threads) {
+        t.join();
+    }
+
+    QCOMPARE(numFound.load(), 4 * 10000);
+}
+
+
 void BinarySymbolTableTest::testRenameSymbol()
 {
     BinarySymbolTable tbl;
@@ -105,6 +183,11 @@ void BinarySymbolTableTest::testRenameSymbol()
 
     tbl.createSymbol(Address(0x2000), "test2");
     QVERIFY(!tbl.renameSymbol("foo1", "test2")); // name clash
+
+    QVERIFY(tbl.findSymbolByName("test1") == nullptr);
+    QVERIFY(tbl.renameSymbol("foo1", "test1"));
+    QVERIFY(tbl.findSymbolByName("test1") == test1);
+    QVERIFY(tbl.findSymbolByName("foo1") == nullptr);
 }
 
 
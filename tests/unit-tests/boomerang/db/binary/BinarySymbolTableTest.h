@@ -23,7 +23,10 @@ private slots:
     void testClear();
 
     void testCreateSymbol();
+    void testCreateSymbols();
     void testFindSymbolByAddress();
     void testFindSymbolByName();
+    void testFindSymbolContaining();
+    void testFindSymbolContainingParallel();
     void testRenameSymbol();
 };
@@ -0,0 +1,110 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "BytePatternScannerTest.h"
+
+
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySection.h"
+#include "boomerang/db/binary/BytePatternScanner.h"
+
+
+void BytePatternScannerTest::testAddPattern()
+{
+    BytePatternScanner scanner;
+
+    QCOMPARE(scanner.addPattern(""), -1);
+    QCOMPARE(scanner.addPattern("?? ??"), -1);
+    QCOMPARE(scanner.addPattern("FF 2"), -1);
+    QCOMPARE(scanner.addPattern("FF XY"), -1);
+    QCOMPARE(scanner.getNumPatterns(), 0);
+
+    QCOMPARE(scanner.addPattern("FF 25 ?? ?? ?? ??"), 0);
+    QCOMPARE(scanner.addPattern({ 0x55, 0x89 }, { 0xFF, 0xF0 }), 1);
+    QCOMPARE(scanner.getNumPatterns(), 2);
+    QCOMPARE(scanner.getPatternLength(0), 6);
+    QCOMPARE(scanner.getPatternLength(1), 2);
+}
+
+
+void BytePatternScannerTest::testScan()
+{
+    BytePatternScanner scanner;
+    const int jump = scanner.addPattern("FF 25 ?? ?? ?? ??");
+
+    const Byte data[] = { 0x90, 0xFF, 0x25, 0x00, 0x10, 0x40, 0x00, 0xFF, 0x25, 0x04,
+                          0x10, 0x40, 0x00, 0xFF, 0x25, 0x08, 0x10 }; // last one is truncated
+
+    std::vector<BytePatternScanner::Match> matches;
+    scanner.scan(data, sizeof(data), Address(0x1000), matches);
+
+    QCOMPARE(matches.size(), static_cast<std::size_t>(2));
+    QCOMPARE(matches[0].patternID, jump);
+    QCOMPARE(matches[0].addr, Address(0x1001));
+    QCOMPARE(matches[1].addr, Address(0x1007));
+
+    // wildcards before the anchor and partially masked bytes
+    const int prologue = scanner.addPattern({ 0x00, 0x55, 0x89, 0xE0 }, { 0x00, 0xFF, 0xFF, 0xF0 });
+    const Byte code[]  = { 0x55, 0x89, 0xE5, 0xC3, 0x55, 0x89, 0xE5, 0x55, 0x89, 0xD0 };
+
+    matches.clear();
+    scanner.scan(code, sizeof(code), Address(0x2000), matches);
+
+    QCOMPARE(matches.size(), static_cast<std::size_t>(1));
+    QCOMPARE(matches[0].patternID, prologue);
+    QCOMPARE(matches[0].addr, Address(0x2003));
+}
+
+
+void BytePatternScannerTest::testScanOverlapping()
+{
+    BytePatternScanner scanner;
+    const int p1 = scanner.addPattern("AA BB CC");
+    const int p2 = scanner.addPattern("BB CC");
+    const int p3 = scanner.addPattern("CC ?? AA");
+
+    const Byte data[] = { 0xAA, 0xBB, 0xCC, 0xDD, 0xAA, 0xBB };
+
+    std::vector<BytePatternScanner::Match> matches;
+    scanner.scan(data, sizeof(data), Address(0x1000), matches);
+
+    QCOMPARE(matches.size(), static_cast<std::size_t>(3));
+    QCOMPARE(matches[0].patternID, p1);
+    QCOMPARE(matches[0].addr, Address(0x1000));
+    QCOMPARE(matches[1].patternID, p2);
+    QCOMPARE(matches[1].addr, Address(0x1001));
+    QCOMPARE(matches[2].patternID, p3);
+    QCOMPARE(matches[2].addr, Address(0x1002));
+}
+
+
+void BytePatternScannerTest::testScanCode()
+{
+    Byte codeData[] = { 0x90, 0xC3, 0x90, 0xC3 };
+    Byte dataData[] = { 0x90, 0xC3 };
+
+    BinaryImage img(QByteArray{});
+    BinarySection *code = img.createSection("code", Address(0x1000), Address(0x1004));
+    code->setHostAddr(HostAddress(codeData));
+    code->setCode(true);
+
+    BinarySection *data = img.createSection("data", Address(0x2000), Address(0x2002));
+    data->setHostAddr(HostAddress(dataData));
+
+    BytePatternScanner scanner;
+    scanner.addPattern("90 C3");
+
+    const std::vector<BytePatternScanner::Match> matches = scanner.scanCode(&img);
+    QCOMPARE(matches.size(), static_cast<std::size_t>(2));
+    QCOMPARE(matches[0].addr, Address(0x1000));
+    QCOMPARE(matches[1].addr, Address(0x1002));
+}
+
+
+QTEST_GUILESS_MAIN(BytePatternScannerTest)
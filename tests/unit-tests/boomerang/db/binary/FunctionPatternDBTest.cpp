@@ -0,0 +1,181 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "FunctionPatternDBTest.h"
+
+
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySection.h"
+#include "boomerang/db/binary/BinarySymbol.h"
+#include "boomerang/db/binary/BinarySymbolTable.h"
+#include "boomerang/db/binary/FunctionPatternDB.h"
+
+#include <QTemporaryDir>
+
+
+void FunctionPatternDBTest::testAddPattern()
+{
+    FunctionPatternDB db;
+
+    QVERIFY(!db.addPattern("5589E583EC08C70424", 9, 0, 0, ""));
+    QVERIFY(!db.addPattern("5589E583EC08C70424C", 10, 0, 0, "foo"));      // odd number of digits
+    QVERIFY(!db.addPattern("5589E583EC08C704XY", 9, 0, 0, "foo"));        // not hexadecimal
+    QVERIFY(!db.addPattern("5589E5........C3", 8, 0, 0, "foo"));          // too few fixed bytes
+    QVERIFY(!db.addPattern(QString("90").repeated(33), 33, 0, 0, "foo")); // too long
+    QVERIFY(!db.addPattern("5589E583EC08C70424........E8", 13, 0, 0, "foo")); // too small
+    QVERIFY(!db.addPattern("5589E583EC08C70424........E8", 20, 7, 0, "foo")); // CRC too long
+    QVERIFY(!db.addPattern("5589E583EC08C70424........E8", 0x200, 0x100, 0, "foo"));
+    QCOMPARE(db.getNumPatterns(), 0);
+
+    QVERIFY(db.addPattern("5589E583EC08C70424........E8", 20, 6, 0x1234, "foo"));
+    QCOMPARE(db.getNumPatterns(), 1);
+}
+
+
+void FunctionPatternDBTest::testIdentifyFunctions()
+{
+    Byte code[] = {
+        0x55, 0x89, 0xE5, 0x83, 0xEC, 0x08, 0xC7, 0x04, 0x24, 0x00, 0x10, 0x40, 0x00, 0xC9, 0xC3, // foo
+        0x90,
+        0x55, 0x89, 0xE5, 0x83, 0xEC, 0x08, 0xC7, 0x04, 0x24, 0x20, 0x10, 0x40, 0x00, 0xC9, 0xC3, // foo
+        0x90,
+        0x55, 0x89, 0xE5, 0x8B, 0x45, 0x08, 0x03, 0x45, 0x0C, 0xC9, 0xC3, // bar
+        0x90,
+        0x55, 0x89, 0xE5, 0x8B, 0x45, 0x08, 0x2B, 0x45, 0x0C, 0xC9, 0xC3, // baz
+    };
+
+    BinaryImage img(QByteArray{});
+    BinarySection *text = img.createSection(".text", Address(0x1000), Address(0x1000 + sizeof(code)));
+    text->setHostAddr(HostAddress(code));
+    text->setCode(true);
+
+    BinarySymbolTable symbols;
+    symbols.createSymbol(Address(0x102C), "main");
+
+    FunctionPatternDB db;
+    QVERIFY(db.addPattern("5589E583EC08C70424........C9C3", 15, 0, 0, "foo"));
+    QVERIFY(db.addPattern("5589E58B45080345..C9C3", 11, 0, 0, "bar"));
+    QVERIFY(db.addPattern("5589E58B45082B45..C9C3", 11, 0, 0, "baz"));
+
+    // foo matches twice, and there already is a symbol at the address of baz
+    const std::set<Address> starts = { Address(0x1000), Address(0x1010), Address(0x1020),
+                                       Address(0x102C) };
+    QCOMPARE(db.identifyFunctions(&img, &symbols, starts), 1);
+
+    const BinarySymbol *bar = symbols.findSymbolByName("bar");
+    QVERIFY(bar != nullptr);
+    QCOMPARE(bar->getLocation(), Address(0x1020));
+    QCOMPARE(bar->getSize(), 11);
+    QVERIFY(bar->isStaticFunction());
+
+    QVERIFY(symbols.findSymbolByName("foo") == nullptr);
+    QCOMPARE(symbols.findSymbolByAddress(Address(0x102C))->getName(), QString("main"));
+
+    // Matches that are not at a function start are ignored, so foo is unambiguous now
+    symbols.clear();
+    QCOMPARE(db.identifyFunctions(&img, &symbols, { Address(0x1000), Address(0x1020) }), 2);
+    QCOMPARE(symbols.findSymbolByName("foo")->getLocation(), Address(0x1000));
+    QVERIFY(symbols.findSymbolByAddress(Address(0x1010)) == nullptr);
+    QVERIFY(symbols.findSymbolByAddress(Address(0x102C)) == nullptr);
+
+    symbols.clear();
+    QCOMPARE(db.identifyFunctions(&img, &symbols, {}), 0);
+}
+
+
+void FunctionPatternDBTest::testWholeFunction()
+{
+    QCOMPARE(FunctionPatternDB::crc16(reinterpret_cast<const Byte *>("123456789"), 9),
+             static_cast<SWord>(0x6E90));
+
+    Byte code[] = {
+        0x55, 0x89, 0xE5, 0x83, 0xEC, 0x10, 0xC7, 0x04, 0x24, 0x00, 0x10, 0x40, 0x00,
+        0x8B, 0x45, 0x08, 0x03, 0x45, 0x0C, 0x89, 0x45, 0xFC, 0x8B, 0x45, 0xFC,
+        0x01, 0xC0, 0x89, 0x45, 0xF8, 0x8B, 0x45, 0xF8, 0x83, 0xC0, 0x01, 0x89,
+        0x45, 0xF4, 0xC9, 0xC3
+    };
+
+    BinaryImage img(QByteArray{});
+    BinarySection *text = img.createSection(".text", Address(0x1000), Address(0x1000 + sizeof(code)));
+    text->setHostAddr(HostAddress(code));
+    text->setCode(true);
+    img.addRelocations({ Address(0x1009) });
+
+    BinarySymbolTable symbols;
+    BinarySymbol *foo = symbols.createSymbol(Address(0x1000), "foo");
+    foo->setAttribute("Function", true);
+    foo->setSize(sizeof(code));
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath("test.pat");
+    QCOMPARE(FunctionPatternDB::writePatternFile(&img, &symbols, fileName), 1);
+
+    FunctionPatternDB db;
+    QVERIFY(db.readPatternFile(fileName));
+
+    symbols.clear();
+    QCOMPARE(db.identifyFunctions(&img, &symbols, { Address(0x1000) }), 1);
+    QCOMPARE(symbols.findSymbolByAddress(Address(0x1000))->getSize(), static_cast<int>(sizeof(code)));
+
+    // The first 32 bytes still match, but the rest of the function is different
+    code[36] = 0x90;
+    symbols.clear();
+    QCOMPARE(db.identifyFunctions(&img, &symbols, { Address(0x1000) }), 0);
+    code[36] = 0x89;
+
+    // The function does not fit into the section
+    FunctionPatternDB tooLong;
+    QVERIFY(tooLong.addPattern("5589E583EC10C70424........8B4508", 0x100, 0, 0, "foo"));
+    QCOMPARE(tooLong.identifyFunctions(&img, &symbols, { Address(0x1000) }), 0);
+}
+
+
+void FunctionPatternDBTest::testWritePatternFile()
+{
+    Byte code[] = {
+        0x55, 0x89, 0xE5, 0x83, 0xEC, 0x08, 0xC7, 0x04, 0x24, 0x00, 0x10, 0x40, 0x00, 0xC9, 0xC3,
+        0x90, 0x55, 0x89, 0xC3
+    };
+
+    BinaryImage img(QByteArray{});
+    BinarySection *text = img.createSection(".text", Address(0x1000), Address(0x1000 + sizeof(code)));
+    text->setHostAddr(HostAddress(code));
+    text->setCode(true);
+    img.addRelocations({ Address(0x1009) });
+
+    BinarySymbolTable symbols;
+    BinarySymbol *foo = symbols.createSymbol(Address(0x1000), "foo");
+    foo->setAttribute("Function", true);
+    foo->setSize(15);
+
+    BinarySymbol *bar = symbols.createSymbol(Address(0x1010), "bar"); // unknown size
+    bar->setAttribute("Function", true);
+
+    symbols.createSymbol(Address(0x100F), "data");
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath("test.pat");
+
+    QCOMPARE(FunctionPatternDB::writePatternFile(&img, &symbols, fileName), 1);
+
+    FunctionPatternDB db;
+    QVERIFY(db.readPatternFile(fileName));
+    QCOMPARE(db.getNumPatterns(), 1);
+
+    // the relocated address is a wildcard
+    code[9] = 0x40;
+    symbols.clear();
+    QCOMPARE(db.identifyFunctions(&img, &symbols, { Address(0x1000) }), 1);
+    QCOMPARE(symbols.findSymbolByAddress(Address(0x1000))->getName(), QString("foo"));
+}
+
+
+QTEST_GUILESS_MAIN(FunctionPatternDBTest)
@@ -177,6 +177,38 @@ void ProcCFGTest::testEnsureBBExists()
     QCOMPARE(cfg->getNumBBs(), 2);
     QCOMPARE(currBB->getLowAddr(), Address(0x1002));
     QCOMPARE(currBB->getHiAddr(),  Address(0x1003));
+
+    // the split moves the RTLs to the high part
+    QCOMPARE(completeBB->getRTLs()->size(), static_cast<size_t>(2));
+    QCOMPARE(currBB->getRTLs()->size(), static_cast<size_t>(2));
+    QVERIFY(currBB->getRTLs()->front()->front()->getBB() == currBB);
+
+    // after an incomplete BB
+    cfg->addEdge(currBB, Address(0x2000));
+    QCOMPARE(cfg->ensureBBExists(Address(0x2010), dummy), false);
+    QCOMPARE(cfg->getNumBBs(), 4);
+    QVERIFY(cfg->isStartOfIncompleteBB(Address(0x2010)));
+}
+
+
+void ProcCFGTest::testGetBBContaining()
+{
+    UserProc proc(Address(0x1000), "test", nullptr);
+    ProcCFG *cfg = proc.getCFG();
+
+    QVERIFY(cfg->getBBContaining(Address(0x1000)) == nullptr);
+
+    BasicBlock *bb1 = cfg->createBB(BBType::Oneway, createRTLs(Address(0x1000), 4));
+    BasicBlock *bb2 = cfg->createBB(BBType::Oneway, createRTLs(Address(0x1008), 4));
+    BasicBlock *incompleteBB = cfg->createIncompleteBB(Address(0x1010));
+
+    QVERIFY(cfg->getBBContaining(Address(0x0FFF)) == nullptr);
+    QVERIFY(cfg->getBBContaining(Address(0x1000)) == bb1);
+    QVERIFY(cfg->getBBContaining(Address(0x1003)) == bb1);
+    QVERIFY(cfg->getBBContaining(Address(0x1004)) == nullptr);
+    QVERIFY(cfg->getBBContaining(Address(0x100B)) == bb2);
+    QVERIFY(cfg->getBBContaining(Address(0x1010)) == incompleteBB);
+    QVERIFY(cfg->getBBContaining(Address(0x1011)) == nullptr);
 }
 
 
@@ -27,6 +27,7 @@ private slots:
     void testCreateBBBlockingIncomplete(); /// tests createBB if another incomplete BB is blocking the newly created BB.
     void testCreateIncompleteBB(); /// tests creating an incomplete BB
     void testEnsureBBExists();
+    void testGetBBContaining();
     void testSetEntryAndExitBB();
     void testRemoveBB();
     void testAddEdge();
@@ -0,0 +1,127 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "FunctionStartFinderTest.h"
+
+
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySection.h"
+#include "boomerang/frontend/FunctionStartFinder.h"
+
+#include <cstring>
+
+
+static Byte code[] = {
+    0x55, 0x89, 0xE5,                   // 0x1000: push ebp; mov ebp, esp
+    0xE8, 0x18, 0x00, 0x00, 0x00,       // 0x1003: call 0x1020
+    0xC9, 0xC3,                         // 0x1008: leave; ret
+    0x90, 0x90, 0x90, 0x90, 0x90, 0x90,
+    0x55, 0x89, 0xE5, 0xC9, 0xC3,       // 0x1010: only a prologue
+    0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90,
+    0x31, 0xC0, 0xC3,                   // 0x1020: only called
+    0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90,
+    0x55, 0x8B, 0xEC, 0xC9, 0xC3        // 0x1030: MSVC prologue
+};
+
+
+void FunctionStartFinderTest::testFindCandidates()
+{
+    BinaryImage img(QByteArray{});
+    BinarySection *text = img.createSection(".text", Address(0x1000), Address(0x1000 + sizeof(code)));
+    text->setHostAddr(HostAddress(code));
+    text->setCode(true);
+
+    QVERIFY(!FunctionStartFinder(&img, Machine::SPARC).isSupported());
+
+    FunctionStartFinder finder(&img, Machine::PENTIUM);
+    QVERIFY(finder.isSupported());
+
+    std::vector<FunctionStartFinder::Candidate> candidates = finder.findCandidates(0);
+    QCOMPARE(candidates.size(), size_t(4));
+
+    QCOMPARE(candidates[0].addr, Address(0x1000));
+    QCOMPARE(candidates[0].score, FunctionStartFinder::SCORE_PROLOGUE + FunctionStartFinder::SCORE_ALIGNED);
+    QCOMPARE(candidates[1].addr, Address(0x1010));
+    QCOMPARE(candidates[1].score, FunctionStartFinder::SCORE_PROLOGUE + FunctionStartFinder::SCORE_ALIGNED +
+             FunctionStartFinder::SCORE_AFTER_PADDING);
+    QCOMPARE(candidates[2].addr, Address(0x1020));
+    QCOMPARE(candidates[2].numCalls, 1);
+    QCOMPARE(candidates[2].score, FunctionStartFinder::SCORE_CALL_TARGET + FunctionStartFinder::SCORE_ALIGNED +
+             FunctionStartFinder::SCORE_AFTER_PADDING);
+    QCOMPARE(candidates[3].addr, Address(0x1030));
+
+    candidates = finder.findCandidates(candidates[1].score);
+    QCOMPARE(candidates.size(), size_t(2));
+    QCOMPARE(candidates[0].addr, Address(0x1010));
+    QCOMPARE(candidates[1].addr, Address(0x1030));
+}
+
+
+void FunctionStartFinderTest::testKnownCode()
+{
+    BinaryImage img(QByteArray{});
+    BinarySection *text = img.createSection(".text", Address(0x1000), Address(0x1000 + sizeof(code)));
+    text->setHostAddr(HostAddress(code));
+    text->setCode(true);
+
+    FunctionStartFinder finder(&img, Machine::PENTIUM);
+    finder.addKnownCode(Address(0x1008), Address(0x1011));
+    finder.addKnownCode(Address(0x1030), Address(0x1035));
+
+    std::vector<FunctionStartFinder::Candidate> candidates = finder.findCandidates(0);
+    QCOMPARE(candidates.size(), size_t(2));
+    QCOMPARE(candidates[0].addr, Address(0x1000));
+    QCOMPARE(candidates[1].addr, Address(0x1020));
+
+    // The call to 0x1020 is inside known code now
+    finder.addKnownCode(Address(0x1000), Address(0x100A));
+    candidates = finder.findCandidates(0);
+    QCOMPARE(candidates.size(), size_t(0));
+}
+
+
+void FunctionStartFinderTest::testParallelSweep()
+{
+    // Large enough to be split into several chunks, with prologues and calls
+    // crossing chunk boundaries
+    std::vector<Byte> data(4 * FunctionStartFinder::MIN_CHUNK_SIZE, 0xCC);
+
+    for (std::size_t pos = 0x40; pos + 8 < data.size(); pos += 0x1001) {
+        data[pos + 0] = 0x55;
+        data[pos + 1] = 0x89;
+        data[pos + 2] = 0xE5;
+        data[pos + 3] = 0xE8;
+
+        // call the previous function
+        const int disp = -0x1001 - 8;
+        std::memcpy(&data[pos + 4], &disp, 4);
+    }
+
+    BinaryImage img(QByteArray{});
+    BinarySection *text = img.createSection(".text", Address(0x100000),
+                                            Address(0x100000 + data.size()));
+    text->setHostAddr(HostAddress(data.data()));
+    text->setCode(true);
+
+    FunctionStartFinder finder(&img, Machine::PENTIUM);
+    const std::vector<FunctionStartFinder::Candidate> expected = finder.findCandidates(0, 1);
+    const std::vector<FunctionStartFinder::Candidate> actual   = finder.findCandidates(0, 4);
+
+    QVERIFY(expected.size() > 64);
+    QCOMPARE(actual.size(), expected.size());
+
+    for (std::size_t i = 0; i < expected.size(); i++) {
+        QCOMPARE(actual[i].addr, expected[i].addr);
+        QCOMPARE(actual[i].score, expected[i].score);
+        QCOMPARE(actual[i].numCalls, expected[i].numCalls);
+    }
+}
+
+
+QTEST_GUILESS_MAIN(FunctionStartFinderTest)
@@ -11,9 +11,16 @@
 
 
 #include "boomerang/db/Prog.h"
+#include "boomerang/db/binary/BinaryFile.h"
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySection.h"
+#include "boomerang/frontend/pentium/PentiumDecoder.h"
 #include "boomerang/frontend/pentium/PentiumFrontEnd.h"
 #include "boomerang/ifc/IDecoder.h"
 #include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/statements/Statement.h"
+#include "boomerang/ssl/type/Type.h"
 #include "boomerang/util/Types.h"
 #include "boomerang/util/log/Log.h"
 
@@ -216,4 +223,108 @@ void FrontPentTest::testFindMain()
 }
 
 
+void FrontPentTest::testOpcodeTable()
+{
+    // The opcode table must decode instructions exactly like the generated matcher
+    const QString samples[] = { HELLO_PENT, BRANCH_PENT, FEDORA2_TRUE, FEDORA3_TRUE, SUSE_TRUE };
+
+    for (const QString &sample : samples) {
+        QVERIFY(m_project.loadBinaryFile(sample));
+
+        Prog *prog = m_project.getProg();
+        PentiumDecoder *decoder = dynamic_cast<PentiumDecoder *>(prog->getFrontEnd()->getDecoder());
+        QVERIFY(decoder != nullptr);
+
+        const BinaryImage *image  = m_project.getLoadedBinaryFile()->getImage();
+        const BinarySection *text = image->getSectionByName(".text");
+        QVERIFY(text != nullptr);
+
+        const ptrdiff_t delta = (text->getHostAddr() - text->getSourceAddr()).value();
+        const Address end     = text->getSourceAddr() + text->getSize();
+
+        for (Address pc = text->getSourceAddr(); pc < end;) {
+            DecodeResult expected, actual;
+            const bool expectedOk = decoder->decodeInstructionWithMatcher(pc, delta, expected);
+            const bool actualOk   = decoder->decodeInstruction(pc, delta, actual);
+
+            QCOMPARE(actualOk, expectedOk);
+            QCOMPARE(actual.numBytes, expected.numBytes);
+
+            if (expectedOk) {
+                QString expectedRTL, actualRTL;
+                OStream expectedStrm(&expectedRTL), actualStrm(&actualRTL);
+                expected.rtl->print(expectedStrm);
+                actual.rtl->print(actualStrm);
+                QCOMPARE(actualRTL, expectedRTL);
+            }
+
+            pc += (expectedOk && expected.numBytes > 0) ? expected.numBytes : 1;
+        }
+    }
+}
+
+
+void FrontPentTest::testRelocatedOperands()
+{
+    QVERIFY(m_project.loadBinaryFile(HELLO_PENT));
+
+    Prog *prog = m_project.getProg();
+    PentiumDecoder *decoder = dynamic_cast<PentiumDecoder *>(prog->getFrontEnd()->getDecoder());
+    QVERIFY(decoder != nullptr);
+
+    static const Byte code[] = {
+        0xB8, 0x00, 0x10, 0x00, 0x09,   // 0x09000000: mov eax, 0x09001000 (relocated)
+        0xB9, 0x00, 0x20, 0x00, 0x09,   // 0x09000005: mov ecx, 0x09002000 (not relocated)
+        0x68, 0x00, 0x20, 0x00, 0x09    // 0x0900000A: push 0x09002000 (relocated)
+    };
+
+    BinaryImage *image = m_project.getLoadedBinaryFile()->getImage();
+    BinarySection *sect = image->createSection(".reloctest", Address(0x09000000),
+                                               Address(0x09000000 + sizeof(code)));
+    QVERIFY(sect != nullptr);
+    sect->setHostAddr(HostAddress(code));
+    sect->setCode(true);
+    image->addRelocations({ Address(0x09000001), Address(0x0900000B) });
+
+    const ptrdiff_t delta = (sect->getHostAddr() - sect->getSourceAddr()).value();
+
+    // \returns the type of the first operand with value \p value
+    auto getOperandType = [](const DecodeResult &inst, DWord value) -> SharedType {
+        std::list<SharedExp> operands;
+        for (Statement *stmt : *inst.rtl) {
+            stmt->searchAll(Const(value), operands);
+        }
+
+        return operands.empty() ? nullptr : operands.front()->access<Const>()->getType();
+    };
+
+    for (bool useMatcher : { false, true }) {
+        DecodeResult inst;
+        Address pc = Address(0x09000000);
+
+        QVERIFY(useMatcher ? decoder->decodeInstructionWithMatcher(pc, delta, inst)
+                           : decoder->decodeInstruction(pc, delta, inst));
+        QCOMPARE(inst.numBytes, 5);
+        SharedType ty = getOperandType(inst, 0x09001000);
+        QVERIFY(ty != nullptr && ty->isPointer());
+
+        // The next instruction has a relocation with the same value as the immediate,
+        // but the immediate itself is not relocated.
+        pc += inst.numBytes;
+        QVERIFY(useMatcher ? decoder->decodeInstructionWithMatcher(pc, delta, inst)
+                           : decoder->decodeInstruction(pc, delta, inst));
+        QCOMPARE(inst.numBytes, 5);
+        ty = getOperandType(inst, 0x09002000);
+        QVERIFY(ty != nullptr && !ty->isPointer());
+
+        pc += inst.numBytes;
+        QVERIFY(useMatcher ? decoder->decodeInstructionWithMatcher(pc, delta, inst)
+                           : decoder->decodeInstruction(pc, delta, inst));
+        QCOMPARE(inst.numBytes, 5);
+        ty = getOperandType(inst, 0x09002000);
+        QVERIFY(ty != nullptr && ty->isPointer());
+    }
+}
+
+
 QTEST_GUILESS_MAIN(FrontPentTest)
@@ -23,5 +23,9 @@ private slots:
     void test3();
     void testFindMain();
     void testBranch();
+    void testOpcodeTable();
+
+    /// Test that only operands relocated within the decoded instruction are marked as addresses
+    void testRelocatedOperands();
 
 };
@@ -0,0 +1,128 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "TargetQueueTest.h"
+
+
+#include "boomerang/db/BasicBlock.h"
+#include "boomerang/db/proc/ProcCFG.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/frontend/TargetQueue.h"
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/exp/Terminal.h"
+#include "boomerang/ssl/statements/Assign.h"
+#include "boomerang/ssl/type/VoidType.h"
+
+
+static std::unique_ptr<RTLList> createRTLs(Address baseAddr, int numRTLs)
+{
+    std::unique_ptr<RTLList> rtls(new RTLList);
+
+    for (int i = 0; i < numRTLs; i++) {
+        rtls->push_back(std::unique_ptr<RTL>(new RTL(baseAddr + i,
+            { new Assign(VoidType::get(), Terminal::get(opNil), Terminal::get(opNil)) })));
+    }
+
+    return rtls;
+}
+
+
+void TargetQueueTest::testDuplicates()
+{
+    UserProc proc(Address(0x1000), "test", nullptr);
+    ProcCFG *cfg = proc.getCFG();
+
+    TargetQueue queue(false);
+    queue.initial(Address(0x1000));
+    BasicBlock *bb = cfg->createBB(BBType::Oneway, createRTLs(Address(0x1000), 2));
+
+    queue.visit(cfg, Address(0x2000), bb);
+    queue.visit(cfg, Address(0x2000), bb);
+    queue.visit(cfg, Address(0x1000), bb);
+
+    QCOMPARE(queue.getStats().numQueued, 2);
+    QCOMPARE(queue.getStats().numDuplicates, 2);
+
+    // 0x1000 has been decoded already
+    QCOMPARE(queue.getNextAddress(*cfg), Address(0x2000));
+    QCOMPARE(queue.getNextAddress(*cfg), Address::INVALID);
+}
+
+
+void TargetQueueTest::testEdgeBeforeVisit()
+{
+    UserProc proc(Address(0x1000), "test", nullptr);
+    ProcCFG *cfg = proc.getCFG();
+
+    TargetQueue queue(false);
+    queue.initial(Address(0x1000));
+    QCOMPARE(queue.getNextAddress(*cfg), Address(0x1000));
+
+    BasicBlock *bb = cfg->createBB(BBType::Oneway, createRTLs(Address(0x1000), 2));
+
+    // Adding the edge first creates an incomplete BB at the destination
+    cfg->addEdge(bb, Address(0x2000));
+    QVERIFY(cfg->isStartOfIncompleteBB(Address(0x2000)));
+
+    queue.visit(cfg, Address(0x2000), bb);
+    QCOMPARE(queue.getNextAddress(*cfg), Address(0x2000));
+    QCOMPARE(queue.getNextAddress(*cfg), Address::INVALID);
+}
+
+
+void TargetQueueTest::testSplit()
+{
+    UserProc proc(Address(0x1000), "test", nullptr);
+    ProcCFG *cfg = proc.getCFG();
+
+    TargetQueue queue(false);
+    BasicBlock *bb = cfg->createBB(BBType::Oneway, createRTLs(Address(0x1000), 4));
+
+    queue.visit(cfg, Address(0x1002), bb);
+    QCOMPARE(queue.getStats().numSplits, 1);
+    QCOMPARE(queue.getStats().numQueued, 0);
+    QCOMPARE(bb->getLowAddr(), Address(0x1002));
+    QCOMPARE(cfg->getNumBBs(), 2);
+    QCOMPARE(queue.getNextAddress(*cfg), Address::INVALID);
+}
+
+
+void TargetQueueTest::testAddressOrder()
+{
+    UserProc proc(Address(0x1000), "test", nullptr);
+    ProcCFG *cfg   = proc.getCFG();
+    BasicBlock *bb = nullptr;
+
+    TargetQueue fifo(false, TargetOrder::FallThroughFirst);
+    TargetQueue sorted(false, TargetOrder::AddressOrder);
+
+    fifo.initial(Address(0x1000));
+    sorted.initial(Address(0x1000));
+
+    for (Address addr : { Address(0x3000), Address(0x2000), Address(0x4000) }) {
+        fifo.visit(cfg, addr, bb);
+        sorted.visit(cfg, addr, bb);
+    }
+
+    // Both queues see the incomplete BBs created by the other one
+    QCOMPARE(fifo.getNextAddress(*cfg), Address(0x1000));
+    QCOMPARE(fifo.getNextAddress(*cfg), Address(0x3000));
+    QCOMPARE(fifo.getNextAddress(*cfg), Address(0x2000));
+    QCOMPARE(fifo.getNextAddress(*cfg), Address(0x4000));
+    QCOMPARE(fifo.getNextAddress(*cfg), Address::INVALID);
+
+    QCOMPARE(sorted.getNextAddress(*cfg), Address(0x1000));
+    QCOMPARE(sorted.getNextAddress(*cfg), Address(0x2000));
+    QCOMPARE(sorted.getNextAddress(*cfg), Address(0x3000));
+    QCOMPARE(sorted.getNextAddress(*cfg), Address(0x4000));
+    QCOMPARE(sorted.getNextAddress(*cfg), Address::INVALID);
+}
+
+
+QTEST_GUILESS_MAIN(TargetQueueTest)
@@ -0,0 +1,134 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "RTLInstDictCacheTest.h"
+
+
+#include "boomerang/ssl/RTLInstDict.h"
+#include "boomerang/ssl/RTLInstDictCache.h"
+#include "boomerang/ssl/exp/Const.h"
+
+#include <QDataStream>
+#include <QFile>
+#include <QTemporaryDir>
+
+
+#define PENTIUM_SSL (BOOMERANG_TEST_BASE "share/boomerang/ssl/pentium.ssl")
+
+
+static QByteArray readFile(const QString &fileName)
+{
+    QFile file(fileName);
+    return file.open(QFile::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+
+void RTLInstDictCacheTest::testSaveLoad()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QByteArray sslHash = RTLInstDictCache::hashSSLFile(PENTIUM_SSL);
+    QVERIFY(!sslHash.isEmpty());
+
+    // make sure the SSL file is actually parsed and the cache is re-created
+    QFile::remove(RTLInstDictCache::getCacheFileName(PENTIUM_SSL));
+
+    RTLInstDict parsed(false);
+    QVERIFY(parsed.readSSLFile(PENTIUM_SSL));
+    QVERIFY(QFile::exists(RTLInstDictCache::getCacheFileName(PENTIUM_SSL)));
+
+    const QString cache1 = tempDir.filePath("pentium1.ssl.cache");
+    const QString cache2 = tempDir.filePath("pentium2.ssl.cache");
+    QVERIFY(RTLInstDictCache::save(parsed, cache1, sslHash));
+
+    RTLInstDict loaded(false);
+    QVERIFY(RTLInstDictCache::load(loaded, cache1, sslHash));
+
+    // Saving the loaded dictionary again must produce exactly the same cache file
+    QVERIFY(RTLInstDictCache::save(loaded, cache2, sslHash));
+    QCOMPARE(readFile(cache2), readFile(cache1));
+
+    // instantiated instructions must be the same as well
+    const QString opcode = loaded.getSignature("PUSH.IXOB").first;
+    std::unique_ptr<RTL> parsedRTL = parsed.instantiateRTL(opcode, Address(0x1000),
+                                                           { Const::get(5) });
+    std::unique_ptr<RTL> loadedRTL = loaded.instantiateRTL(opcode, Address(0x1000),
+                                                           { Const::get(5) });
+
+    QVERIFY(parsedRTL != nullptr);
+    QVERIFY(loadedRTL != nullptr);
+    QCOMPARE(loadedRTL->prints(), parsedRTL->prints());
+
+    // and so must the instruction IDs
+    const int pushID = loaded.getInstructionID("PUSH.IXOB");
+    QVERIFY(pushID != -1);
+    QCOMPARE(parsed.getInstructionID("PUSH.IXOB"), pushID);
+    QCOMPARE(loaded.getNumInstructions(), parsed.getNumInstructions());
+    QCOMPARE(loaded.getNumParams(pushID), static_cast<std::size_t>(1));
+    QCOMPARE(loaded.getInstructionID("NOSUCHINSTRUCTION"), -1);
+
+    std::unique_ptr<RTL> idRTL = loaded.instantiateRTL(pushID, Address(0x1000), { Const::get(5) });
+    QVERIFY(idRTL != nullptr);
+    QCOMPARE(idRTL->prints(), parsedRTL->prints());
+}
+
+
+void RTLInstDictCacheTest::testLoadInvalid()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QByteArray sslHash = RTLInstDictCache::hashSSLFile(PENTIUM_SSL);
+    const QString cacheFileName = tempDir.filePath("pentium.ssl.cache");
+
+    RTLInstDict dict(false);
+    QVERIFY(!RTLInstDictCache::load(dict, cacheFileName, sslHash));
+
+    QVERIFY(dict.readSSLFile(PENTIUM_SSL));
+    QVERIFY(RTLInstDictCache::save(dict, cacheFileName, sslHash));
+
+    // SSL file was changed
+    QVERIFY(!RTLInstDictCache::load(dict, cacheFileName, QByteArray("outdated")));
+
+    // cache file was written by a different build
+    const QByteArray data = readFile(cacheFileName);
+    {
+        QDataStream is(data);
+        is.setVersion(QDataStream::Qt_5_0);
+
+        quint32 magic, version;
+        QString build;
+        is >> magic >> version >> build;
+        QCOMPARE(build, QString(BOOMERANG_VERSION));
+
+        QByteArray otherBuildData;
+        QDataStream os(&otherBuildData, QIODevice::WriteOnly);
+        os.setVersion(QDataStream::Qt_5_0);
+        os << magic << version << QString("other build");
+        otherBuildData.append(data.mid(is.device()->pos()));
+
+        QFile cacheFile(cacheFileName);
+        QVERIFY(cacheFile.open(QFile::WriteOnly | QFile::Truncate));
+        cacheFile.write(otherBuildData);
+    }
+
+    QVERIFY(!RTLInstDictCache::load(dict, cacheFileName, sslHash));
+
+    // truncated cache file
+    QFile cacheFile(cacheFileName);
+    QVERIFY(cacheFile.open(QFile::WriteOnly | QFile::Truncate));
+    cacheFile.write(data.left(data.size() / 2));
+    cacheFile.close();
+
+    QVERIFY(!RTLInstDictCache::load(dict, cacheFileName, sslHash));
+}
+
+
+QTEST_GUILESS_MAIN(RTLInstDictCacheTest)
@@ -0,0 +1,29 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+/**
+ * Tests the binary cache of parsed SSL files
+ */
+class RTLInstDictCacheTest : public BoomerangTest
+{
+    Q_OBJECT
+
+private slots:
+    /// Test that a dictionary is the same after a save/load round trip
+    void testSaveLoad();
+
+    /// Test that outdated or corrupt cache files are rejected
+    void testLoadInvalid();
+};
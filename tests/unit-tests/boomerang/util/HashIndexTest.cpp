@@ -0,0 +1,96 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "HashIndexTest.h"
+
+
+#include "boomerang/util/HashIndex.h"
+
+#include <vector>
+
+
+void HashIndexTest::testEmpty()
+{
+    HashIndex idx;
+    QVERIFY(idx.empty());
+
+    idx.insert(42, 0);
+    QVERIFY(!idx.empty());
+}
+
+
+void HashIndexTest::testClear()
+{
+    HashIndex idx;
+    idx.clear();
+    QVERIFY(idx.empty());
+
+    idx.insert(42, 0);
+    idx.clear();
+    QVERIFY(idx.empty());
+    QCOMPARE(idx.find(42, [](int) { return true; }), HashIndex::NOT_FOUND);
+}
+
+
+void HashIndexTest::testInsert()
+{
+    HashIndex idx;
+
+    for (int i = 0; i < 1000; i++) {
+        idx.insert(i % 7, i); // many collisions
+    }
+
+    QCOMPARE(idx.size(), static_cast<std::size_t>(1000));
+}
+
+
+void HashIndexTest::testFind()
+{
+    const std::vector<int> keys = { 5, 21, 37, 53, 4, 100 };
+
+    HashIndex idx;
+    QCOMPARE(idx.find(5, [](int) { return true; }), HashIndex::NOT_FOUND);
+
+    for (std::size_t i = 0; i < keys.size(); i++) {
+        idx.insert(keys[i] % 16, i); // hash 5 collides with 21, 37, 53
+    }
+
+    for (std::size_t i = 0; i < keys.size(); i++) {
+        const int key = keys[i];
+        QCOMPARE(idx.find(key % 16, [&keys, key](int j) { return keys[j] == key; }),
+                 static_cast<int>(i));
+    }
+
+    QCOMPARE(idx.find(69 % 16, [&keys](int j) { return keys[j] == 69; }), HashIndex::NOT_FOUND);
+}
+
+
+void HashIndexTest::testRemove()
+{
+    const std::vector<int> keys = { 5, 21, 37, 53, 6, 100 };
+
+    HashIndex idx;
+
+    for (std::size_t i = 0; i < keys.size(); i++) {
+        idx.insert(keys[i] % 16, i);
+    }
+
+    QVERIFY(!idx.remove(69 % 16, [&keys](int j) { return keys[j] == 69; }));
+    QVERIFY(idx.remove(21 % 16, [&keys](int j) { return keys[j] == 21; }));
+    QCOMPARE(idx.size(), keys.size() - 1);
+
+    // all elements after the removed one in the probe sequence must still be found
+    QCOMPARE(idx.find(21 % 16, [&keys](int j) { return keys[j] == 21; }), HashIndex::NOT_FOUND);
+    QCOMPARE(idx.find(37 % 16, [&keys](int j) { return keys[j] == 37; }), 2);
+    QCOMPARE(idx.find(53 % 16, [&keys](int j) { return keys[j] == 53; }), 3);
+    QCOMPARE(idx.find(6 % 16, [&keys](int j) { return keys[j] == 6; }), 4);
+}
+
+
+QTEST_GUILESS_MAIN(HashIndexTest)
@@ -0,0 +1,79 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "OStreamTest.h"
+
+
+#include "boomerang/util/OStream.h"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QTemporaryDir>
+#include <QTextStreamManipulator>
+
+
+static void writeSample(OStream &os)
+{
+    os << "int main() {\n" << QString("    return %1;\n").arg(42) << '}' << '\n';
+    os << 12 << ' ' << 34u << ' ' << static_cast<uint64>(0xFFFFFFFFFFULL) << ' ' << 1.5 << '\n';
+    os << qSetFieldWidth(4) << 7 << qSetFieldWidth(0) << "|\n";
+    os << QString::fromUtf8("\xC3\xA4\xE2\x82\xAC") << "\xE4" << '\n';
+}
+
+
+void OStreamTest::testWriteFile()
+{
+    QString expected;
+    {
+        OStream os(&expected);
+        writeSample(os);
+    }
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    QFile file(dir.filePath("test.c"));
+    QVERIFY(file.open(QFile::WriteOnly));
+    {
+        OStream os(&file);
+        writeSample(os);
+    }
+    file.close();
+
+    QVERIFY(file.open(QFile::ReadOnly));
+    QCOMPARE(QString::fromUtf8(file.readAll()), expected);
+}
+
+
+void OStreamTest::testWriteLarge()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QString line = QString(99, 'x');
+    const int numLines = 50000;
+
+    QSaveFile file(dir.filePath("large.c"));
+    QVERIFY(file.open(QFile::WriteOnly));
+
+    OStream os(&file);
+    for (int i = 0; i < numLines; i++) {
+        os << line << '\n';
+    }
+
+    os.flush();
+    QVERIFY(file.commit());
+
+    QFile result(dir.filePath("large.c"));
+    QVERIFY(result.open(QFile::ReadOnly));
+    QCOMPARE(result.size(), static_cast<qint64>(numLines * (line.length() + 1)));
+}
+
+
+QTEST_GUILESS_MAIN(OStreamTest)
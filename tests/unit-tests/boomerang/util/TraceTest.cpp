@@ -0,0 +1,133 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "TraceTest.h"
+
+
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/util/log/Trace.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+
+static QJsonArray readTraceEvents(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly)) {
+        return QJsonArray();
+    }
+
+    return QJsonDocument::fromJson(file.readAll()).object()["traceEvents"].toArray();
+}
+
+
+void TraceTest::testRecord()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString traceFile = dir.filePath("trace.json");
+
+    Trace::clear();
+    Trace::disable();
+
+    {
+        TRACE_SPAN("disabled");
+    }
+
+    Trace::enable();
+
+    {
+        TRACE_SPAN("outer");
+        {
+            TRACE_SPAN(QString("inner"));
+        }
+    }
+
+    Trace::disable();
+
+    QVERIFY(Trace::writeChromeTrace(traceFile));
+    const QJsonArray events = readTraceEvents(traceFile);
+
+    // inner span finishes first
+    QCOMPARE(events.size(), 2);
+    QCOMPARE(events[0].toObject()["name"].toString(), QString("inner"));
+    QCOMPARE(events[1].toObject()["name"].toString(), QString("outer"));
+
+    const double innerStart = events[0].toObject()["ts"].toDouble();
+    const double outerStart = events[1].toObject()["ts"].toDouble();
+    QVERIFY(outerStart <= innerStart);
+    QVERIFY(events[1].toObject()["dur"].toDouble() >= events[0].toObject()["dur"].toDouble());
+}
+
+
+void TraceTest::testWriteChromeTrace()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString traceFile = dir.filePath("trace.json");
+
+    UserProc proc(Address(0x1000), "test", nullptr);
+
+    Trace::clear();
+    Trace::enable();
+
+    {
+        TRACE_SPAN("Decompile", &proc);
+    }
+
+    Trace::disable();
+
+    QVERIFY(Trace::writeChromeTrace(traceFile));
+    const QJsonArray events = readTraceEvents(traceFile);
+
+    QCOMPARE(events.size(), 1);
+
+    const QJsonObject event = events[0].toObject();
+    QCOMPARE(event["name"].toString(), QString("Decompile"));
+    QCOMPARE(event["ph"].toString(), QString("X"));
+    QVERIFY(event.contains("ts"));
+    QVERIFY(event.contains("dur"));
+    QVERIFY(event.contains("tid"));
+    QCOMPARE(event["args"].toObject()["proc"].toString(), QString("test"));
+    QCOMPARE(event["args"].toObject()["address"].toString(), Address(0x1000).toString());
+}
+
+
+void TraceTest::testDeletedFunction()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString traceFile = dir.filePath("trace.json");
+
+    Trace::clear();
+    Trace::enable();
+
+    {
+        std::unique_ptr<UserProc> proc(new UserProc(Address(0x1000), "test", nullptr));
+        TRACE_SPAN("Remove", proc.get());
+        proc.reset();
+    }
+
+    Trace::disable();
+
+    QVERIFY(Trace::writeChromeTrace(traceFile));
+    const QJsonArray events = readTraceEvents(traceFile);
+
+    QCOMPARE(events.size(), 1);
+    QCOMPARE(events[0].toObject()["args"].toObject()["proc"].toString(), QString("test"));
+    QCOMPARE(events[0].toObject()["args"].toObject()["address"].toString(),
+             Address(0x1000).toString());
+}
+
+
+QTEST_GUILESS_MAIN(TraceTest)
@@ -0,0 +1,29 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+class TraceTest : public BoomerangTest
+{
+    Q_OBJECT
+
+private slots:
+    /// Test that spans are only recorded when tracing is enabled
+    void testRecord();
+
+    /// Test writing spans in the Chrome trace event format
+    void testWriteChromeTrace();
+
+    /// Test that spans keep the name of their function after it was deleted
+    void testDeletedFunction();
+};
@@ -92,6 +92,28 @@ void UtilTest::testRead()
 }
 
 
+void UtilTest::testReadDWords()
+{
+    Byte buffer[4 * 37];
+    for (std::size_t i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = static_cast<Byte>(i);
+    }
+
+    // odd number of values, so the remainder of a vectorized loop is handled too
+    DWord values[37];
+
+    Util::readDWords(buffer, values, 37, Endian::Little);
+    for (int i = 0; i < 37; i++) {
+        QCOMPARE(values[i], Util::readDWord(buffer + 4 * i, Endian::Little));
+    }
+
+    Util::readDWords(buffer, values, 37, Endian::Big);
+    for (int i = 0; i < 37; i++) {
+        QCOMPARE(values[i], Util::readDWord(buffer + 4 * i, Endian::Big));
+    }
+}
+
+
 void UtilTest::testWrite()
 {
     const Byte expectedBuffer[8] = { 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88 };
@@ -25,6 +25,7 @@ private slots:
     void testSwapEndian();
     void testNormEndian();
     void testRead();
+    void testReadDWords();
     void testWrite();
     void testSignExtend();
 };